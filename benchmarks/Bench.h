@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Minimal helpers shared by the benchmarks: a timer, a sink the optimizer can't see through, and a report line.
+ * Each benchmark is a standalone executable, built with optimizations (see CMakeLists.txt).
+ */
+namespace bench {
+    using clock = std::chrono::steady_clock;
+
+    // forces the compiler to materialize `value`, without any runtime cost.
+    template<typename T>
+    inline void do_not_optimize(T const &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // runs `fn` once and returns the elapsed time in nanoseconds.
+    template<typename F>
+    double measure(F &&fn) {
+        auto start = clock::now();
+        fn();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+    }
+
+    inline void report(const char *name, size_t ops, double ns) {
+        std::printf("%-48s %10.2f ns/op %14.0f ops/s\n", name, ns / static_cast<double>(ops),
+                    static_cast<double>(ops) * 1e9 / ns);
+    }
+
+    // reads the positional argument `i` as a size, or returns `fallback`.
+    inline size_t arg(int argc, char **argv, int i, size_t fallback) {
+        return argc > i ? std::strtoull(argv[i], nullptr, 10) : fallback;
+    }
+
+    // pins the calling thread to one core (wrapped around the core count). Returns false if not supported.
+    inline bool pin_thread(unsigned cpu) {
+#if defined(__linux__)
+        unsigned cores = std::thread::hardware_concurrency();
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cores ? cpu % cores : 0, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void) cpu;
+        return false;
+#endif
+    }
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+#include "Bench.h"
+#include "../includes/BTree.h"
+#include "../includes/FlatMap.h"
+
+// usage: bench_btree [element count]
+//
+// Random int keys: inserts, lookups, short range scans (lower_bound and the 100 following elements), full
+// scans and erases, for std::map and rc::btree_map (and rc::flat_map for the read only operations).
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 1000000);
+    const size_t scan_length = 100;
+    size_t scans = count / 100;
+
+    std::mt19937 gen(42);
+    std::vector<int> keys(count);
+    for (auto &key: keys)
+        key = static_cast<int>(gen());
+    std::vector<int> queries(count);
+    for (size_t i = 0; i < count; ++i)
+        queries[i] = keys[gen() % count];
+    int64_t sum = 0;
+
+    std::map<int, int> std_map;
+    double ns = bench::measure([&] {
+        for (int key: keys)
+            std_map.emplace(key, key);
+    });
+    bench::report("std::map insert", count, ns);
+
+    rc::btree_map<int, int> btree;
+    ns = bench::measure([&] {
+        for (int key: keys)
+            btree.try_emplace(key, key);
+    });
+    bench::report("rc::btree_map insert", count, ns);
+
+    rc::vector<rc::Pair<int, int>> sorted;
+    sorted.reserve(count);
+    for (auto &element: std_map)
+        sorted.push_back({element.first, element.second});
+    rc::btree_map<int, int> loaded;
+    ns = bench::measure([&] {
+        loaded.bulk_load(sorted.begin(), sorted.end());
+    });
+    bench::report("rc::btree_map bulk_load", sorted.size(), ns);
+    rc::flat_map<int, int> flat(sorted.begin(), sorted.end());
+
+    ns = bench::measure([&] {
+        for (int query: queries)
+            sum += std_map.find(query)->second;
+    });
+    bench::report("std::map find", count, ns);
+
+    ns = bench::measure([&] {
+        for (int query: queries)
+            sum += btree.find(query)->second;
+    });
+    bench::report("rc::btree_map find", count, ns);
+
+    ns = bench::measure([&] {
+        for (int query: queries)
+            sum += flat.find(query)->second;
+    });
+    bench::report("rc::flat_map find", count, ns);
+
+    ns = bench::measure([&] {
+        for (size_t s = 0; s < scans; ++s) {
+            auto it = std_map.lower_bound(queries[s]);
+            for (size_t i = 0; i < scan_length && it != std_map.end(); ++i, ++it)
+                sum += it->second;
+        }
+    });
+    bench::report("std::map range scan (100)", scans, ns);
+
+    ns = bench::measure([&] {
+        for (size_t s = 0; s < scans; ++s) {
+            auto it = btree.lower_bound(queries[s]);
+            for (size_t i = 0; i < scan_length && it != btree.end(); ++i, ++it)
+                sum += it->second;
+        }
+    });
+    bench::report("rc::btree_map range scan (100)", scans, ns);
+
+    ns = bench::measure([&] {
+        for (auto &element: std_map)
+            sum += element.second;
+    });
+    bench::report("std::map full scan", std_map.size(), ns);
+
+    ns = bench::measure([&] {
+        for (auto element: btree)
+            sum += element.second;
+    });
+    bench::report("rc::btree_map full scan", btree.size(), ns);
+
+    ns = bench::measure([&] {
+        for (int key: keys)
+            std_map.erase(key);
+    });
+    bench::report("std::map erase", count, ns);
+
+    ns = bench::measure([&] {
+        for (int key: keys)
+            btree.erase(key);
+    });
+    bench::report("rc::btree_map erase", count, ns);
+
+    bench::do_not_optimize(sum);
+    return 0;
+}
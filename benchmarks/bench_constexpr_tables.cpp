@@ -0,0 +1,76 @@
+#include <cstdint>
+#include "Bench.h"
+#include "../includes/Array.hpp"
+#include "../includes/Vector.h"
+
+// usage: bench_constexpr_tables [repetitions]
+//
+// Startup cost of lookup tables: a CRC-32 table and the primes below 20000 (sieved in an rc::vector),
+// either built when the program starts, or evaluated by the compiler and stored in .rodata.
+
+static constexpr size_t prime_count = 2262;
+
+constexpr rc::array<uint32_t, 256> make_crc32_table() {
+    rc::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (crc & 1 ? 0xEDB88320u : 0);
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr rc::array<int, prime_count> make_primes_table() {
+    rc::vector<bool> composite;
+    composite.resize(20000, false);
+    rc::vector<int> primes;
+    for (int i = 2; i < 20000; ++i) {
+        if (composite[i])
+            continue;
+        primes.push_back(i);
+        for (int j = i * i; j < 20000; j += i)
+            composite[j] = true;
+    }
+    rc::array<int, prime_count> table{};
+    for (size_t i = 0; i < prime_count; ++i)
+        table[i] = primes[i];
+    return table;
+}
+
+static constexpr auto crc32_table = make_crc32_table();
+static constexpr auto primes_table = make_primes_table();
+
+int main(int argc, char **argv) {
+    size_t repetitions = bench::arg(argc, argv, 1, 1000);
+    uint64_t sum = 0;
+
+    double ns = bench::measure([&] {
+        for (size_t i = 0; i < repetitions; ++i) {
+            // a call the compiler can't fold: what a table initialized at startup costs.
+            volatile bool runtime = true;
+            if (runtime) {
+                auto crc = make_crc32_table();
+                auto primes = make_primes_table();
+                bench::do_not_optimize(crc);
+                bench::do_not_optimize(primes);
+                sum += crc[255] + primes[prime_count - 1];
+            }
+        }
+    });
+    bench::report("tables built at startup", repetitions, ns);
+
+    ns = bench::measure([&] {
+        for (size_t i = 0; i < repetitions; ++i) {
+            auto const *crc = &crc32_table;
+            auto const *primes = &primes_table;
+            bench::do_not_optimize(crc);
+            bench::do_not_optimize(primes);
+            sum += (*crc)[255] + (*primes)[prime_count - 1];
+        }
+    });
+    bench::report("constexpr tables", repetitions, ns);
+
+    bench::do_not_optimize(sum);
+    return 0;
+}
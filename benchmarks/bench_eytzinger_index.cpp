@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "Bench.h"
+#include "../includes/Algorithm.h"
+#include "../includes/EytzingerIndex.h"
+#include "../includes/Vector.h"
+
+// usage: bench_eytzinger_index [key count] [lookups]
+//
+// Random lower_bound lookups over sorted int keys: std::lower_bound and rc::lower_bound (branchless) over
+// rc::vector iterators, against the Eytzinger and blocked layouts.
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 10000000);
+    size_t lookups = bench::arg(argc, argv, 2, 2000000);
+
+    std::mt19937 gen(42);
+    std::vector<int> raw(count);
+    for (auto &key: raw)
+        key = static_cast<int>(gen() % (count * 4));
+    std::sort(raw.begin(), raw.end());
+    rc::vector<int> keys;
+    keys.reserve(count);
+    for (int key: raw)
+        keys.push_back(key);
+
+    std::vector<int> queries(lookups);
+    for (auto &query: queries)
+        query = static_cast<int>(gen() % (count * 4));
+    size_t sum = 0;
+
+    double ns = bench::measure([&] {
+        for (int query: queries)
+            sum += std::lower_bound(raw.begin(), raw.end(), query) - raw.begin();
+    });
+    bench::report("std::lower_bound", lookups, ns);
+
+    ns = bench::measure([&] {
+        for (int query: queries)
+            sum += rc::lower_bound(keys.begin(), keys.end(), query) - keys.begin();
+    });
+    bench::report("rc::lower_bound (vector_iterator)", lookups, ns);
+
+    rc::eytzinger_index<int> eytzinger(keys);
+    ns = bench::measure([&] {
+        for (int query: queries)
+            sum += eytzinger.lower_bound(query);
+    });
+    bench::report("rc::eytzinger_index", lookups, ns);
+
+    rc::blocked_eytzinger_index<int> blocked(keys);
+    ns = bench::measure([&] {
+        for (int query: queries)
+            sum += blocked.lower_bound(query);
+    });
+    bench::report("rc::blocked_eytzinger_index", lookups, ns);
+
+    bench::do_not_optimize(sum);
+    return 0;
+}
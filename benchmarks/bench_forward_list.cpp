@@ -0,0 +1,50 @@
+#include <malloc.h>
+#include <cstdint>
+#include "Bench.h"
+#include "../includes/ForwardList.h"
+#include "../includes/List.h"
+
+// usage: bench_forward_list [element count]
+//
+// Heap bytes per element (from mallinfo2, allocator overhead included), push_front and traversal,
+// for rc::list and rc::forward_list.
+
+static size_t heap_in_use() {
+    return mallinfo2().uordblks;
+}
+
+template<typename LIST, typename V>
+void run(const char *name, size_t count) {
+    char label[128];
+    size_t before = heap_in_use();
+    auto *list = new LIST();
+    double ns = bench::measure([&] {
+        for (size_t i = 0; i < count; ++i)
+            list->push_front(static_cast<V>(i));
+    });
+    size_t bytes = heap_in_use() - before;
+    std::snprintf(label, sizeof(label), "%s push_front", name);
+    bench::report(label, count, ns);
+    std::printf("%-48s %10.2f bytes/element\n", name, static_cast<double>(bytes) / count);
+
+    V sum = 0;
+    ns = bench::measure([&] {
+        for (auto it = list->begin(); it != list->end(); ++it)
+            sum += *it;
+    });
+    std::snprintf(label, sizeof(label), "%s iterate", name);
+    bench::report(label, count, ns);
+
+    bench::do_not_optimize(sum);
+    delete list;
+}
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 2000000);
+
+    run<rc::list<int32_t>, int32_t>("rc::list<int32_t>", count);
+    run<rc::forward_list<int32_t>, int32_t>("rc::forward_list<int32_t>", count);
+    run<rc::list<int64_t>, int64_t>("rc::list<int64_t>", count);
+    run<rc::forward_list<int64_t>, int64_t>("rc::forward_list<int64_t>", count);
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <unordered_map>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include "Bench.h"
+#include "../includes/HashMap.h"
+
+// usage: bench_hash_map [element count]
+
+template<typename MAP>
+void run(const char *name, const std::vector<uint64_t> &keys, const std::vector<uint64_t> &missing) {
+    char label[128];
+    MAP map;
+    uint64_t sum = 0;
+
+    double ns = bench::measure([&] {
+        for (uint64_t key: keys)
+            map[key] = key;
+    });
+    std::snprintf(label, sizeof(label), "%s insert", name);
+    bench::report(label, keys.size(), ns);
+
+    ns = bench::measure([&] {
+        for (uint64_t key: keys)
+            sum += map.find(key)->second;
+    });
+    std::snprintf(label, sizeof(label), "%s find-hit", name);
+    bench::report(label, keys.size(), ns);
+
+    ns = bench::measure([&] {
+        for (uint64_t key: missing)
+            sum += map.find(key) == map.end();
+    });
+    std::snprintf(label, sizeof(label), "%s find-miss", name);
+    bench::report(label, missing.size(), ns);
+
+    ns = bench::measure([&] {
+        for (uint64_t key: keys)
+            sum += map.erase(key);
+    });
+    std::snprintf(label, sizeof(label), "%s erase", name);
+    bench::report(label, keys.size(), ns);
+
+    bench::do_not_optimize(sum);
+}
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 1000000);
+
+    // even keys are inserted, odd ones are looked up as misses.
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> keys(count);
+    std::vector<uint64_t> missing(count);
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = rng() & ~1ull;
+        missing[i] = rng() | 1ull;
+    }
+
+    run<rc::hash_map<uint64_t, uint64_t>>("rc::hash_map", keys, missing);
+    run<std::unordered_map<uint64_t, uint64_t>>("std::unordered_map", keys, missing);
+    return 0;
+}
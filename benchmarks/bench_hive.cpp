@@ -0,0 +1,141 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Bench.h"
+#include "../includes/Hive.h"
+#include "../includes/List.h"
+#include "../includes/Vector.h"
+
+// usage: bench_hive [element count] [rounds]
+//
+// Object pool churn: after filling the pool, each round erases 10% of the live objects at random, inserts as
+// many new ones, then updates every object. Handles are rc::hive iterators, rc::list iterators (stable too,
+// but one node per element), or indices into an rc::vector with a free index list (the objects don't move,
+// but iteration has to test a live flag per slot).
+
+struct entity {
+    float position[3];
+    float velocity[3];
+};
+
+struct vector_pool {
+    rc::vector<entity> entities;
+    rc::vector<uint8_t> live;
+    rc::vector<uint32_t> free;
+
+    uint32_t insert(entity const &e) {
+        if (!free.empty()) {
+            uint32_t index = free.back();
+            free.pop_back();
+            entities[index] = e;
+            live[index] = 1;
+            return index;
+        }
+        entities.push_back(e);
+        live.push_back(1);
+        return static_cast<uint32_t>(entities.size() - 1);
+    }
+
+    void erase(uint32_t index) {
+        live[index] = 0;
+        free.push_back(index);
+    }
+};
+
+// Fills the pool through `insert`, then runs the rounds. `erase` and `update` take the handles of the pool.
+template<typename Handle, typename Insert, typename Erase, typename Update>
+void run(const char *name, size_t count, size_t rounds, Insert insert, Erase erase, Update update) {
+    char label[128];
+    std::mt19937 gen(42);
+    std::vector<Handle> handles;
+    handles.reserve(count);
+    entity e{{1, 2, 3}, {0.5f, 0.5f, 0.5f}};
+
+    double ns = bench::measure([&] {
+        for (size_t i = 0; i < count; ++i)
+            handles.push_back(insert(e));
+    });
+    std::snprintf(label, sizeof(label), "%s fill", name);
+    bench::report(label, count, ns);
+
+    size_t churn = count / 10;
+    double erase_ns = 0;
+    double insert_ns = 0;
+    double update_ns = 0;
+    float sum = 0;
+    for (size_t r = 0; r < rounds; ++r) {
+        erase_ns += bench::measure([&] {
+            for (size_t i = 0; i < churn; ++i) {
+                size_t k = gen() % handles.size();
+                erase(handles[k]);
+                handles[k] = handles.back();
+                handles.pop_back();
+            }
+        });
+        insert_ns += bench::measure([&] {
+            for (size_t i = 0; i < churn; ++i)
+                handles.push_back(insert(e));
+        });
+        update_ns += bench::measure([&] {
+            sum += update();
+        });
+    }
+    std::snprintf(label, sizeof(label), "%s churn erase", name);
+    bench::report(label, churn * rounds, erase_ns);
+    std::snprintf(label, sizeof(label), "%s churn insert", name);
+    bench::report(label, churn * rounds, insert_ns);
+    std::snprintf(label, sizeof(label), "%s update all", name);
+    bench::report(label, count * rounds, update_ns);
+    bench::do_not_optimize(sum);
+}
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 1000000);
+    size_t rounds = bench::arg(argc, argv, 2, 20);
+
+    {
+        rc::hive<entity> hive;
+        run<rc::hive<entity>::iterator>(
+                "rc::hive", count, rounds,
+                [&](entity const &e) { return hive.insert(e); },
+                [&](rc::hive<entity>::iterator it) { hive.erase(it); },
+                [&] {
+                    float sum = 0;
+                    for (auto &e: hive)
+                        sum += e.position[0] += e.velocity[0];
+                    return sum;
+                });
+    }
+    {
+        rc::list<entity> list;
+        run<rc::list<entity>::iterator>(
+                "rc::list", count, rounds,
+                [&](entity const &e) { return list.insert(list.end(), e); },
+                [&](rc::list<entity>::iterator it) {
+                    auto next = it;
+                    ++next;
+                    list.erase(it, next);
+                },
+                [&] {
+                    float sum = 0;
+                    for (auto &e: list)
+                        sum += e.position[0] += e.velocity[0];
+                    return sum;
+                });
+    }
+    {
+        vector_pool pool;
+        run<uint32_t>(
+                "rc::vector + index", count, rounds,
+                [&](entity const &e) { return pool.insert(e); },
+                [&](uint32_t index) { pool.erase(index); },
+                [&] {
+                    float sum = 0;
+                    for (size_t i = 0; i < pool.entities.size(); ++i)
+                        if (pool.live[i])
+                            sum += pool.entities[i].position[0] += pool.entities[i].velocity[0];
+                    return sum;
+                });
+    }
+    return 0;
+}
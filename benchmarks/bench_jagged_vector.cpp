@@ -0,0 +1,88 @@
+#include <malloc.h>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+#include "Bench.h"
+#include "../includes/JaggedVector.h"
+#include "../includes/Vector.h"
+
+// usage: bench_jagged_vector [vertex count] [edges per vertex]
+//
+// Adjacency lists of a random graph: rc::vector<rc::vector<uint32_t>> against rc::jagged_vector<uint32_t>
+// filled with its two-pass builder. Reports the heap bytes (from mallinfo2, allocator overhead included),
+// the build time and a traversal summing the neighbours of every vertex.
+
+// large blocks are mmapped, and counted apart.
+static size_t heap_in_use() {
+    auto info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+int main(int argc, char **argv) {
+    size_t vertices = bench::arg(argc, argv, 1, 1000000);
+    size_t degree = bench::arg(argc, argv, 2, 8);
+    size_t edge_count = vertices * degree;
+    char label[128];
+
+    std::mt19937 gen(42);
+    std::vector<std::pair<uint32_t, uint32_t>> edges(edge_count);
+    for (auto &edge: edges)
+        edge = {static_cast<uint32_t>(gen() % vertices), static_cast<uint32_t>(gen() % vertices)};
+
+    // vector of vectors
+    size_t before = heap_in_use();
+    auto *nested = new rc::vector<rc::vector<uint32_t>>();
+    double ns = bench::measure([&] {
+        nested->resize(vertices);
+        for (auto &edge: edges)
+            (*nested)[edge.first].push_back(edge.second);
+    });
+    size_t bytes = heap_in_use() - before;
+    bench::report("vector<vector> build", edge_count, ns);
+    std::printf("%-48s %10.2f bytes/edge\n", "vector<vector>", static_cast<double>(bytes) / edge_count);
+
+    uint64_t sum = 0;
+    ns = bench::measure([&] {
+        for (size_t v = 0; v < vertices; ++v)
+            for (uint32_t neighbour: (*nested)[v])
+                sum += neighbour;
+    });
+    bench::report("vector<vector> traversal", edge_count, ns);
+    delete nested;
+
+    // jagged vector, sequential then parallel prefix sum
+    unsigned threads = std::thread::hardware_concurrency();
+    for (unsigned t: {1u, threads > 1 ? threads : 4u}) {
+        before = heap_in_use();
+        auto *jagged = new rc::jagged_vector<uint32_t>();
+        ns = bench::measure([&] {
+            rc::jagged_vector<uint32_t>::builder builder(vertices);
+            for (auto &edge: edges)
+                builder.count(edge.first);
+            builder.allocate(t);
+            for (auto &edge: edges)
+                builder.fill(edge.first, edge.second);
+            *jagged = std::move(builder).build();
+        });
+        bytes = heap_in_use() - before;
+        std::snprintf(label, sizeof(label), "jagged_vector build (%u threads)", t);
+        bench::report(label, edge_count, ns);
+        if (t == 1)
+            std::printf("%-48s %10.2f bytes/edge\n", "jagged_vector", static_cast<double>(bytes) / edge_count);
+
+        uint64_t jagged_sum = 0;
+        ns = bench::measure([&] {
+            for (size_t v = 0; v < vertices; ++v)
+                for (uint32_t neighbour: jagged->row(v))
+                    jagged_sum += neighbour;
+        });
+        if (t == 1)
+            bench::report("jagged_vector traversal", edge_count, ns);
+        sum += jagged_sum;
+        delete jagged;
+    }
+
+    bench::do_not_optimize(sum);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <random>
+#include <vector>
+#include <cstdint>
+#include "Bench.h"
+#include "../includes/List.h"
+
+// usage: bench_list_compact [element count] [churn rounds]
+//
+// Builds a list by inserting at random positions, then erases and re-inserts random elements,
+// so that list order and heap order no longer match. Measures traversal before and after compact().
+
+template<typename LIST>
+void traverse(const char *name, LIST &list) {
+    char label[128];
+    int64_t sum = 0;
+    double ns = bench::measure([&] {
+        for (auto it = list.begin(); it != list.end(); ++it)
+            sum += *it;
+    });
+    std::snprintf(label, sizeof(label), "%s: iterators", name);
+    bench::report(label, list.size(), ns);
+
+    ns = bench::measure([&] {
+        list.for_each([&](int64_t value) { sum += value; });
+    });
+    std::snprintf(label, sizeof(label), "%s: for_each", name);
+    bench::report(label, list.size(), ns);
+    bench::do_not_optimize(sum);
+}
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 2000000);
+    size_t rounds = bench::arg(argc, argv, 2, 4);
+    std::mt19937_64 gen(42);
+
+    rc::list<int64_t> list;
+    std::vector<rc::list<int64_t>::iterator> handles;
+    handles.reserve(count);
+    handles.push_back(list.insert(list.end(), 0));
+    for (size_t i = 1; i < count; ++i)
+        handles.push_back(list.insert(handles[gen() % handles.size()], static_cast<int64_t>(i)));
+
+    for (size_t round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < count / 2; ++i) {
+            size_t victim = gen() % count;
+            auto next = handles[victim];
+            ++next;
+            list.erase(handles[victim], next);
+            size_t target = gen() % count;
+            if (target == victim)
+                target = (target + 1) % count;
+            handles[victim] = list.insert(handles[target], static_cast<int64_t>(victim));
+        }
+    }
+
+    traverse("churned", list);
+    double ns = bench::measure([&] { list.compact(); });
+    bench::report("compact()", list.size(), ns);
+    traverse("compacted", list);
+    return 0;
+}
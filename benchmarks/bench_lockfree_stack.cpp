@@ -0,0 +1,70 @@
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include "Bench.h"
+#include "../includes/LockfreeStack.h"
+#include "../includes/List.h"
+
+// usage: bench_lockfree_stack [operations per thread] [max threads]
+//
+// Shared free list workload: every thread pops an object and pushes it back, with 1 to max threads.
+
+struct locked_list {
+    std::mutex mutex;
+    rc::list<uint64_t> list;
+
+    void push(uint64_t value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_front(value);
+    }
+
+    bool try_pop(uint64_t &out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.empty())
+            return false;
+        out = list.front();
+        list.pop_front();
+        return true;
+    }
+};
+
+template<typename STACK>
+void contention(const char *name, STACK &stack, size_t operations, unsigned threads) {
+    for (uint64_t i = 0; i < 1024; ++i)
+        stack.push(i);
+
+    std::vector<std::thread> pool;
+    double ns = bench::measure([&] {
+        for (unsigned t = 0; t < threads; ++t)
+            pool.emplace_back([&, t] {
+                bench::pin_thread(t);
+                uint64_t object = 0;
+                for (size_t i = 0; i < operations; ++i) {
+                    if (stack.try_pop(object))
+                        stack.push(object);
+                }
+            });
+        for (auto &thread: pool)
+            thread.join();
+    });
+
+    char label[128];
+    std::snprintf(label, sizeof(label), "%s x%u (pop + push)", name, threads);
+    bench::report(label, operations * threads, ns);
+}
+
+int main(int argc, char **argv) {
+    size_t operations = bench::arg(argc, argv, 1, 1000000);
+    auto max_threads = static_cast<unsigned>(bench::arg(argc, argv, 2, std::thread::hardware_concurrency()));
+    if (max_threads == 0)
+        max_threads = 1;
+
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        rc::lockfree_stack<uint64_t> stack;
+        contention("lockfree_stack", stack, operations, threads);
+        locked_list list;
+        contention("mutex + rc::list", list, operations, threads);
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Bench.h"
+#include "../includes/LruCache.h"
+#include "../includes/List.h"
+
+// usage: bench_lru_cache [operations] [capacity]
+//
+// Skewed lookups (a key is the product of two uniform draws, so small keys are hot) over 16 times more keys than
+// the cache holds, inserting on a miss. The baseline is the usual hand-rolled LRU: an rc::list of keys plus a
+// std::unordered_map, allocating a list node and a map node on every miss.
+
+struct naive_lru {
+    size_t capacity;
+    rc::list<rc::Pair<size_t, size_t>> order;
+    std::unordered_map<size_t, rc::list<rc::Pair<size_t, size_t>>::iterator> index;
+
+    explicit naive_lru(size_t capacity) : capacity(capacity) {}
+
+    size_t *find(size_t key) {
+        auto it = index.find(key);
+        if (it == index.end())
+            return nullptr;
+        auto node = it->second;
+        order.splice(order.begin(), order, node);
+        return &node->second;
+    }
+
+    void put(size_t key, size_t value) {
+        if (index.size() == capacity) {
+            index.erase(order.back().first);
+            order.pop_back();
+        }
+        order.push_front({key, value});
+        index[key] = order.begin();
+    }
+};
+
+int main(int argc, char **argv) {
+    size_t ops = bench::arg(argc, argv, 1, 4000000);
+    size_t capacity = bench::arg(argc, argv, 2, 65536);
+    size_t universe = capacity * 16;
+
+    std::mt19937_64 gen(42);
+    std::vector<size_t> keys(ops);
+    for (auto &key: keys) {
+        size_t a = gen() % universe;
+        size_t b = gen() % universe;
+        key = a * b / universe;
+    }
+    size_t sum = 0;
+
+    {
+        naive_lru cache(capacity);
+        double ns = bench::measure([&] {
+            for (size_t key: keys) {
+                if (size_t *value = cache.find(key))
+                    sum += *value;
+                else
+                    cache.put(key, key);
+            }
+        });
+        bench::report("rc::list + std::unordered_map", ops, ns);
+    }
+    {
+        rc::lru_cache<size_t, size_t> cache(capacity);
+        double ns = bench::measure([&] {
+            for (size_t key: keys) {
+                if (size_t *value = cache.find(key))
+                    sum += *value;
+                else
+                    cache.put(key, key);
+            }
+        });
+        bench::report("rc::lru_cache", ops, ns);
+        auto stats = cache.stats();
+        std::printf("    hit rate %.1f%%, %zu evictions\n", 100.0 * stats.hits / (stats.hits + stats.misses),
+                    stats.evictions);
+    }
+
+    size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    size_t per_thread = ops / threads;
+    {
+        rc::lru_cache<size_t, size_t> cache(capacity);
+        std::mutex mutex;
+        double ns = bench::measure([&] {
+            std::vector<std::thread> pool;
+            for (size_t t = 0; t < threads; ++t) {
+                pool.emplace_back([&, t] {
+                    size_t local = 0;
+                    for (size_t i = t * per_thread; i < (t + 1) * per_thread; ++i) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (size_t *value = cache.find(keys[i]))
+                            local += *value;
+                        else
+                            cache.put(keys[i], keys[i]);
+                    }
+                    bench::do_not_optimize(local);
+                });
+            }
+            for (auto &thread: pool)
+                thread.join();
+        });
+        bench::report("rc::lru_cache + one mutex, all threads", per_thread * threads, ns);
+    }
+    {
+        rc::sharded_lru_cache<size_t, size_t> cache(capacity, 16);
+        double ns = bench::measure([&] {
+            std::vector<std::thread> pool;
+            for (size_t t = 0; t < threads; ++t) {
+                pool.emplace_back([&, t] {
+                    size_t local = 0;
+                    for (size_t i = t * per_thread; i < (t + 1) * per_thread; ++i) {
+                        if (auto value = cache.get(keys[i]))
+                            local += *value;
+                        else
+                            cache.put(keys[i], keys[i]);
+                    }
+                    bench::do_not_optimize(local);
+                });
+            }
+            for (auto &thread: pool)
+                thread.join();
+        });
+        bench::report("rc::sharded_lru_cache (16 shards), all threads", per_thread * threads, ns);
+    }
+
+    bench::do_not_optimize(sum);
+    return 0;
+}
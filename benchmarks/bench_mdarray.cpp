@@ -0,0 +1,73 @@
+#include "Bench.h"
+#include "../includes/MdArray.h"
+
+// usage: bench_mdarray [n]
+//
+// Row and column passes over an n x n float matrix for each layout, then the transpose and layout conversion
+// kernels against the plain double loop.
+
+template<typename Layout>
+void traversals(const char *row_name, const char *column_name, size_t n) {
+    rc::mdarray<float, rc::dextents<2>, Layout> m(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            m(i, j) = static_cast<float>(i ^ j);
+    auto view = m.view();
+    float sum = 0;
+
+    double ns = bench::measure([&] {
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                sum += view(i, j);
+    });
+    bench::report(row_name, n * n, ns);
+
+    ns = bench::measure([&] {
+        for (size_t j = 0; j < n; ++j)
+            for (size_t i = 0; i < n; ++i)
+                sum += view(i, j);
+    });
+    bench::report(column_name, n * n, ns);
+    bench::do_not_optimize(sum);
+}
+
+int main(int argc, char **argv) {
+    size_t n = bench::arg(argc, argv, 1, 2048);
+
+    traversals<rc::layout_right>("layout_right row pass", "layout_right column pass", n);
+    traversals<rc::layout_left>("layout_left row pass", "layout_left column pass", n);
+    traversals<rc::layout_blocked<16>>("layout_blocked<16> row pass", "layout_blocked<16> column pass", n);
+
+    rc::mdarray<float, rc::dextents<2>> src(n, n);
+    rc::mdarray<float, rc::dextents<2>> dst(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            src(i, j) = static_cast<float>(i + j);
+    auto s = src.view();
+    auto d = dst.view();
+
+    double ns = bench::measure([&] {
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                d(j, i) = s(i, j);
+    });
+    bench::report("transpose, double loop", n * n, ns);
+
+    ns = bench::measure([&] { rc::transpose(s, d); });
+    bench::report("rc::transpose (32 x 32 tiles)", n * n, ns);
+    bench::do_not_optimize(dst.data()[1]);
+
+    rc::mdarray<float, rc::dextents<2>, rc::layout_left> left(n, n);
+    auto l = left.view();
+    ns = bench::measure([&] {
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                l(i, j) = s(i, j);
+    });
+    bench::report("row -> column major, double loop", n * n, ns);
+
+    ns = bench::measure([&] { rc::copy(s, l); });
+    bench::report("rc::copy row -> column major", n * n, ns);
+    bench::do_not_optimize(left.data()[1]);
+    return 0;
+}
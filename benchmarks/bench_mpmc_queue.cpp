@@ -0,0 +1,88 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include "Bench.h"
+#include "../includes/MpmcQueue.h"
+#include "../includes/List.h"
+
+// usage: bench_mpmc_queue [message count] [max threads per side]
+//
+// For every producers x consumers combination from 1 to max threads, moves `message count` integers
+// through the queue, and through the mutex-guarded rc::list it replaces.
+
+struct locked_list {
+    std::mutex mutex;
+    rc::list<uint64_t> list;
+
+    bool try_push(uint64_t value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_back(value);
+        return true;
+    }
+
+    bool try_pop(uint64_t &out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.empty())
+            return false;
+        out = list.front();
+        list.pop_front();
+        return true;
+    }
+
+    bool empty() const { return list.empty(); }
+};
+
+template<typename QUEUE>
+void contention(const char *name, QUEUE &queue, size_t count, unsigned producers, unsigned consumers) {
+    std::atomic<uint64_t> sum(0);
+    std::vector<std::thread> threads;
+
+    double ns = bench::measure([&] {
+        for (unsigned p = 0; p < producers; ++p)
+            threads.emplace_back([&, p] {
+                bench::pin_thread(p);
+                for (size_t i = p; i < count; i += producers) {
+                    while (!queue.try_push(i))
+                        std::this_thread::yield();
+                }
+            });
+        for (unsigned c = 0; c < consumers; ++c)
+            threads.emplace_back([&, c] {
+                bench::pin_thread(producers + c);
+                uint64_t local = 0;
+                uint64_t value;
+                for (size_t i = c; i < count; i += consumers) {
+                    while (!queue.try_pop(value))
+                        std::this_thread::yield();
+                    local += value;
+                }
+                sum.fetch_add(local);
+            });
+        for (auto &thread: threads)
+            thread.join();
+    });
+
+    char label[128];
+    std::snprintf(label, sizeof(label), "%s %up/%uc", name, producers, consumers);
+    bench::do_not_optimize(sum.load());
+    bench::report(label, count, ns);
+}
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 2000000);
+    unsigned max_threads = static_cast<unsigned>(bench::arg(argc, argv, 2, std::thread::hardware_concurrency() / 2));
+    if (max_threads == 0)
+        max_threads = 1;
+
+    for (unsigned producers = 1; producers <= max_threads; ++producers) {
+        for (unsigned consumers = 1; consumers <= max_threads; ++consumers) {
+            rc::mpmc_queue<uint64_t> queue(1024);
+            contention("mpmc_queue", queue, count, producers, consumers);
+            locked_list list;
+            contention("mutex + rc::list", list, count, producers, consumers);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Bench.h"
+#include "../includes/PackedIntVector.h"
+#include "../includes/Vector.h"
+
+// usage: bench_packed_int_vector [value count] [average gap]
+//
+// Sorted 64 bit ids with random gaps, stored in rc::vector<uint64_t>, in rc::packed_int_vector (width of the
+// largest id) and in rc::packed_sorted_vector. Reports the size of each, the streaming decode throughput,
+// and random lookups.
+
+static void report_size(const char *name, size_t bytes, size_t count) {
+    std::printf("%-48s %10.2f bits/value %10.2fx smaller\n", name, 8.0 * bytes / count,
+                static_cast<double>(count * sizeof(uint64_t)) / bytes);
+}
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 20000000);
+    size_t gap = bench::arg(argc, argv, 2, 16);
+    size_t lookups = 1000000;
+
+    std::mt19937_64 gen(42);
+    rc::vector<uint64_t> plain;
+    plain.reserve(count);
+    uint64_t id = uint64_t(1) << 40;
+    for (size_t i = 0; i < count; ++i) {
+        plain.push_back(id);
+        id += gen() % (2 * gap + 1);
+    }
+    rc::packed_int_vector packed(1);
+    packed.reserve(count);
+    for (uint64_t value: plain)
+        packed.push_back(value);
+    rc::packed_sorted_vector sorted(plain.data(), plain.data() + count);
+
+    report_size("rc::vector<uint64_t>", count * sizeof(uint64_t), count);
+    report_size("rc::packed_int_vector", packed.bytes(), count);
+    report_size("rc::packed_sorted_vector", sorted.bytes(), count);
+
+    uint64_t sum = 0;
+    double ns = bench::measure([&] {
+        for (uint64_t value: plain)
+            sum += value;
+    });
+    bench::report("rc::vector<uint64_t> scan", count, ns);
+
+    ns = bench::measure([&] {
+        for (size_t i = 0; i < count; ++i)
+            sum += packed[i];
+    });
+    bench::report("rc::packed_int_vector scan", count, ns);
+
+    ns = bench::measure([&] {
+        for (uint64_t value: sorted)
+            sum += value;
+    });
+    bench::report("rc::packed_sorted_vector iterator", count, ns);
+
+    uint64_t block[rc::packed_sorted_vector::block_size];
+    ns = bench::measure([&] {
+        for (size_t b = 0; b < sorted.block_count(); ++b) {
+            size_t n = sorted.decode(b, block);
+            for (size_t i = 0; i < n; ++i)
+                sum += block[i];
+        }
+    });
+    bench::report("rc::packed_sorted_vector decode()", count, ns);
+
+    std::vector<uint64_t> queries(lookups);
+    for (auto &query: queries)
+        query = plain[0] + gen() % (id - plain[0]);
+    ns = bench::measure([&] {
+        for (uint64_t query: queries)
+            sum += std::lower_bound(plain.data(), plain.data() + count, query) - plain.data();
+    });
+    bench::report("rc::vector<uint64_t> lower_bound", lookups, ns);
+
+    ns = bench::measure([&] {
+        for (uint64_t query: queries)
+            sum += sorted.lower_bound(query);
+    });
+    bench::report("rc::packed_sorted_vector lower_bound", lookups, ns);
+
+    ns = bench::measure([&] {
+        for (uint64_t query: queries)
+            sum += sorted[query % count];
+    });
+    bench::report("rc::packed_sorted_vector operator[]", lookups, ns);
+
+    bench::do_not_optimize(sum);
+    return 0;
+}
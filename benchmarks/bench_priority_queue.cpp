@@ -0,0 +1,80 @@
+#include <queue>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include "Bench.h"
+#include "../includes/PriorityQueue.h"
+
+// usage: bench_priority_queue [element count]
+//
+// Event-simulation style workload (a min-heap of timestamps): fill, then pop the earliest event and
+// schedule a later one, then drain. Compared with std::priority_queue (a binary heap).
+
+template<typename QUEUE>
+void run(const char *name, const std::vector<uint64_t> &times) {
+    char label[128];
+    QUEUE queue;
+    uint64_t sum = 0;
+
+    double ns = bench::measure([&] {
+        for (uint64_t time: times)
+            queue.push(time);
+    });
+    std::snprintf(label, sizeof(label), "%s push", name);
+    bench::report(label, times.size(), ns);
+
+    ns = bench::measure([&] {
+        for (uint64_t delay: times) {
+            uint64_t now = queue.top();
+            queue.pop();
+            queue.push(now + delay);
+            sum += now;
+        }
+    });
+    std::snprintf(label, sizeof(label), "%s pop + push", name);
+    bench::report(label, times.size(), ns);
+
+    ns = bench::measure([&] {
+        while (!queue.empty()) {
+            sum += queue.top();
+            queue.pop();
+        }
+    });
+    std::snprintf(label, sizeof(label), "%s pop", name);
+    bench::report(label, times.size(), ns);
+
+    bench::do_not_optimize(sum);
+}
+
+template<typename QUEUE>
+void build(const char *name, const std::vector<uint64_t> &times) {
+    char label[128];
+    uint64_t sum = 0;
+    double ns = bench::measure([&] {
+        QUEUE queue(times.begin(), times.end());
+        sum += queue.top();
+    });
+    std::snprintf(label, sizeof(label), "%s build", name);
+    bench::report(label, times.size(), ns);
+    bench::do_not_optimize(sum);
+}
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 1000000);
+
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<uint64_t> dist(0, 1u << 30);
+    std::vector<uint64_t> times(count);
+    for (auto &time: times)
+        time = dist(gen);
+
+    using std_queue = std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<>>;
+    run<std_queue>("std::priority_queue", times);
+    run<rc::priority_queue<uint64_t, std::greater<>, 2>>("rc::priority_queue<2>", times);
+    run<rc::priority_queue<uint64_t, std::greater<>, 4>>("rc::priority_queue<4>", times);
+    run<rc::priority_queue<uint64_t, std::greater<>, 8>>("rc::priority_queue<8>", times);
+
+    build<std_queue>("std::priority_queue", times);
+    build<rc::priority_queue<uint64_t, std::greater<>, 4>>("rc::priority_queue<4>", times);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <cstdint>
+#include "Bench.h"
+#include "../includes/RadixSort.h"
+
+// usage: bench_radix_sort [element count] [threads]
+
+template<typename T, typename SORT>
+void run(const char *name, const rc::vector<T> &input, SORT sort) {
+    rc::vector<T> values = input;
+    double ns = bench::measure([&] { sort(values); });
+    bench::do_not_optimize(values[values.size() / 2]);
+    bench::report(name, values.size(), ns);
+}
+
+template<typename T>
+void compare(const char *type, const rc::vector<T> &input, unsigned threads) {
+    char label[128];
+    std::snprintf(label, sizeof(label), "std::sort %s", type);
+    run(label, input, [](auto &v) { std::sort(v.data(), v.data() + v.size()); });
+    std::snprintf(label, sizeof(label), "rc::radix_sort %s", type);
+    run(label, input, [](auto &v) { rc::radix_sort(v); });
+    std::snprintf(label, sizeof(label), "rc::parallel_radix_sort %s x%u", type, threads);
+    run(label, input, [threads](auto &v) { rc::parallel_radix_sort(v, rc::radix_identity(), threads); });
+}
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 10000000);
+    auto threads = static_cast<unsigned>(bench::arg(argc, argv, 2, std::thread::hardware_concurrency()));
+
+    std::mt19937_64 gen(42);
+    rc::vector<uint32_t> u32;
+    rc::vector<uint64_t> u64;
+    rc::vector<float> f32;
+    rc::vector<rc::Pair<uint32_t, uint32_t>> pairs;
+    u32.reserve(count);
+    u64.reserve(count);
+    f32.reserve(count);
+    pairs.reserve(count);
+    std::uniform_real_distribution<float> real(-1e6f, 1e6f);
+    for (size_t i = 0; i < count; ++i) {
+        u64.push_back(gen());
+        u32.push_back(static_cast<uint32_t>(u64.back()));
+        f32.push_back(real(gen));
+        pairs.push_back({u32.back(), static_cast<uint32_t>(i)});
+    }
+
+    compare("uint32_t", u32, threads);
+    compare("uint64_t", u64, threads);
+    compare("float", f32, threads);
+
+    auto by_key = [](const auto &pair) { return pair.first; };
+    run("std::stable_sort key-index", pairs, [](auto &v) {
+        std::stable_sort(v.data(), v.data() + v.size(), [](auto &a, auto &b) { return a.first < b.first; });
+    });
+    run("rc::radix_sort key-index", pairs, [&](auto &v) { rc::radix_sort(v, by_key); });
+    return 0;
+}
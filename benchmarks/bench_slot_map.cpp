@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include "Bench.h"
+#include "../includes/SlotMap.h"
+#include "../includes/List.h"
+
+// usage: bench_slot_map [element count]
+//
+// Entities referred to by handle: slot_map keys, or rc::list iterators (stable, but one node per element).
+// Half of the entities are erased at random before measuring, to fragment the list.
+
+struct entity {
+    float position[3];
+    float velocity[3];
+};
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 1000000);
+    std::mt19937 gen(42);
+    float sum = 0;
+
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; ++i)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), gen);
+
+    {
+        rc::slot_map<entity> map;
+        std::vector<rc::slot_map_key> keys;
+        keys.reserve(count);
+        double ns = bench::measure([&] {
+            for (size_t i = 0; i < count; ++i)
+                keys.push_back(map.insert({{1, 2, 3}, {0.5f, 0.5f, 0.5f}}));
+        });
+        bench::report("slot_map insert", count, ns);
+
+        ns = bench::measure([&] {
+            for (size_t i = 0; i < count / 2; ++i)
+                map.erase(keys[order[i]]);
+        });
+        bench::report("slot_map erase", count / 2, ns);
+
+        ns = bench::measure([&] {
+            for (auto &e: map)
+                sum += e.position[0] += e.velocity[0];
+        });
+        bench::report("slot_map iterate", map.size(), ns);
+
+        ns = bench::measure([&] {
+            for (size_t i = count / 2; i < count; ++i)
+                sum += map[keys[order[i]]].position[1];
+        });
+        bench::report("slot_map lookup", count - count / 2, ns);
+    }
+    {
+        rc::list<entity> list;
+        std::vector<rc::list<entity>::iterator> handles;
+        handles.reserve(count);
+        double ns = bench::measure([&] {
+            for (size_t i = 0; i < count; ++i)
+                handles.push_back(list.insert(list.end(), entity{{1, 2, 3}, {0.5f, 0.5f, 0.5f}}));
+        });
+        bench::report("rc::list insert", count, ns);
+
+        ns = bench::measure([&] {
+            for (size_t i = 0; i < count / 2; ++i) {
+                auto next = handles[order[i]];
+                ++next;
+                list.erase(handles[order[i]], next);
+            }
+        });
+        bench::report("rc::list erase", count / 2, ns);
+
+        ns = bench::measure([&] {
+            for (auto &e: list)
+                sum += e.position[0] += e.velocity[0];
+        });
+        bench::report("rc::list iterate", list.size(), ns);
+
+        ns = bench::measure([&] {
+            for (size_t i = count / 2; i < count; ++i)
+                sum += handles[order[i]]->position[1];
+        });
+        bench::report("rc::list lookup", count - count / 2, ns);
+    }
+    bench::do_not_optimize(sum);
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include "Bench.h"
+#include "../includes/SpscRing.h"
+#include "../includes/List.h"
+
+// usage: bench_spsc_ring [message count]
+//
+// The producer runs on core 0 and the consumer on core 1 (when the machine has them).
+
+constexpr size_t ring_size = 1024;
+constexpr size_t batch_size = 64;
+
+// The baseline being replaced: a rc::list guarded by a mutex.
+struct locked_list {
+    std::mutex mutex;
+    rc::list<uint64_t> list;
+
+    bool try_push(uint64_t value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_back(value);
+        return true;
+    }
+
+    bool try_pop(uint64_t &out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.empty())
+            return false;
+        out = list.front();
+        list.pop_front();
+        return true;
+    }
+};
+
+template<typename QUEUE>
+void throughput(const char *name, size_t count) {
+    QUEUE queue;
+    uint64_t sum = 0;
+
+    double ns = bench::measure([&] {
+        std::thread consumer([&] {
+            bench::pin_thread(1);
+            uint64_t value;
+            for (size_t received = 0; received < count;) {
+                if (queue.try_pop(value)) {
+                    sum += value;
+                    ++received;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        bench::pin_thread(0);
+        for (uint64_t i = 0; i < count; ++i) {
+            while (!queue.try_push(i))
+                std::this_thread::yield();
+        }
+        consumer.join();
+    });
+    bench::do_not_optimize(sum);
+    bench::report(name, count, ns);
+}
+
+void bulk_throughput(size_t count) {
+    rc::spsc_ring<uint64_t, ring_size> ring;
+    uint64_t sum = 0;
+
+    double ns = bench::measure([&] {
+        std::thread consumer([&] {
+            bench::pin_thread(1);
+            uint64_t values[batch_size];
+            for (size_t received = 0; received < count;) {
+                size_t n = ring.try_pop_n(values, batch_size);
+                for (size_t i = 0; i < n; ++i)
+                    sum += values[i];
+                received += n;
+                if (n == 0)
+                    std::this_thread::yield();
+            }
+        });
+        bench::pin_thread(0);
+        uint64_t values[batch_size];
+        for (uint64_t sent = 0; sent < count;) {
+            size_t n = count - sent < batch_size ? count - sent : batch_size;
+            for (size_t i = 0; i < n; ++i)
+                values[i] = sent + i;
+            size_t pushed = ring.try_push_n(values, n);
+            sent += pushed;
+            if (pushed == 0)
+                std::this_thread::yield();
+        }
+        consumer.join();
+    });
+    bench::do_not_optimize(sum);
+    bench::report("spsc_ring throughput (try_push_n/try_pop_n)", count, ns);
+}
+
+// Ping-pong between the two threads: reports half of the round trip.
+void latency(size_t count) {
+    rc::spsc_ring<uint64_t, ring_size> ping;
+    rc::spsc_ring<uint64_t, ring_size> pong;
+
+    double ns = bench::measure([&] {
+        std::thread echo([&] {
+            bench::pin_thread(1);
+            uint64_t value;
+            for (size_t i = 0; i < count; ++i) {
+                while (!ping.try_pop(value))
+                    std::this_thread::yield();
+                pong.try_push(value);
+            }
+        });
+        bench::pin_thread(0);
+        uint64_t value;
+        for (uint64_t i = 0; i < count; ++i) {
+            ping.try_push(i);
+            while (!pong.try_pop(value))
+                std::this_thread::yield();
+        }
+        echo.join();
+    });
+    bench::report("spsc_ring one-way latency", count * 2, ns);
+}
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 10000000);
+
+    throughput<rc::spsc_ring<uint64_t, ring_size>>("spsc_ring throughput (try_push/try_pop)", count);
+    bulk_throughput(count);
+    throughput<locked_list>("mutex + rc::list throughput", count);
+    latency(count / 10);
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Bench.h"
+#include "../includes/StaticVector.h"
+#include "../includes/Vector.h"
+
+// usage: bench_static_vector [packet count]
+//
+// Per-packet scratch buffers: each packet collects up to 32 header fields in a fresh container, then sums them.
+// rc::vector allocates (and reallocates while growing) for every packet; static_vector stays on the stack.
+
+struct field {
+    uint16_t tag;
+    uint16_t length;
+    uint32_t value;
+};
+
+int main(int argc, char **argv) {
+    size_t packets = bench::arg(argc, argv, 1, 2000000);
+    std::mt19937 gen(42);
+    std::vector<uint8_t> field_counts(packets);
+    for (auto &count: field_counts)
+        count = 4 + gen() % 29;
+    uint64_t sum = 0;
+
+    double ns = bench::measure([&] {
+        for (size_t p = 0; p < packets; ++p) {
+            rc::vector<field> fields;
+            for (uint16_t i = 0; i < field_counts[p]; ++i)
+                fields.push_back({i, 4, static_cast<uint32_t>(p + i)});
+            for (auto &f: fields)
+                sum += f.value + f.length;
+        }
+    });
+    bench::report("rc::vector per packet", packets, ns);
+
+    ns = bench::measure([&] {
+        for (size_t p = 0; p < packets; ++p) {
+            rc::static_vector<field, 32> fields;
+            for (uint16_t i = 0; i < field_counts[p]; ++i)
+                fields.push_back({i, 4, static_cast<uint32_t>(p + i)});
+            for (auto &f: fields)
+                sum += f.value + f.length;
+        }
+    });
+    bench::report("rc::static_vector<32> per packet", packets, ns);
+
+    bench::do_not_optimize(sum);
+    return 0;
+}
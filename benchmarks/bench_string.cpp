@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "../includes/HashMap.h"
+#include "../includes/String.h"
+#include "../includes/Vector.h"
+
+// usage: bench_string [key count]
+//
+// Short keys (8 to 23 chars, like ids and column names): construction, copy, hash map insert and lookup,
+// and character search, for rc::string and std::string. libstdc++'s std::string keeps 15 chars inline,
+// rc::string 23.
+
+template<typename STRING>
+void run(const char *name, std::vector<std::string> const &keys) {
+    char label[128];
+    size_t count = keys.size();
+    size_t sum = 0;
+
+    rc::vector<STRING> strings;
+    strings.reserve(count);
+    double ns = bench::measure([&] {
+        for (auto &key: keys)
+            strings.emplace_back(key.data(), key.size());
+    });
+    std::snprintf(label, sizeof(label), "%s construct", name);
+    bench::report(label, count, ns);
+
+    ns = bench::measure([&] {
+        rc::vector<STRING> copy = strings;
+        sum += copy.size();
+    });
+    std::snprintf(label, sizeof(label), "%s copy", name);
+    bench::report(label, count, ns);
+
+    rc::hash_map<STRING, uint32_t> map;
+    ns = bench::measure([&] {
+        for (size_t i = 0; i < count; ++i)
+            map[strings[i]] = static_cast<uint32_t>(i);
+    });
+    std::snprintf(label, sizeof(label), "%s hash_map insert", name);
+    bench::report(label, count, ns);
+
+    ns = bench::measure([&] {
+        for (size_t i = 0; i < count; ++i)
+            sum += map.find(strings[count - 1 - i]) != map.end();
+    });
+    std::snprintf(label, sizeof(label), "%s hash_map find", name);
+    bench::report(label, count, ns);
+
+    ns = bench::measure([&] {
+        for (auto &s: strings)
+            sum += s.find('_');
+    });
+    std::snprintf(label, sizeof(label), "%s find('_')", name);
+    bench::report(label, count, ns);
+
+    bench::do_not_optimize(sum);
+}
+
+int main(int argc, char **argv) {
+    size_t count = bench::arg(argc, argv, 1, 1000000);
+
+    std::mt19937 gen(42);
+    std::vector<std::string> keys(count);
+    for (auto &key: keys) {
+        size_t length = 8 + gen() % 16;
+        for (size_t i = 0; i < length; ++i)
+            key.push_back(static_cast<char>('a' + gen() % 26));
+        key[gen() % length] = '_';
+    }
+
+    run<rc::string>("rc::string", keys);
+    run<std::string>("std::string", keys);
+    return 0;
+}
@@ -0,0 +1,230 @@
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Bench.h"
+#include "../includes/List.h"
+#include "../includes/WorkStealingDeque.h"
+
+// usage: bench_work_stealing_deque [fib n] [tree depth] [max threads]
+//
+// Fork-join workloads on a pool of 1 to max threads, each worker owning a deque of tasks: it pushes and pops
+// its own tasks at the bottom, and steals a batch from the top of another deque when it runs out.
+// A join runs other tasks until the joined one is done.
+//  - fib: parallel fib(n), a task per call above n = 12.
+//  - tree sum: sum of a perfect binary tree, a task per node above the 6 lowest levels.
+// Deques are rc::work_stealing_deque, or a mutex guarded rc::list.
+
+struct locked_list {
+    std::mutex mutex;
+    rc::list<void *> list;
+
+    void push(void *value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_back(value);
+    }
+
+    bool try_pop(void *&out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.empty())
+            return false;
+        out = list.back();
+        list.pop_back();
+        return true;
+    }
+
+    size_t steal_batch(void **out, size_t max) {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = (list.size() + 1) / 2;
+        if (count > max)
+            count = max;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = list.front();
+            list.pop_front();
+        }
+        return count;
+    }
+};
+
+struct task {
+    void (*run)(task &self, void *pool, unsigned worker);
+    std::atomic<bool> done{false};
+};
+
+template<typename DEQUE>
+class fork_join_pool {
+    static constexpr size_t _steal = 8;
+
+    std::vector<std::unique_ptr<DEQUE>> _deques;
+    std::atomic<bool> _stop{false};
+
+public:
+    explicit fork_join_pool(unsigned workers) {
+        for (unsigned i = 0; i < workers; ++i)
+            _deques.push_back(std::make_unique<DEQUE>());
+    }
+
+    // Runs `root` on the calling thread, as worker 0.
+    void run(task &root) {
+        std::vector<std::thread> threads;
+        for (unsigned w = 1; w < _deques.size(); ++w)
+            threads.emplace_back([this, w] {
+                bench::pin_thread(w);
+                while (!_stop.load(std::memory_order_acquire))
+                    if (!_run_one(w))
+                        std::this_thread::yield();
+            });
+        bench::pin_thread(0);
+        _execute(root, 0);
+        _stop.store(true, std::memory_order_release);
+        for (auto &thread: threads)
+            thread.join();
+    }
+
+    void spawn(task &t, unsigned worker) { _deques[worker]->push(&t); }
+
+    void join(task &t, unsigned worker) {
+        while (!t.done.load(std::memory_order_acquire))
+            _run_one(worker);
+    }
+
+private:
+    void _execute(task &t, unsigned worker) {
+        t.run(t, this, worker);
+        t.done.store(true, std::memory_order_release);
+    }
+
+    // runs a task of its own deque, or else steals some: returns false if there was none.
+    bool _run_one(unsigned worker) {
+        void *t;
+        if (_deques[worker]->try_pop(t)) {
+            _execute(*static_cast<task *>(t), worker);
+            return true;
+        }
+        auto workers = static_cast<unsigned>(_deques.size());
+        for (unsigned i = 1; i < workers; ++i) {
+            void *batch[_steal];
+            size_t count = _deques[(worker + i) % workers]->steal_batch(batch, _steal);
+            if (count == 0)
+                continue;
+            for (size_t j = 1; j < count; ++j)
+                _deques[worker]->push(batch[j]);
+            _execute(*static_cast<task *>(batch[0]), worker);
+            return true;
+        }
+        return false;
+    }
+};
+
+int64_t fib(int n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+
+template<typename POOL>
+struct fib_task : task {
+    int n;
+    int64_t result = 0;
+
+    explicit fib_task(int n) : n(n) { this->run = &fib_task::compute; }
+
+    static void compute(task &self, void *pool_ptr, unsigned worker) {
+        auto &t = static_cast<fib_task &>(self);
+        if (t.n <= 12) {
+            t.result = fib(t.n);
+            return;
+        }
+        auto &pool = *static_cast<POOL *>(pool_ptr);
+        fib_task left(t.n - 1);
+        fib_task right(t.n - 2);
+        pool.spawn(left, worker);
+        compute(right, pool_ptr, worker);
+        pool.join(left, worker);
+        t.result = left.result + right.result;
+    }
+};
+
+struct tree_node {
+    tree_node *left;
+    tree_node *right;
+    int64_t value;
+};
+
+tree_node *build_tree(std::vector<tree_node> &nodes, size_t &next, int depth) {
+    tree_node *node = &nodes[next++];
+    node->value = static_cast<int64_t>(next % 1000);
+    node->left = depth > 1 ? build_tree(nodes, next, depth - 1) : nullptr;
+    node->right = depth > 1 ? build_tree(nodes, next, depth - 1) : nullptr;
+    return node;
+}
+
+int64_t tree_sum(const tree_node *node) {
+    return node ? node->value + tree_sum(node->left) + tree_sum(node->right) : 0;
+}
+
+template<typename POOL>
+struct tree_task : task {
+    const tree_node *node;
+    int depth;
+    int64_t result = 0;
+
+    tree_task(const tree_node *node, int depth) : node(node), depth(depth) { this->run = &tree_task::compute; }
+
+    static void compute(task &self, void *pool_ptr, unsigned worker) {
+        auto &t = static_cast<tree_task &>(self);
+        if (t.depth <= 6) {
+            t.result = tree_sum(t.node);
+            return;
+        }
+        auto &pool = *static_cast<POOL *>(pool_ptr);
+        tree_task left(t.node->left, t.depth - 1);
+        tree_task right(t.node->right, t.depth - 1);
+        pool.spawn(left, worker);
+        compute(right, pool_ptr, worker);
+        pool.join(left, worker);
+        t.result = t.node->value + left.result + right.result;
+    }
+};
+
+template<typename DEQUE>
+void run(const char *name, unsigned threads, int fib_n, const tree_node *root, int depth) {
+    using pool_type = fork_join_pool<DEQUE>;
+    char label[128];
+
+    fib_task<pool_type> fib_root(fib_n);
+    pool_type fib_pool(threads);
+    double ns = bench::measure([&] { fib_pool.run(fib_root); });
+    if (fib_root.result != fib(fib_n))
+        std::printf("wrong fib result\n");
+    // a task per call above the cutoff: fib(n - 10) - 1 of them.
+    std::snprintf(label, sizeof(label), "%s x%u fib(%d) (per task)", name, threads, fib_n);
+    bench::report(label, static_cast<size_t>(fib(fib_n - 10)), ns);
+
+    tree_task<pool_type> tree_root(root, depth);
+    pool_type tree_pool(threads);
+    ns = bench::measure([&] { tree_pool.run(tree_root); });
+    if (tree_root.result != tree_sum(root))
+        std::printf("wrong tree sum\n");
+    std::snprintf(label, sizeof(label), "%s x%u tree sum (per node)", name, threads);
+    bench::report(label, (size_t(1) << depth) - 1, ns);
+}
+
+// work_stealing_deque stores pointers as void *, like the locked list.
+struct lockfree_deque : rc::work_stealing_deque<void *> {};
+
+int main(int argc, char **argv) {
+    auto fib_n = static_cast<int>(bench::arg(argc, argv, 1, 34));
+    auto depth = static_cast<int>(bench::arg(argc, argv, 2, 22));
+    auto max_threads = static_cast<unsigned>(bench::arg(argc, argv, 3, std::thread::hardware_concurrency()));
+    if (max_threads == 0)
+        max_threads = 1;
+
+    std::vector<tree_node> nodes((size_t(1) << depth) - 1);
+    size_t next = 0;
+    const tree_node *root = build_tree(nodes, next, depth);
+
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        run<lockfree_deque>("work_stealing_deque", threads, fib_n, root, depth);
+        run<locked_list>("mutex + rc::list", threads, fib_n, root, depth);
+    }
+    return 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <functional>
+#include "Utility.h"
+
+namespace rc {
+
+    /**
+     * Branchless binary search: returns the first element in [first, last) that is not ordered before `value`.
+     *
+     * The range is halved at every step without any data dependent branch, the comparison result only selects
+     * the next base, so the compiler emits a conditional move and the loop never mispredicts.
+     *
+     * @tparam IT a random access iterator.
+     */
+    template<typename IT, typename T, typename Compare = std::less<>>
+    IT lower_bound(IT first, IT last, const T &value, Compare comp = Compare()) {
+        auto n = rc::distance(first, last);
+        if (n == 0)
+            return first;
+
+        while (n > 1) {
+            auto half = n / 2;
+            first += comp(first[half], value) ? half : 0;
+            n -= half;
+        }
+        return first + (comp(*first, value) ? 1 : 0);
+    }
+
+    /**
+     * Branchless binary search: returns the first element in [first, last) that is ordered after `value`.
+     */
+    template<typename IT, typename T, typename Compare = std::less<>>
+    IT upper_bound(IT first, IT last, const T &value, Compare comp = Compare()) {
+        auto n = rc::distance(first, last);
+        if (n == 0)
+            return first;
+
+        while (n > 1) {
+            auto half = n / 2;
+            first += comp(value, first[half]) ? 0 : half;
+            n -= half;
+        }
+        return first + (comp(value, *first) ? 0 : 1);
+    }
+}
@@ -5,6 +5,8 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <type_traits>
 
 namespace rc {
     template<typename T>
@@ -12,15 +14,23 @@ namespace rc {
     public:
         using value_type = T;
 
-        allocator() = default;
+        constexpr allocator() = default;
 
-        T *allocate(std::size_t n) {
+        constexpr T *allocate(std::size_t n) {
+            // ::operator new can't be called during constant evaluation: std::allocator is the only allocation
+            // allowed there (and must be freed before the evaluation ends).
+            if (std::is_constant_evaluated())
+                return std::allocator<T>().allocate(n);
             // Use ::operator new to allocate raw memory for 'n' elements of type 'T'.
             // Note that this raw memory allocation does NOT call the constructor of 'T'.
             return static_cast<T *>(::operator new(n * sizeof(T)));
         }
 
-        void deallocate(T *p, std::size_t n) {
+        constexpr void deallocate(T *p, std::size_t n) {
+            if (std::is_constant_evaluated()) {
+                std::allocator<T>().deallocate(p, n);
+                return;
+            }
             ::operator delete(p, n * sizeof(T));
         }
     };
@@ -25,74 +25,74 @@ namespace rc {
         constexpr size_t size() const;
 
         // access specified element
-        T &operator[](difference_type i);
+        constexpr T &operator[](difference_type i);
 
-        const T &operator[](difference_type i) const;
+        constexpr const T &operator[](difference_type i) const;
 
         // fill the container with specified value
-        void fill(T const &value);
+        constexpr void fill(T const &value);
 
         // access specified element with bounds checking
-        T &at(difference_type i);
+        constexpr T &at(difference_type i);
 
-        const T &at(difference_type i) const;
+        constexpr const T &at(difference_type i) const;
 
         // access the first and last elements
-        T &front();
+        constexpr T &front();
 
-        const T &front() const;
+        constexpr const T &front() const;
 
-        T &back();
+        constexpr T &back();
 
-        const T &back() const;
+        constexpr const T &back() const;
 
         // direct access to the underlying array
-        T *data();
+        constexpr T *data();
 
-        const T *data() const;
+        constexpr const T *data() const;
 
     public:
         // Iterators
 
-        iterator begin() { return iterator(_data); }
+        constexpr iterator begin() { return iterator(_data); }
 
-        const_iterator begin() const { return const_iterator(_data); }
+        constexpr const_iterator begin() const { return const_iterator(_data); }
 
-        const_iterator cbegin() const { return const_iterator(_data); }
+        constexpr const_iterator cbegin() const { return const_iterator(_data); }
 
 
-        iterator end() { return iterator(_data + SIZE); }
+        constexpr iterator end() { return iterator(_data + SIZE); }
 
-        const_iterator end() const { return const_iterator(_data + SIZE); }
+        constexpr const_iterator end() const { return const_iterator(_data + SIZE); }
 
-        const_iterator cend() const { return const_iterator(_data + SIZE); }
+        constexpr const_iterator cend() const { return const_iterator(_data + SIZE); }
 
 
-        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
 
-        const_reverse_iterator rbegin() const { return const_reverse_iterator(cend()); }
+        constexpr const_reverse_iterator rbegin() const { return const_reverse_iterator(cend()); }
 
-        const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+        constexpr const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
 
 
-        reverse_iterator rend() { return reverse_iterator(begin()); }
+        constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
 
-        const_reverse_iterator rend() const { return const_reverse_iterator(cbegin()); }
+        constexpr const_reverse_iterator rend() const { return const_reverse_iterator(cbegin()); }
 
-        const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+        constexpr const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
     };
 
 
     template<typename T, size_t SIZE>
     [[maybe_unused]]
-    void array<T, SIZE>::fill(const T &value) {
+    constexpr void array<T, SIZE>::fill(const T &value) {
         for (size_t i = 0; i < SIZE; ++i)
             _data[i] = value;
     }
 
     template<typename T, size_t SIZE>
     [[maybe_unused]]
-    const T &array<T, SIZE>::at(difference_type i) const {
+    constexpr const T &array<T, SIZE>::at(difference_type i) const {
         if (i >= SIZE)
             throw std::out_of_range("index out of bounds");
         return _data[i];
@@ -100,19 +100,19 @@ namespace rc {
 
     template<typename T, size_t SIZE>
     [[maybe_unused]]
-    T &array<T, SIZE>::at(difference_type i) {
+    constexpr T &array<T, SIZE>::at(difference_type i) {
         if (i >= SIZE)
             throw std::out_of_range("index out of bounds");
         return _data[i];
     }
 
     template<typename T, size_t SIZE>
-    T &array<T, SIZE>::front() {
+    constexpr T &array<T, SIZE>::front() {
         return _data[0];
     }
 
     template<typename T, size_t SIZE>
-    T &array<T, SIZE>::operator[](difference_type i) {
+    constexpr T &array<T, SIZE>::operator[](difference_type i) {
         return _data[i];
     }
 
@@ -122,32 +122,32 @@ namespace rc {
     }
 
     template<typename T, size_t SIZE>
-    const T &array<T, SIZE>::operator[](difference_type i) const {
+    constexpr const T &array<T, SIZE>::operator[](difference_type i) const {
         return _data[i];
     }
 
     template<typename T, size_t SIZE>
-    const T &array<T, SIZE>::front() const {
+    constexpr const T &array<T, SIZE>::front() const {
         return _data[0];
     }
 
     template<typename T, size_t SIZE>
-    const T *array<T, SIZE>::data() const {
+    constexpr const T *array<T, SIZE>::data() const {
         return _data;
     }
 
     template<typename T, size_t SIZE>
-    const T &array<T, SIZE>::back() const {
+    constexpr const T &array<T, SIZE>::back() const {
         return _data[SIZE - 1];
     }
 
     template<typename T, size_t SIZE>
-    T *array<T, SIZE>::data() {
+    constexpr T *array<T, SIZE>::data() {
         return _data;
     }
 
     template<typename T, size_t SIZE>
-    T &array<T, SIZE>::back() {
+    constexpr T &array<T, SIZE>::back() {
         return _data[SIZE - 1];
     }
 }
\ No newline at end of file
@@ -0,0 +1,1028 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "Allocator.h"
+#include "Utility.h"
+#include "Vector.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace rc {
+    // Keys per node: the keys of a node fill 4 cache lines (between 8 and 128 keys, a multiple of 4).
+    template<typename K>
+    inline constexpr size_t btree_node_slots =
+            4 * cache_line_size / sizeof(K) < 8 ? 8 :
+            4 * cache_line_size / sizeof(K) > 128 ? 128 : 4 * cache_line_size / sizeof(K) / 4 * 4;
+
+    struct btree_node_base {
+        uint32_t count = 0;
+    };
+
+    // Keys and values are stored in separate arrays (structure of arrays): a search only reads keys.
+    // Both arrays have a spare slot, so that a full node can take one more element before it is split.
+    template<typename K, typename V>
+    struct btree_leaf : btree_node_base {
+        static constexpr size_t slots = btree_node_slots<K>;
+
+        btree_leaf *prev = nullptr;
+        btree_leaf *next = nullptr;
+        alignas(K) unsigned char key_storage[(slots + 1) * sizeof(K)];
+        alignas(V) unsigned char value_storage[(slots + 1) * sizeof(V)];
+
+        K *keys() noexcept { return std::launder(reinterpret_cast<K *>(key_storage)); }
+
+        V *values() noexcept { return std::launder(reinterpret_cast<V *>(value_storage)); }
+    };
+
+    // children[i] holds the keys ordered before keys()[i], and not before keys()[i - 1].
+    template<typename K>
+    struct btree_inner : btree_node_base {
+        static constexpr size_t slots = btree_node_slots<K>;
+
+        alignas(K) unsigned char key_storage[(slots + 1) * sizeof(K)];
+        btree_node_base *children[slots + 2];
+
+        K *keys() noexcept { return std::launder(reinterpret_cast<K *>(key_storage)); }
+    };
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    class btree_map;
+
+    template<typename K, typename Compare, typename Alloc>
+    class btree_set;
+
+    /**
+     * Position in a leaf. Dereferencing it returns a pair of references (a proxy), like flat_map_iterator,
+     * since keys and values are stored apart.
+     *
+     * @tparam V is const for the const_iterator.
+     */
+    template<typename K, typename V>
+    class btree_map_iterator {
+        // btree_map<> must have access to the private members.
+        template<typename, typename, typename, typename>
+        friend
+        class btree_map;
+
+        template<typename, typename>
+        friend
+        class btree_map_iterator;
+
+    public:
+        using value_type = Pair<const K &, V &>;
+        using difference_type = ptrdiff_t;
+        using reference = value_type;
+        using iterator_category = bidirectional_iterator_tag;
+
+        // operator->() cannot return the address of a temporary pair, so it returns this holder instead.
+        struct pointer {
+            value_type pair;
+
+            value_type *operator->() { return &pair; }
+        };
+
+    private:
+        using _leaf = btree_leaf<K, std::remove_const_t<V>>;
+
+        _leaf *_node;
+        size_t _index;
+
+    public:
+        btree_map_iterator() : _node(nullptr), _index(0) {}
+
+        btree_map_iterator(_leaf *node, size_t index) : _node(node), _index(index) {}
+
+        // iterator -> const_iterator conversion
+        template<typename U>
+        btree_map_iterator(btree_map_iterator<K, U> const &other) : _node(other._node), _index(other._index) {}
+
+    public:
+        // POINTER
+        reference operator*() const { return {_node->keys()[_index], _node->values()[_index]}; }
+
+        pointer operator->() const { return {{_node->keys()[_index], _node->values()[_index]}}; }
+
+        // INCREMENT / DECREMENT
+        btree_map_iterator &operator++() {
+            // the end iterator is one past the last element of the last leaf.
+            if (++_index == _node->count && _node->next) {
+                _node = _node->next;
+                _index = 0;
+            }
+            return *this;
+        }
+
+        btree_map_iterator operator++(int) {
+            btree_map_iterator cpy(*this);
+            ++*this;
+            return cpy;
+        }
+
+        btree_map_iterator &operator--() {
+            if (_index == 0) {
+                _node = _node->prev;
+                _index = _node->count;
+            }
+            --_index;
+            return *this;
+        }
+
+        btree_map_iterator operator--(int) {
+            btree_map_iterator cpy(*this);
+            --*this;
+            return cpy;
+        }
+
+        // COMPARE
+        bool operator==(const btree_map_iterator &rhs) const { return _node == rhs._node && _index == rhs._index; }
+
+        bool operator!=(const btree_map_iterator &rhs) const { return !(*this == rhs); }
+    };
+
+    /**
+     * Ordered associative container, stored in a B+ tree: every element is in a leaf, the inner nodes only
+     * hold copies of keys to route the searches, and the leaves are chained for the range scans.
+     *
+     * A node holds btree_node_slots<K> keys (4 cache lines): a lookup reads a few contiguous nodes instead of
+     * one node per level of a binary tree. The search in a node is a linear scan, or, for integral keys
+     * ordered by std::less, a branchless count of the keys below the searched one (4 keys per SSE2 compare).
+     *
+     * Nodes are allocated with `Alloc`, rebound to the node types. Inserting or erasing invalidates the iterators.
+     */
+    template<typename K, typename V, typename Compare = std::less<K>, typename Alloc = rc::allocator<Pair<const K, V>>>
+    class btree_map {
+        template<typename, typename, typename>
+        friend
+        class btree_set;
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = Pair<K, V>;
+        using difference_type = ptrdiff_t;
+
+        using iterator = btree_map_iterator<K, V>;
+        using const_iterator = btree_map_iterator<K, const V>;
+
+        static constexpr size_t node_slots = btree_node_slots<K>;
+
+    private:
+        using _base = btree_node_base;
+        using _leaf = btree_leaf<K, V>;
+        using _inner = btree_inner<K>;
+        using _leaf_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_leaf>;
+        using _inner_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_inner>;
+
+        static constexpr bool _simd_search = std::is_integral_v<K> && std::is_same_v<Compare, std::less<K>>;
+        // fewest keys in a node other than the root
+        static constexpr size_t _min = node_slots / 2;
+        static constexpr size_t _max_height = 32;
+
+        // inner node visited by a descent, and the child taken.
+        struct _step {
+            _inner *node;
+            size_t child;
+        };
+
+        _base *_root = nullptr;
+        _leaf *_first = nullptr;
+        _leaf *_last = nullptr;
+        size_t _size = 0;
+        // number of inner levels
+        size_t _height = 0;
+        Compare _comp;
+
+    public:
+        btree_map() = default;
+
+        // Builds the map from an unsorted range, inserting each element.
+        btree_map(std::initializer_list<value_type> init);
+
+        btree_map(btree_map const &other);
+
+        btree_map(btree_map &&other) noexcept;
+
+        btree_map &operator=(btree_map const &other);
+
+        btree_map &operator=(btree_map &&other) noexcept;
+
+        ~btree_map() { clear(); }
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+        // number of levels, leaves included.
+        [[nodiscard]] size_t height() const noexcept { return _root ? _height + 1 : 0; }
+
+        //      LOOKUP
+
+        iterator find(const K &key);
+
+        const_iterator find(const K &key) const { return const_cast<btree_map *>(this)->find(key); }
+
+        bool contains(const K &key) const { return find(key) != end(); }
+
+        size_t count(const K &key) const { return contains(key); }
+
+        // first element whose key is not ordered before `key`
+        iterator lower_bound(const K &key);
+
+        const_iterator lower_bound(const K &key) const { return const_cast<btree_map *>(this)->lower_bound(key); }
+
+        // first element whose key is ordered after `key`
+        iterator upper_bound(const K &key);
+
+        const_iterator upper_bound(const K &key) const { return const_cast<btree_map *>(this)->upper_bound(key); }
+
+        // access specified element with bounds checking
+        V &at(const K &key);
+
+        const V &at(const K &key) const { return const_cast<btree_map *>(this)->at(key); }
+
+        // access or insert specified element
+        V &operator[](const K &key) { return try_emplace(key).first->second; }
+
+        //      MODIFIERS
+
+        // Inserts the element if the key is not already present.
+        Pair<iterator, bool> insert(const value_type &value) { return try_emplace(value.first, value.second); }
+
+        Pair<iterator, bool> insert(value_type &&value) {
+            return try_emplace(std::move(value.first), std::move(value.second));
+        }
+
+        // Constructs the value in-place if the key is not already present.
+        // If it throws, the map is unchanged (moving K and V must not throw).
+        template<typename KeyArg, typename... Args>
+        Pair<iterator, bool> try_emplace(KeyArg &&key, Args &&... args);
+
+        // Replaces the content with [first, last), which must be sorted by key without duplicates.
+        // The leaves are filled one after the other, then each level of inner nodes above them: O(n).
+        template<typename IT>
+        void bulk_load(IT first, IT last);
+
+        // Returns the iterator following the erased element.
+        iterator erase(const_iterator pos);
+
+        size_t erase(const K &key);
+
+        void clear() noexcept;
+
+        //      ITERATORS
+
+        iterator begin() noexcept { return iterator(_first, 0); }
+
+        const_iterator begin() const noexcept { return const_iterator(_first, 0); }
+
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        iterator end() noexcept { return iterator(_last, _last ? _last->count : 0); }
+
+        const_iterator end() const noexcept { return const_iterator(_last, _last ? _last->count : 0); }
+
+        const_iterator cend() const noexcept { return end(); }
+
+    private:
+        // number of keys of [keys, keys + count) ordered before `key`.
+        size_t _search(const K *keys, size_t count, const K &key) const;
+
+        // leaf where `key` is or would be. Fills `path` with the _height inner nodes visited, if not null.
+        _leaf *_descend(const K &key, _step *path) const;
+
+        // Inserts `separator` and the `right` node split off path[depth - 1].node's child, or grows a new root.
+        // A split or a new root takes the next node of `spares`, allocated beforehand.
+        void _insert_separator(_step *path, size_t depth, K &&separator, _base *right, _inner **spares);
+
+        void _erase_at(_leaf *leaf, size_t i, _step *path);
+
+        // Removes keys()[i] and children[i + 1] of path[depth - 1].node, then rebalances it.
+        void _erase_separator(_step *path, size_t depth, size_t i);
+
+        template<typename IT, typename Construct>
+        void _bulk_load(IT first, size_t count, Construct construct);
+
+        // moves [from, from + count) to `to`, which may overlap.
+        template<typename T>
+        static void _relocate(T *from, size_t count, T *to);
+
+        _leaf *_new_leaf();
+
+        _inner *_new_inner();
+
+        void _delete_leaf(_leaf *leaf) noexcept;
+
+        void _delete_inner(_inner *inner) noexcept;
+
+        void _destroy(_base *node, size_t level) noexcept;
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    btree_map<K, V, Compare, Alloc>::btree_map(std::initializer_list<value_type> init) {
+        for (auto &value: init)
+            insert(value);
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    btree_map<K, V, Compare, Alloc>::btree_map(btree_map const &other) : _comp(other._comp) {
+        bulk_load(other.begin(), other.end());
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    btree_map<K, V, Compare, Alloc>::btree_map(btree_map &&other) noexcept
+            : _root(other._root), _first(other._first), _last(other._last), _size(other._size),
+              _height(other._height), _comp(other._comp) {
+        other._root = nullptr;
+        other._first = other._last = nullptr;
+        other._size = 0;
+        other._height = 0;
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    btree_map<K, V, Compare, Alloc> &btree_map<K, V, Compare, Alloc>::operator=(btree_map const &other) {
+        if (this != &other) {
+            _comp = other._comp;
+            bulk_load(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    btree_map<K, V, Compare, Alloc> &btree_map<K, V, Compare, Alloc>::operator=(btree_map &&other) noexcept {
+        if (this != &other) {
+            clear();
+            std::swap(_root, other._root);
+            std::swap(_first, other._first);
+            std::swap(_last, other._last);
+            std::swap(_size, other._size);
+            std::swap(_height, other._height);
+            _comp = other._comp;
+        }
+        return *this;
+    }
+
+    //      LOOKUP
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    typename btree_map<K, V, Compare, Alloc>::iterator btree_map<K, V, Compare, Alloc>::find(const K &key) {
+        iterator it = lower_bound(key);
+        if (it == end() || _comp(key, it._node->keys()[it._index]))
+            return end();
+        return it;
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    typename btree_map<K, V, Compare, Alloc>::iterator btree_map<K, V, Compare, Alloc>::lower_bound(const K &key) {
+        if (!_root)
+            return end();
+        _leaf *leaf = _descend(key, nullptr);
+        size_t i = _search(leaf->keys(), leaf->count, key);
+        // every key of the next leaf is ordered after `key`.
+        if (i == leaf->count && leaf->next)
+            return iterator(leaf->next, 0);
+        return iterator(leaf, i);
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    typename btree_map<K, V, Compare, Alloc>::iterator btree_map<K, V, Compare, Alloc>::upper_bound(const K &key) {
+        iterator it = lower_bound(key);
+        if (it != end() && !_comp(key, it._node->keys()[it._index]))
+            ++it;
+        return it;
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    V &btree_map<K, V, Compare, Alloc>::at(const K &key) {
+        iterator it = find(key);
+        if (it == end())
+            throw std::out_of_range("key not found");
+        return it._node->values()[it._index];
+    }
+
+    //      MODIFIERS
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    template<typename KeyArg, typename... Args>
+    Pair<typename btree_map<K, V, Compare, Alloc>::iterator, bool>
+    btree_map<K, V, Compare, Alloc>::try_emplace(KeyArg &&key, Args &&... args) {
+        _step path[_max_height];
+        _leaf *leaf = nullptr;
+        size_t i = 0;
+        if (_root) {
+            leaf = _descend(key, path);
+            i = _search(leaf->keys(), leaf->count, key);
+            if (i < leaf->count && !_comp(key, leaf->keys()[i]))
+                return {iterator(leaf, i), false};
+        }
+
+        // whatever may throw is done before the first element moves: the new element, the nodes of a split and
+        // the separator copied to the parent. A throw then leaves the map unchanged.
+        K new_key(std::forward<KeyArg>(key));
+        V new_value(std::forward<Args>(args)...);
+        if (!_root)
+            _root = _first = _last = leaf = _new_leaf();
+        size_t count = leaf->count;
+        _leaf *right = nullptr;
+        // new inner nodes, from the leaf's parent up
+        _inner *spares[_max_height + 1];
+        size_t spare_count = 0;
+        std::optional<K> separator;
+        if (count == node_slots) {
+            right = _new_leaf();
+            try {
+                // a node for each full inner node above the leaf, and a new root if they are all full.
+                size_t depth = _height;
+                while (depth > 0 && path[depth - 1].node->count == node_slots) {
+                    spares[spare_count++] = _new_inner();
+                    --depth;
+                }
+                if (depth == 0)
+                    spares[spare_count++] = _new_inner();
+                // the first key of the right leaf, once the new element is in.
+                size_t half = (count + 1) / 2;
+                separator.emplace(i == half ? new_key : leaf->keys()[i < half ? half - 1 : half]);
+            } catch (...) {
+                while (spare_count > 0)
+                    _delete_inner(spares[--spare_count]);
+                _delete_leaf(right);
+                throw;
+            }
+        }
+
+        // the spare slot takes the new element, then a full leaf is split in two.
+        _relocate(leaf->keys() + i, count - i, leaf->keys() + i + 1);
+        _relocate(leaf->values() + i, count - i, leaf->values() + i + 1);
+        std::construct_at(leaf->keys() + i, std::move(new_key));
+        std::construct_at(leaf->values() + i, std::move(new_value));
+        leaf->count = ++count;
+        ++_size;
+        if (!right)
+            return {iterator(leaf, i), true};
+
+        size_t half = count / 2;
+        _relocate(leaf->keys() + half, count - half, right->keys());
+        _relocate(leaf->values() + half, count - half, right->values());
+        leaf->count = half;
+        right->count = count - half;
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next)
+            leaf->next->prev = right;
+        else
+            _last = right;
+        leaf->next = right;
+        _insert_separator(path, _height, std::move(*separator), right, spares);
+        return i < half ? Pair<iterator, bool>{iterator(leaf, i), true} : Pair<iterator, bool>{iterator(right, i - half), true};
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    template<typename IT>
+    void btree_map<K, V, Compare, Alloc>::bulk_load(IT first, IT last) {
+        size_t count = rc::distance(first, last);
+        _bulk_load(first, count, [](K *key, V *value, auto &&element) {
+            std::construct_at(key, element.first);
+            std::construct_at(value, element.second);
+        });
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    typename btree_map<K, V, Compare, Alloc>::iterator btree_map<K, V, Compare, Alloc>::erase(const_iterator pos) {
+        // the erase may move the following element to another leaf: it is found again by key.
+        K key = pos._node->keys()[pos._index];
+        erase(key);
+        return lower_bound(key);
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    size_t btree_map<K, V, Compare, Alloc>::erase(const K &key) {
+        if (!_root)
+            return 0;
+        _step path[_max_height];
+        _leaf *leaf = _descend(key, path);
+        size_t i = _search(leaf->keys(), leaf->count, key);
+        if (i == leaf->count || _comp(key, leaf->keys()[i]))
+            return 0;
+        _erase_at(leaf, i, path);
+        return 1;
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    void btree_map<K, V, Compare, Alloc>::clear() noexcept {
+        if (_root)
+            _destroy(_root, 0);
+        _root = nullptr;
+        _first = _last = nullptr;
+        _size = 0;
+        _height = 0;
+    }
+
+    //      PRIVATE
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    size_t btree_map<K, V, Compare, Alloc>::_search(const K *keys, size_t count, const K &key) const {
+        if constexpr (_simd_search) {
+#if defined(__SSE2__)
+            if constexpr (sizeof(K) == 4) {
+                // unsigned keys are shifted to the signed range, for the signed comparison.
+                const __m128i flip = _mm_set1_epi32(std::is_signed_v<K> ? 0 : INT32_MIN);
+                const __m128i needle = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(key)), flip);
+                size_t below = 0;
+                // the slots past `count` are read too (nodes hold a multiple of 4 keys), then masked out.
+                for (size_t i = 0; i < count; i += 4) {
+                    __m128i group = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), flip);
+                    unsigned mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(needle, group)));
+                    if (count - i < 4)
+                        mask &= (1u << (count - i)) - 1;
+                    below += std::popcount(mask);
+                    // the keys are sorted: once a key is not below, none of the next ones is.
+                    if (mask != 0xF)
+                        break;
+                }
+                return below;
+            }
+#endif
+            size_t below = 0;
+            for (size_t i = 0; i < count; ++i)
+                below += keys[i] < key;
+            return below;
+        } else {
+            size_t i = 0;
+            while (i < count && _comp(keys[i], key))
+                ++i;
+            return i;
+        }
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    typename btree_map<K, V, Compare, Alloc>::_leaf *
+    btree_map<K, V, Compare, Alloc>::_descend(const K &key, _step *path) const {
+        _base *node = _root;
+        for (size_t depth = 0; depth < _height; ++depth) {
+            auto *inner = static_cast<_inner *>(node);
+            size_t child = _search(inner->keys(), inner->count, key);
+            // a key equal to a separator is in the subtree at its right.
+            if (child < inner->count && !_comp(key, inner->keys()[child]))
+                ++child;
+            if (path)
+                path[depth] = {inner, child};
+            node = inner->children[child];
+        }
+        return static_cast<_leaf *>(node);
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    void btree_map<K, V, Compare, Alloc>::_insert_separator(_step *path, size_t depth, K &&separator, _base *right,
+                                                            _inner **spares) {
+        if (depth == 0) {
+            _inner *root = *spares;
+            std::construct_at(root->keys(), std::move(separator));
+            root->children[0] = _root;
+            root->children[1] = right;
+            root->count = 1;
+            _root = root;
+            ++_height;
+            return;
+        }
+        _inner *node = path[depth - 1].node;
+        size_t i = path[depth - 1].child;
+        size_t count = node->count;
+        _relocate(node->keys() + i, count - i, node->keys() + i + 1);
+        std::memmove(node->children + i + 2, node->children + i + 1, (count - i) * sizeof(_base *));
+        std::construct_at(node->keys() + i, std::move(separator));
+        node->children[i + 1] = right;
+        node->count = ++count;
+        if (count <= node_slots)
+            return;
+
+        // the middle key moves up, the keys after it go to the new node.
+        _inner *split = *spares;
+        size_t half = count / 2;
+        K middle = std::move(node->keys()[half]);
+        std::destroy_at(node->keys() + half);
+        _relocate(node->keys() + half + 1, count - half - 1, split->keys());
+        std::memcpy(split->children, node->children + half + 1, (count - half) * sizeof(_base *));
+        node->count = half;
+        split->count = count - half - 1;
+        _insert_separator(path, depth - 1, std::move(middle), split, spares + 1);
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    void btree_map<K, V, Compare, Alloc>::_erase_at(_leaf *leaf, size_t i, _step *path) {
+        std::destroy_at(leaf->keys() + i);
+        std::destroy_at(leaf->values() + i);
+        size_t count = leaf->count;
+        _relocate(leaf->keys() + i + 1, count - i - 1, leaf->keys() + i);
+        _relocate(leaf->values() + i + 1, count - i - 1, leaf->values() + i);
+        leaf->count = --count;
+        --_size;
+
+        if (_height == 0) {
+            if (count == 0) {
+                _delete_leaf(leaf);
+                _root = nullptr;
+                _first = _last = nullptr;
+            }
+            return;
+        }
+        if (count >= _min)
+            return;
+
+        // borrows an element from a sibling, or merges with it.
+        _inner *parent = path[_height - 1].node;
+        size_t child = path[_height - 1].child;
+        if (child > 0) {
+            auto *left = static_cast<_leaf *>(parent->children[child - 1]);
+            if (left->count > _min) {
+                size_t last = left->count - 1;
+                _relocate(leaf->keys(), count, leaf->keys() + 1);
+                _relocate(leaf->values(), count, leaf->values() + 1);
+                _relocate(left->keys() + last, 1, leaf->keys());
+                _relocate(left->values() + last, 1, leaf->values());
+                left->count = last;
+                leaf->count = count + 1;
+                parent->keys()[child - 1] = leaf->keys()[0];
+                return;
+            }
+            _relocate(leaf->keys(), count, left->keys() + left->count);
+            _relocate(leaf->values(), count, left->values() + left->count);
+            left->count += count;
+            left->next = leaf->next;
+            if (leaf->next)
+                leaf->next->prev = left;
+            else
+                _last = left;
+            _delete_leaf(leaf);
+            _erase_separator(path, _height, child - 1);
+        } else {
+            auto *right = static_cast<_leaf *>(parent->children[1]);
+            if (right->count > _min) {
+                _relocate(right->keys(), 1, leaf->keys() + count);
+                _relocate(right->values(), 1, leaf->values() + count);
+                _relocate(right->keys() + 1, right->count - 1, right->keys());
+                _relocate(right->values() + 1, right->count - 1, right->values());
+                --right->count;
+                leaf->count = count + 1;
+                parent->keys()[0] = right->keys()[0];
+                return;
+            }
+            _relocate(right->keys(), right->count, leaf->keys() + count);
+            _relocate(right->values(), right->count, leaf->values() + count);
+            leaf->count += right->count;
+            leaf->next = right->next;
+            if (right->next)
+                right->next->prev = leaf;
+            else
+                _last = leaf;
+            _delete_leaf(right);
+            _erase_separator(path, _height, 0);
+        }
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    void btree_map<K, V, Compare, Alloc>::_erase_separator(_step *path, size_t depth, size_t i) {
+        _inner *node = path[depth - 1].node;
+        size_t count = node->count;
+        std::destroy_at(node->keys() + i);
+        _relocate(node->keys() + i + 1, count - i - 1, node->keys() + i);
+        std::memmove(node->children + i + 1, node->children + i + 2, (count - i - 1) * sizeof(_base *));
+        node->count = --count;
+
+        if (depth == 1) {
+            // a root left with a single child is replaced by it.
+            if (count == 0) {
+                _root = node->children[0];
+                _delete_inner(node);
+                --_height;
+            }
+            return;
+        }
+        if (count >= _min)
+            return;
+
+        // rotates a key through the parent from a sibling, or merges with it around the parent's key.
+        _inner *parent = path[depth - 2].node;
+        size_t child = path[depth - 2].child;
+        if (child > 0) {
+            auto *left = static_cast<_inner *>(parent->children[child - 1]);
+            size_t left_count = left->count;
+            if (left_count > _min) {
+                _relocate(node->keys(), count, node->keys() + 1);
+                std::memmove(node->children + 1, node->children, (count + 1) * sizeof(_base *));
+                std::construct_at(node->keys(), std::move(parent->keys()[child - 1]));
+                node->children[0] = left->children[left_count];
+                parent->keys()[child - 1] = std::move(left->keys()[left_count - 1]);
+                std::destroy_at(left->keys() + left_count - 1);
+                left->count = left_count - 1;
+                node->count = count + 1;
+                return;
+            }
+            std::construct_at(left->keys() + left_count, std::move(parent->keys()[child - 1]));
+            _relocate(node->keys(), count, left->keys() + left_count + 1);
+            std::memcpy(left->children + left_count + 1, node->children, (count + 1) * sizeof(_base *));
+            left->count = left_count + 1 + count;
+            _delete_inner(node);
+            _erase_separator(path, depth - 1, child - 1);
+        } else {
+            auto *right = static_cast<_inner *>(parent->children[1]);
+            size_t right_count = right->count;
+            if (right_count > _min) {
+                std::construct_at(node->keys() + count, std::move(parent->keys()[0]));
+                node->children[count + 1] = right->children[0];
+                parent->keys()[0] = std::move(right->keys()[0]);
+                std::destroy_at(right->keys());
+                _relocate(right->keys() + 1, right_count - 1, right->keys());
+                std::memmove(right->children, right->children + 1, right_count * sizeof(_base *));
+                right->count = right_count - 1;
+                node->count = count + 1;
+                return;
+            }
+            std::construct_at(node->keys() + count, std::move(parent->keys()[0]));
+            _relocate(right->keys(), right_count, node->keys() + count + 1);
+            std::memcpy(node->children + count + 1, right->children, (right_count + 1) * sizeof(_base *));
+            node->count = count + 1 + right_count;
+            _delete_inner(right);
+            _erase_separator(path, depth - 1, 0);
+        }
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    template<typename IT, typename Construct>
+    void btree_map<K, V, Compare, Alloc>::_bulk_load(IT first, size_t count, Construct construct) {
+        clear();
+        if (count == 0)
+            return;
+
+        // leaves as full as possible, their sizes spread evenly: each one gets at least half of the slots.
+        size_t leaf_count = (count + node_slots - 1) / node_slots;
+        rc::vector<_base *> level;
+        rc::vector<const K *> lowest; // smallest key under each node of the level
+        level.reserve(leaf_count);
+        lowest.reserve(leaf_count);
+        _leaf *previous = nullptr;
+        for (size_t l = 0; l < leaf_count; ++l) {
+            _leaf *leaf = _new_leaf();
+            size_t n = count / leaf_count + (l < count % leaf_count);
+            for (size_t i = 0; i < n; ++i, ++first)
+                construct(leaf->keys() + i, leaf->values() + i, *first);
+            leaf->count = n;
+            leaf->prev = previous;
+            if (previous)
+                previous->next = leaf;
+            else
+                _first = leaf;
+            previous = leaf;
+            level.push_back(leaf);
+            lowest.push_back(leaf->keys());
+        }
+        _last = previous;
+        _size = count;
+
+        while (level.size() > 1) {
+            size_t inner_count = (level.size() + node_slots) / (node_slots + 1);
+            rc::vector<_base *> parents;
+            rc::vector<const K *> parent_lowest;
+            parents.reserve(inner_count);
+            parent_lowest.reserve(inner_count);
+            size_t next = 0;
+            for (size_t p = 0; p < inner_count; ++p) {
+                _inner *inner = _new_inner();
+                size_t children = level.size() / inner_count + (p < level.size() % inner_count);
+                for (size_t c = 0; c < children; ++c) {
+                    inner->children[c] = level[next + c];
+                    if (c > 0)
+                        std::construct_at(inner->keys() + c - 1, *lowest[next + c]);
+                }
+                inner->count = children - 1;
+                parents.push_back(inner);
+                parent_lowest.push_back(lowest[next]);
+                next += children;
+            }
+            level = std::move(parents);
+            lowest = std::move(parent_lowest);
+            ++_height;
+        }
+        _root = level[0];
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    template<typename T>
+    void btree_map<K, V, Compare, Alloc>::_relocate(T *from, size_t count, T *to) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count)
+                std::memmove(static_cast<void *>(to), from, count * sizeof(T));
+        } else if (to < from) {
+            for (size_t i = 0; i < count; ++i) {
+                std::construct_at(to + i, std::move(from[i]));
+                std::destroy_at(from + i);
+            }
+        } else {
+            for (size_t i = count; i-- > 0;) {
+                std::construct_at(to + i, std::move(from[i]));
+                std::destroy_at(from + i);
+            }
+        }
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    typename btree_map<K, V, Compare, Alloc>::_leaf *btree_map<K, V, Compare, Alloc>::_new_leaf() {
+        _leaf_alloc alloc;
+        // value initialized, so zeroed: the SIMD search reads whole groups of 4 keys, unused slots included.
+        return std::construct_at(alloc.allocate(1));
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    typename btree_map<K, V, Compare, Alloc>::_inner *btree_map<K, V, Compare, Alloc>::_new_inner() {
+        _inner_alloc alloc;
+        return std::construct_at(alloc.allocate(1));
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    void btree_map<K, V, Compare, Alloc>::_delete_leaf(_leaf *leaf) noexcept {
+        _leaf_alloc alloc;
+        std::destroy_at(leaf);
+        alloc.deallocate(leaf, 1);
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    void btree_map<K, V, Compare, Alloc>::_delete_inner(_inner *inner) noexcept {
+        _inner_alloc alloc;
+        std::destroy_at(inner);
+        alloc.deallocate(inner, 1);
+    }
+
+    template<typename K, typename V, typename Compare, typename Alloc>
+    void btree_map<K, V, Compare, Alloc>::_destroy(_base *node, size_t level) noexcept {
+        if (level == _height) {
+            auto *leaf = static_cast<_leaf *>(node);
+            std::destroy(leaf->keys(), leaf->keys() + leaf->count);
+            std::destroy(leaf->values(), leaf->values() + leaf->count);
+            _delete_leaf(leaf);
+            return;
+        }
+        auto *inner = static_cast<_inner *>(node);
+        for (size_t i = 0; i <= inner->count; ++i)
+            _destroy(inner->children[i], level + 1);
+        std::destroy(inner->keys(), inner->keys() + inner->count);
+        _delete_inner(inner);
+    }
+
+    /**
+     * Iterator over the keys of a btree_set: a btree_map const_iterator returning the key only.
+     */
+    template<typename MapIterator, typename K>
+    class btree_set_iterator {
+        template<typename, typename, typename>
+        friend
+        class btree_set;
+
+    public:
+        using value_type = K;
+        using difference_type = ptrdiff_t;
+        using pointer = const K *;
+        using reference = const K &;
+        using iterator_category = bidirectional_iterator_tag;
+
+    private:
+        MapIterator _it;
+
+    public:
+        btree_set_iterator() = default;
+
+        explicit btree_set_iterator(MapIterator it) : _it(it) {}
+
+        reference operator*() const { return (*_it).first; }
+
+        pointer operator->() const { return &(*_it).first; }
+
+        btree_set_iterator &operator++() {
+            ++_it;
+            return *this;
+        }
+
+        btree_set_iterator operator++(int) { return btree_set_iterator(_it++); }
+
+        btree_set_iterator &operator--() {
+            --_it;
+            return *this;
+        }
+
+        btree_set_iterator operator--(int) { return btree_set_iterator(_it--); }
+
+        bool operator==(const btree_set_iterator &rhs) const { return _it == rhs._it; }
+
+        bool operator!=(const btree_set_iterator &rhs) const { return _it != rhs._it; }
+    };
+
+    /**
+     * Ordered set of unique keys, stored in the leaves of a btree_map without values.
+     */
+    template<typename K, typename Compare = std::less<K>, typename Alloc = rc::allocator<K>>
+    class btree_set {
+        struct _empty {
+        };
+
+        using _map = btree_map<K, _empty, Compare,
+                typename std::allocator_traits<Alloc>::template rebind_alloc<Pair<const K, _empty>>>;
+
+    public:
+        using key_type = K;
+        using value_type = K;
+        using difference_type = ptrdiff_t;
+
+        // keys must stay sorted, so they are never exposed as mutable.
+        using iterator = btree_set_iterator<typename _map::const_iterator, K>;
+        using const_iterator = iterator;
+
+    private:
+        _map _tree;
+
+    public:
+        btree_set() = default;
+
+        btree_set(std::initializer_list<K> init) {
+            for (auto &key: init)
+                insert(key);
+        }
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _tree.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return _tree.empty(); }
+
+        [[nodiscard]] size_t height() const noexcept { return _tree.height(); }
+
+        //      LOOKUP
+
+        const_iterator find(const K &key) const { return const_iterator(_tree.find(key)); }
+
+        bool contains(const K &key) const { return _tree.contains(key); }
+
+        size_t count(const K &key) const { return _tree.count(key); }
+
+        // first key not ordered before `key`
+        const_iterator lower_bound(const K &key) const { return const_iterator(_tree.lower_bound(key)); }
+
+        // first key ordered after `key`
+        const_iterator upper_bound(const K &key) const { return const_iterator(_tree.upper_bound(key)); }
+
+        //      MODIFIERS
+
+        Pair<iterator, bool> insert(const K &key) {
+            auto result = _tree.try_emplace(key);
+            return {iterator(result.first), result.second};
+        }
+
+        Pair<iterator, bool> insert(K &&key) {
+            auto result = _tree.try_emplace(std::move(key));
+            return {iterator(result.first), result.second};
+        }
+
+        // Replaces the content with [first, last), which must be sorted without duplicates.
+        template<typename IT>
+        void bulk_load(IT first, IT last) {
+            _tree._bulk_load(first, rc::distance(first, last), [](K *key, _empty *value, const K &element) {
+                std::construct_at(key, element);
+                std::construct_at(value);
+            });
+        }
+
+        // Returns the iterator following the erased key.
+        iterator erase(const_iterator pos) { return iterator(_tree.erase(pos._it)); }
+
+        size_t erase(const K &key) { return _tree.erase(key); }
+
+        void clear() noexcept { _tree.clear(); }
+
+        //      ITERATORS
+
+        const_iterator begin() const noexcept { return const_iterator(_tree.begin()); }
+
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        const_iterator end() const noexcept { return const_iterator(_tree.end()); }
+
+        const_iterator cend() const noexcept { return end(); }
+    };
+}
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "Utility.h"
+#include "Vector.h"
+
+namespace rc {
+    /**
+     * Read-only search index over a sorted range, laid out for the cache rather than in sorted order.
+     *
+     * The classic layout is the Eytzinger (BFS) order of the implicit search tree: the children of slot k are
+     * 2k and 2k + 1, so the next levels of a lookup are close to each other, and the 16 grand-grand-children of a
+     * slot share a cache line, fetched ahead while the current comparisons run. The descent has no branch
+     * to mispredict: the comparison result is the next index.
+     *
+     * The blocked layout (Blocked = true, arithmetic keys) packs one cache line of keys per node of a B-ary
+     * tree (a static B-tree), so that a lookup touches log_B+1(n) lines instead of log_2(n). Its levels can't be
+     * prefetched though: it reads less memory, but the classic layout usually has the lower latency.
+     *
+     * Lookups return the position of the key in the original sorted range.
+     */
+    template<typename T, typename Compare = std::less<T>, bool Blocked = false>
+    class eytzinger_index {
+        static_assert(!Blocked || std::is_arithmetic_v<T>, "the blocked layout pads its nodes with the largest T");
+        // the padding must sort after every key.
+        static_assert(!Blocked || std::is_same_v<Compare, std::less<T>>, "the blocked layout needs std::less");
+
+    public:
+        using value_type = T;
+
+        // keys per node: a whole cache line in the blocked layout.
+        static constexpr size_t block_keys = Blocked ? cache_line_size / sizeof(T) : 1;
+
+    private:
+        static constexpr size_t _npos = static_cast<size_t>(-1);
+
+        // cache line aligned. Classic layout: slots 1 to _size (slot 0 is unused, so that the children of k are
+        // 2k and 2k + 1). Blocked layout: _block_count nodes of block_keys slots, padded with the largest T.
+        T *_slots = nullptr;
+        size_t _slot_count = 0;
+        size_t _size = 0;
+        size_t _block_count = 0;
+        // original position of the key of each slot (_size for padding).
+        vector<size_t> _positions;
+        Compare _comp;
+
+    public:
+        eytzinger_index() = default;
+
+        // [first, last) must be sorted according to `comp`.
+        template<typename IT>
+        eytzinger_index(IT first, IT last, Compare comp = Compare());
+
+        explicit eytzinger_index(vector<T> const &sorted, Compare comp = Compare())
+                : eytzinger_index(sorted.begin(), sorted.end(), comp) {}
+
+        eytzinger_index(eytzinger_index const &other) = delete;
+
+        eytzinger_index(eytzinger_index &&other) noexcept;
+
+        eytzinger_index &operator=(eytzinger_index const &other) = delete;
+
+        eytzinger_index &operator=(eytzinger_index &&other) noexcept;
+
+        ~eytzinger_index();
+
+    public:
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+        // Position of the first key not less than `key` in the sorted range, or size().
+        size_t lower_bound(const T &key) const {
+            size_t slot = _search(key);
+            return slot == _npos ? _size : _positions[slot];
+        }
+
+        bool contains(const T &key) const { return find(key) != _size; }
+
+        // Position of `key` in the sorted range, or size().
+        size_t find(const T &key) const {
+            size_t slot = _search(key);
+            // a padding slot holds the largest T, but no key.
+            return slot != _npos && _positions[slot] != _size && !_comp(key, _slots[slot]) ? _positions[slot] : _size;
+        }
+
+    private:
+        // slot of the first key not less than `key`, or _npos.
+        size_t _search(const T &key) const;
+
+        // fills the subtree rooted at `k` in order, from `first`.
+        template<typename IT>
+        void _build(IT &first, size_t &position, size_t k);
+
+        void _release() noexcept;
+    };
+
+    template<typename T, typename Compare = std::less<T>>
+    using blocked_eytzinger_index = eytzinger_index<T, Compare, true>;
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, typename Compare, bool Blocked>
+    template<typename IT>
+    eytzinger_index<T, Compare, Blocked>::eytzinger_index(IT first, IT last, Compare comp) : _comp(comp) {
+        _size = rc::distance(first, last);
+        if (_size == 0)
+            return;
+        if constexpr (Blocked) {
+            _block_count = (_size + block_keys - 1) / block_keys;
+            _slot_count = _block_count * block_keys;
+        } else {
+            _slot_count = _size + 1;
+        }
+
+        _slots = static_cast<T *>(::operator new(_slot_count * sizeof(T), std::align_val_t(cache_line_size)));
+        _positions.resize(_slot_count, _size);
+        size_t position = 0;
+        if constexpr (Blocked) {
+            for (size_t i = 0; i < _slot_count; ++i)
+                _slots[i] = std::numeric_limits<T>::max();
+            _build(first, position, 0);
+        } else {
+            // slot 0 is never read, but is constructed like the others to be destroyed with them.
+            std::construct_at(_slots, *first);
+            _build(first, position, 1);
+        }
+    }
+
+    template<typename T, typename Compare, bool Blocked>
+    eytzinger_index<T, Compare, Blocked>::eytzinger_index(eytzinger_index &&other) noexcept
+            : _slots(other._slots), _slot_count(other._slot_count), _size(other._size),
+              _block_count(other._block_count), _positions(std::move(other._positions)), _comp(other._comp) {
+        other._slots = nullptr;
+        other._slot_count = 0;
+        other._size = 0;
+        other._block_count = 0;
+    }
+
+    template<typename T, typename Compare, bool Blocked>
+    eytzinger_index<T, Compare, Blocked> &eytzinger_index<T, Compare, Blocked>::operator=(eytzinger_index &&other) noexcept {
+        if (this != &other) {
+            _release();
+            _slots = other._slots;
+            _slot_count = other._slot_count;
+            _size = other._size;
+            _block_count = other._block_count;
+            _positions = std::move(other._positions);
+            _comp = other._comp;
+            other._slots = nullptr;
+            other._slot_count = 0;
+            other._size = 0;
+            other._block_count = 0;
+        }
+        return *this;
+    }
+
+    template<typename T, typename Compare, bool Blocked>
+    eytzinger_index<T, Compare, Blocked>::~eytzinger_index() {
+        _release();
+    }
+
+    //      PRIVATE
+
+    template<typename T, typename Compare, bool Blocked>
+    size_t eytzinger_index<T, Compare, Blocked>::_search(const T &key) const {
+        if constexpr (Blocked) {
+            size_t found = _npos;
+            size_t k = 0;
+            while (k < _block_count) {
+                const T *node = _slots + k * block_keys;
+                // number of keys of the node less than `key`: a fixed size loop the compiler vectorizes.
+                size_t i = 0;
+                for (size_t j = 0; j < block_keys; ++j)
+                    i += _comp(node[j], key);
+                found = i < block_keys ? k * block_keys + i : found;
+                k = k * (block_keys + 1) + i + 1;
+            }
+            return found;
+        } else {
+            // 4 levels below k, the 16 descendants of k are in one cache line (for 4 byte keys).
+            constexpr size_t ahead = cache_line_size / sizeof(T) ? cache_line_size / sizeof(T) : 1;
+            size_t k = 1;
+            while (k <= _size) {
+                __builtin_prefetch(_slots + k * ahead);
+                k = 2 * k + _comp(_slots[k], key);
+            }
+            // k went right after its last left turn: cancel the right turns, then the left one.
+            k >>= __builtin_ffsll(static_cast<long long>(~k));
+            return k == 0 ? _npos : k;
+        }
+    }
+
+    template<typename T, typename Compare, bool Blocked>
+    template<typename IT>
+    void eytzinger_index<T, Compare, Blocked>::_build(IT &first, size_t &position, size_t k) {
+        if constexpr (Blocked) {
+            if (k >= _block_count)
+                return;
+            for (size_t i = 0; i < block_keys; ++i) {
+                _build(first, position, k * (block_keys + 1) + i + 1);
+                if (position < _size) {
+                    _slots[k * block_keys + i] = *first;
+                    ++first;
+                    _positions[k * block_keys + i] = position++;
+                }
+            }
+            _build(first, position, k * (block_keys + 1) + block_keys + 1);
+        } else {
+            if (k > _size)
+                return;
+            _build(first, position, 2 * k);
+            std::construct_at(_slots + k, *first);
+            ++first;
+            _positions[k] = position++;
+            _build(first, position, 2 * k + 1);
+        }
+    }
+
+    template<typename T, typename Compare, bool Blocked>
+    void eytzinger_index<T, Compare, Blocked>::_release() noexcept {
+        if (!_slots)
+            return;
+        if constexpr (!Blocked) {
+            for (size_t i = 0; i < _slot_count; ++i)
+                std::destroy_at(_slots + i);
+        }
+        ::operator delete(_slots, _slot_count * sizeof(T), std::align_val_t(cache_line_size));
+        _slots = nullptr;
+    }
+}
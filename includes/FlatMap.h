@@ -0,0 +1,481 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <stdexcept>
+#include <functional>
+#include <algorithm>
+#include "Vector.h"
+#include "Algorithm.h"
+#include "Utility.h"
+
+namespace rc {
+    template<typename K, typename V, typename Compare>
+    class flat_map;
+
+    /**
+     * Keys and values are stored in two separated arrays, so dereferencing the iterator
+     * returns a pair of references (a proxy) instead of a reference to a stored pair.
+     *
+     * @tparam V is const for the const_iterator.
+     */
+    template<typename K, typename V>
+    class flat_map_iterator {
+        // flat_map<> must have access to the private pointers.
+        template<typename, typename, typename>
+        friend
+        class flat_map;
+
+        template<typename, typename>
+        friend
+        class flat_map_iterator;
+
+    public:
+        using value_type = Pair<const K &, V &>;
+        using difference_type = ptrdiff_t;
+        using reference = value_type;
+        using iterator_category = random_access_iterator_tag;
+
+        // operator->() cannot return the address of a temporary pair, so it returns this holder instead.
+        struct pointer {
+            value_type pair;
+
+            value_type *operator->() { return &pair; }
+        };
+
+    private:
+        const K *_key;
+        V *_value;
+
+    public:
+        flat_map_iterator() : _key(nullptr), _value(nullptr) {}
+
+        flat_map_iterator(const K *key, V *value) : _key(key), _value(value) {}
+
+        // iterator -> const_iterator conversion
+        template<typename U>
+        flat_map_iterator(flat_map_iterator<K, U> const &other) : _key(other._key), _value(other._value) {}
+
+        flat_map_iterator(flat_map_iterator const &other) = default;
+
+        flat_map_iterator &operator=(flat_map_iterator const &other) = default;
+
+        ~flat_map_iterator() = default;
+
+    public:
+        // POINTER
+        reference operator*() const { return {*_key, *_value}; }
+
+        pointer operator->() const { return {{*_key, *_value}}; }
+
+        // INCREMENT / DECREMENT
+        flat_map_iterator &operator++() {
+            ++_key;
+            ++_value;
+            return *this;
+        }
+
+        flat_map_iterator operator++(int) {
+            flat_map_iterator cpy(*this);
+            ++*this;
+            return cpy;
+        }
+
+        flat_map_iterator &operator--() {
+            --_key;
+            --_value;
+            return *this;
+        }
+
+        flat_map_iterator operator--(int) {
+            flat_map_iterator cpy(*this);
+            --*this;
+            return cpy;
+        }
+
+        flat_map_iterator &operator+=(const difference_type i) {
+            _key += i;
+            _value += i;
+            return *this;
+        }
+
+        flat_map_iterator &operator-=(const difference_type i) {
+            _key -= i;
+            _value -= i;
+            return *this;
+        }
+
+        // ARITHMETIC
+        flat_map_iterator operator+(const difference_type i) const { return flat_map_iterator(_key + i, _value + i); }
+
+        flat_map_iterator operator-(const difference_type i) const { return flat_map_iterator(_key - i, _value - i); }
+
+        difference_type operator-(const flat_map_iterator &rhs) const { return _key - rhs._key; }
+
+        // ACCESS
+        reference operator[](difference_type i) const { return {_key[i], _value[i]}; }
+
+        // COMPARE
+        bool operator==(const flat_map_iterator &rhs) const { return this->_key == rhs._key; }
+
+        bool operator!=(const flat_map_iterator &rhs) const { return this->_key != rhs._key; }
+
+        bool operator<(const flat_map_iterator &rhs) const { return this->_key < rhs._key; }
+
+        bool operator<=(const flat_map_iterator &rhs) const { return this->_key <= rhs._key; }
+
+        bool operator>(const flat_map_iterator &rhs) const { return this->_key > rhs._key; }
+
+        bool operator>=(const flat_map_iterator &rhs) const { return this->_key >= rhs._key; }
+    };
+
+    /**
+     * Associative container keeping its keys sorted in a contiguous rc::vector, and the mapped values
+     * in a second one at the same positions.
+     * Lookups are branchless binary searches over the keys only, which are densely packed in cache.
+     * Inserting or erasing a single element shifts the tail of both arrays.
+     */
+    template<typename K, typename V, typename Compare = std::less<K>>
+    class flat_map {
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = Pair<K, V>;
+        using difference_type = ptrdiff_t;
+
+        using iterator = flat_map_iterator<K, V>;
+        using const_iterator = flat_map_iterator<K, const V>;
+
+    private:
+        rc::vector<K> _keys;
+        rc::vector<V> _values;
+        Compare _comp;
+
+    public:
+        flat_map() = default;
+
+        flat_map(std::initializer_list<value_type> init);
+
+        // Builds the map from an unsorted range: sorted and deduplicated once.
+        // For duplicated keys, the first occurrence is kept.
+        template<typename IT>
+        flat_map(IT first, IT last);
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _keys.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return _keys.empty(); }
+
+        void reserve(size_t new_cap);
+
+        //      LOOKUP
+
+        iterator find(const K &key);
+
+        const_iterator find(const K &key) const;
+
+        bool contains(const K &key) const;
+
+        size_t count(const K &key) const;
+
+        // first element whose key is not ordered before `key`
+        iterator lower_bound(const K &key);
+
+        const_iterator lower_bound(const K &key) const;
+
+        // first element whose key is ordered after `key`
+        iterator upper_bound(const K &key);
+
+        const_iterator upper_bound(const K &key) const;
+
+        // access specified element with bounds checking
+        V &at(const K &key);
+
+        const V &at(const K &key) const;
+
+        // access or insert specified element
+        V &operator[](const K &key);
+
+        // direct access to the sorted keys and their values
+        const rc::vector<K> &keys() const noexcept { return _keys; }
+
+        const rc::vector<V> &values() const noexcept { return _values; }
+
+        //      MODIFIERS
+
+        // Inserts the element if the key is not already present.
+        Pair<iterator, bool> insert(const value_type &value);
+
+        Pair<iterator, bool> insert(value_type &&value);
+
+        // Constructs the value in-place if the key is not already present.
+        template<typename... Args>
+        Pair<iterator, bool> try_emplace(const K &key, Args &&... args);
+
+        // Inserts a batch of elements with a single linear merge, instead of one shifting insert per element.
+        // The batch is sorted first if needed. Keys already present are left untouched.
+        template<typename IT>
+        void insert_range(IT first, IT last);
+
+        iterator erase(const_iterator pos);
+
+        size_t erase(const K &key);
+
+        void clear() noexcept;
+
+    private:
+        size_t _lower_bound_index(const K &key) const;
+
+        bool _equal(const K &lhs, const K &rhs) const { return !_comp(lhs, rhs) && !_comp(rhs, lhs); }
+
+        // collects [first, last) in a sorted vector without duplicated keys.
+        template<typename IT>
+        rc::vector<value_type> _sorted_batch(IT first, IT last) const;
+
+        iterator _iterator_at(size_t i) { return iterator(_keys.data() + i, _values.data() + i); }
+
+        const_iterator _iterator_at(size_t i) const { return const_iterator(_keys.data() + i, _values.data() + i); }
+
+    public:
+        // BEGIN
+        iterator begin() noexcept { return _iterator_at(0); }
+
+        const_iterator begin() const noexcept { return _iterator_at(0); }
+
+        const_iterator cbegin() const noexcept { return _iterator_at(0); }
+
+        // END
+        iterator end() noexcept { return _iterator_at(size()); }
+
+        const_iterator end() const noexcept { return _iterator_at(size()); }
+
+        const_iterator cend() const noexcept { return _iterator_at(size()); }
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename K, typename V, typename Compare>
+    flat_map<K, V, Compare>::flat_map(std::initializer_list<value_type> init) : flat_map(init.begin(), init.end()) {}
+
+    template<typename K, typename V, typename Compare>
+    template<typename IT>
+    flat_map<K, V, Compare>::flat_map(IT first, IT last) {
+        rc::vector<value_type> batch = _sorted_batch(first, last);
+
+        reserve(batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            _keys.push_back(std::move(batch[i].first));
+            _values.push_back(std::move(batch[i].second));
+        }
+    }
+
+    //      CAPACITY
+
+    template<typename K, typename V, typename Compare>
+    void flat_map<K, V, Compare>::reserve(size_t new_cap) {
+        _keys.reserve(new_cap);
+        _values.reserve(new_cap);
+    }
+
+    //      LOOKUP
+
+    template<typename K, typename V, typename Compare>
+    size_t flat_map<K, V, Compare>::_lower_bound_index(const K &key) const {
+        const K *keys = _keys.data();
+        return rc::lower_bound(keys, keys + size(), key, _comp) - keys;
+    }
+
+    template<typename K, typename V, typename Compare>
+    typename flat_map<K, V, Compare>::iterator flat_map<K, V, Compare>::find(const K &key) {
+        size_t i = _lower_bound_index(key);
+        if (i == size() || _comp(key, _keys[i]))
+            return end();
+        return _iterator_at(i);
+    }
+
+    template<typename K, typename V, typename Compare>
+    typename flat_map<K, V, Compare>::const_iterator flat_map<K, V, Compare>::find(const K &key) const {
+        size_t i = _lower_bound_index(key);
+        if (i == size() || _comp(key, _keys[i]))
+            return end();
+        return _iterator_at(i);
+    }
+
+    template<typename K, typename V, typename Compare>
+    bool flat_map<K, V, Compare>::contains(const K &key) const {
+        return find(key) != end();
+    }
+
+    template<typename K, typename V, typename Compare>
+    size_t flat_map<K, V, Compare>::count(const K &key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template<typename K, typename V, typename Compare>
+    typename flat_map<K, V, Compare>::iterator flat_map<K, V, Compare>::lower_bound(const K &key) {
+        return _iterator_at(_lower_bound_index(key));
+    }
+
+    template<typename K, typename V, typename Compare>
+    typename flat_map<K, V, Compare>::const_iterator flat_map<K, V, Compare>::lower_bound(const K &key) const {
+        return _iterator_at(_lower_bound_index(key));
+    }
+
+    template<typename K, typename V, typename Compare>
+    typename flat_map<K, V, Compare>::iterator flat_map<K, V, Compare>::upper_bound(const K &key) {
+        const K *keys = _keys.data();
+        return _iterator_at(rc::upper_bound(keys, keys + size(), key, _comp) - keys);
+    }
+
+    template<typename K, typename V, typename Compare>
+    typename flat_map<K, V, Compare>::const_iterator flat_map<K, V, Compare>::upper_bound(const K &key) const {
+        const K *keys = _keys.data();
+        return _iterator_at(rc::upper_bound(keys, keys + size(), key, _comp) - keys);
+    }
+
+    template<typename K, typename V, typename Compare>
+    V &flat_map<K, V, Compare>::at(const K &key) {
+        iterator it = find(key);
+        if (it == end())
+            throw std::out_of_range("key not found");
+        return it->second;
+    }
+
+    template<typename K, typename V, typename Compare>
+    const V &flat_map<K, V, Compare>::at(const K &key) const {
+        const_iterator it = find(key);
+        if (it == end())
+            throw std::out_of_range("key not found");
+        return it->second;
+    }
+
+    template<typename K, typename V, typename Compare>
+    V &flat_map<K, V, Compare>::operator[](const K &key) {
+        return try_emplace(key).first->second;
+    }
+
+    //      MODIFIERS
+
+    template<typename K, typename V, typename Compare>
+    Pair<typename flat_map<K, V, Compare>::iterator, bool> flat_map<K, V, Compare>::insert(const value_type &value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    template<typename K, typename V, typename Compare>
+    Pair<typename flat_map<K, V, Compare>::iterator, bool> flat_map<K, V, Compare>::insert(value_type &&value) {
+        return try_emplace(value.first, std::move(value.second));
+    }
+
+    template<typename K, typename V, typename Compare>
+    template<typename... Args>
+    Pair<typename flat_map<K, V, Compare>::iterator, bool>
+    flat_map<K, V, Compare>::try_emplace(const K &key, Args &&... args) {
+        size_t i = _lower_bound_index(key);
+        if (i != size() && !_comp(key, _keys[i]))
+            return {_iterator_at(i), false};
+
+        _keys.emplace(_keys.begin() + i, key);
+        try {
+            _values.emplace(_values.begin() + i, std::forward<Args>(args)...);
+        } catch (...) {
+            // the keys must stay aligned with the values.
+            _keys.erase(_keys.begin() + i);
+            throw;
+        }
+        return {_iterator_at(i), true};
+    }
+
+    template<typename K, typename V, typename Compare>
+    template<typename IT>
+    void flat_map<K, V, Compare>::insert_range(IT first, IT last) {
+        rc::vector<value_type> batch = _sorted_batch(first, last);
+        if (batch.empty())
+            return;
+
+        rc::vector<K> keys;
+        rc::vector<V> values;
+        keys.reserve(size() + batch.size());
+        values.reserve(size() + batch.size());
+
+        // Linear merge of the two sorted sequences, existing keys win over the batch ones.
+        size_t i = 0;
+        size_t j = 0;
+        while (i < size() && j < batch.size()) {
+            if (_comp(batch[j].first, _keys[i])) {
+                keys.push_back(std::move(batch[j].first));
+                values.push_back(std::move(batch[j++].second));
+            } else {
+                if (!_comp(_keys[i], batch[j].first))
+                    ++j;
+                keys.push_back(std::move(_keys[i]));
+                values.push_back(std::move(_values[i++]));
+            }
+        }
+        for (; i < size(); ++i) {
+            keys.push_back(std::move(_keys[i]));
+            values.push_back(std::move(_values[i]));
+        }
+        for (; j < batch.size(); ++j) {
+            keys.push_back(std::move(batch[j].first));
+            values.push_back(std::move(batch[j].second));
+        }
+
+        _keys = std::move(keys);
+        _values = std::move(values);
+    }
+
+    template<typename K, typename V, typename Compare>
+    typename flat_map<K, V, Compare>::iterator flat_map<K, V, Compare>::erase(const_iterator pos) {
+        size_t i = pos - cbegin();
+        _keys.erase(_keys.begin() + i);
+        _values.erase(_values.begin() + i);
+        return _iterator_at(i);
+    }
+
+    template<typename K, typename V, typename Compare>
+    size_t flat_map<K, V, Compare>::erase(const K &key) {
+        const_iterator it = static_cast<const flat_map &>(*this).find(key);
+        if (it == cend())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    template<typename K, typename V, typename Compare>
+    void flat_map<K, V, Compare>::clear() noexcept {
+        _keys.clear();
+        _values.clear();
+    }
+
+    //      PRIVATE
+
+    template<typename K, typename V, typename Compare>
+    template<typename IT>
+    rc::vector<typename flat_map<K, V, Compare>::value_type>
+    flat_map<K, V, Compare>::_sorted_batch(IT first, IT last) const {
+        rc::vector<value_type> batch;
+        for (; first != last; ++first)
+            batch.push_back(*first);
+
+        // a stable sort keeps the first occurrence of a key in front of its duplicates.
+        auto by_key = [this](const value_type &lhs, const value_type &rhs) { return _comp(lhs.first, rhs.first); };
+        value_type *data = batch.data();
+        if (!std::is_sorted(data, data + batch.size(), by_key))
+            std::stable_sort(data, data + batch.size(), by_key);
+
+        // removes the duplicated keys in place.
+        size_t unique = 0;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (unique == 0 || !_equal(batch[unique - 1].first, batch[i].first)) {
+                if (unique != i)
+                    batch[unique] = std::move(batch[i]);
+                ++unique;
+            }
+        }
+        if (unique != batch.size())
+            batch.erase(batch.begin() + unique, batch.end());
+        return batch;
+    }
+}
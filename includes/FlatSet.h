@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <functional>
+#include <algorithm>
+#include "Vector.h"
+#include "Algorithm.h"
+#include "Utility.h"
+
+namespace rc {
+    /**
+     * Sorted set of unique keys stored contiguously in an rc::vector.
+     * Lookups are branchless binary searches, inserting or erasing a single key shifts the tail.
+     */
+    template<typename K, typename Compare = std::less<K>>
+    class flat_set {
+    public:
+        using key_type = K;
+        using value_type = K;
+        using difference_type = ptrdiff_t;
+
+        // keys must stay sorted, so they are never exposed as mutable.
+        using iterator = typename rc::vector<K>::const_iterator;
+        using const_iterator = typename rc::vector<K>::const_iterator;
+
+    private:
+        rc::vector<K> _keys;
+        Compare _comp;
+
+    public:
+        flat_set() = default;
+
+        flat_set(std::initializer_list<K> init);
+
+        // Builds the set from an unsorted range: sorted and deduplicated once.
+        template<typename IT>
+        flat_set(IT first, IT last);
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _keys.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return _keys.empty(); }
+
+        void reserve(size_t new_cap) { _keys.reserve(new_cap); }
+
+        //      LOOKUP
+
+        const_iterator find(const K &key) const;
+
+        bool contains(const K &key) const;
+
+        size_t count(const K &key) const;
+
+        // first key not ordered before `key`
+        const_iterator lower_bound(const K &key) const;
+
+        // first key ordered after `key`
+        const_iterator upper_bound(const K &key) const;
+
+        // direct access to the sorted keys
+        const rc::vector<K> &keys() const noexcept { return _keys; }
+
+        //      MODIFIERS
+
+        // Inserts the key if not already present.
+        Pair<const_iterator, bool> insert(const K &key);
+
+        Pair<const_iterator, bool> insert(K &&key);
+
+        // Inserts a batch of keys with a single linear merge, instead of one shifting insert per key.
+        // The batch is sorted first if needed.
+        template<typename IT>
+        void insert_range(IT first, IT last);
+
+        const_iterator erase(const_iterator pos);
+
+        size_t erase(const K &key);
+
+        void clear() noexcept { _keys.clear(); }
+
+    private:
+        size_t _lower_bound_index(const K &key) const;
+
+        bool _equal(const K &lhs, const K &rhs) const { return !_comp(lhs, rhs) && !_comp(rhs, lhs); }
+
+        // collects [first, last) in a sorted vector without duplicates.
+        template<typename IT>
+        rc::vector<K> _sorted_batch(IT first, IT last) const;
+
+        const_iterator _iterator_at(size_t i) const { return const_iterator(_keys.data() + i); }
+
+    public:
+        // BEGIN
+        const_iterator begin() const noexcept { return _iterator_at(0); }
+
+        const_iterator cbegin() const noexcept { return _iterator_at(0); }
+
+        // END
+        const_iterator end() const noexcept { return _iterator_at(size()); }
+
+        const_iterator cend() const noexcept { return _iterator_at(size()); }
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename K, typename Compare>
+    flat_set<K, Compare>::flat_set(std::initializer_list<K> init) : flat_set(init.begin(), init.end()) {}
+
+    template<typename K, typename Compare>
+    template<typename IT>
+    flat_set<K, Compare>::flat_set(IT first, IT last) {
+        _keys = _sorted_batch(first, last);
+    }
+
+    //      LOOKUP
+
+    template<typename K, typename Compare>
+    size_t flat_set<K, Compare>::_lower_bound_index(const K &key) const {
+        const K *keys = _keys.data();
+        return rc::lower_bound(keys, keys + size(), key, _comp) - keys;
+    }
+
+    template<typename K, typename Compare>
+    typename flat_set<K, Compare>::const_iterator flat_set<K, Compare>::find(const K &key) const {
+        size_t i = _lower_bound_index(key);
+        if (i == size() || _comp(key, _keys[i]))
+            return end();
+        return _iterator_at(i);
+    }
+
+    template<typename K, typename Compare>
+    bool flat_set<K, Compare>::contains(const K &key) const {
+        return find(key) != end();
+    }
+
+    template<typename K, typename Compare>
+    size_t flat_set<K, Compare>::count(const K &key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template<typename K, typename Compare>
+    typename flat_set<K, Compare>::const_iterator flat_set<K, Compare>::lower_bound(const K &key) const {
+        return _iterator_at(_lower_bound_index(key));
+    }
+
+    template<typename K, typename Compare>
+    typename flat_set<K, Compare>::const_iterator flat_set<K, Compare>::upper_bound(const K &key) const {
+        const K *keys = _keys.data();
+        return _iterator_at(rc::upper_bound(keys, keys + size(), key, _comp) - keys);
+    }
+
+    //      MODIFIERS
+
+    template<typename K, typename Compare>
+    Pair<typename flat_set<K, Compare>::const_iterator, bool> flat_set<K, Compare>::insert(const K &key) {
+        size_t i = _lower_bound_index(key);
+        if (i != size() && !_comp(key, _keys[i]))
+            return {_iterator_at(i), false};
+
+        _keys.insert(_keys.begin() + i, key);
+        return {_iterator_at(i), true};
+    }
+
+    template<typename K, typename Compare>
+    Pair<typename flat_set<K, Compare>::const_iterator, bool> flat_set<K, Compare>::insert(K &&key) {
+        size_t i = _lower_bound_index(key);
+        if (i != size() && !_comp(key, _keys[i]))
+            return {_iterator_at(i), false};
+
+        _keys.insert(_keys.begin() + i, std::move(key));
+        return {_iterator_at(i), true};
+    }
+
+    template<typename K, typename Compare>
+    template<typename IT>
+    void flat_set<K, Compare>::insert_range(IT first, IT last) {
+        rc::vector<K> batch = _sorted_batch(first, last);
+        if (batch.empty())
+            return;
+
+        rc::vector<K> keys;
+        keys.reserve(size() + batch.size());
+
+        // Linear merge of the two sorted sequences.
+        size_t i = 0;
+        size_t j = 0;
+        while (i < size() && j < batch.size()) {
+            if (_comp(batch[j], _keys[i])) {
+                keys.push_back(std::move(batch[j++]));
+            } else {
+                if (!_comp(_keys[i], batch[j]))
+                    ++j;
+                keys.push_back(std::move(_keys[i++]));
+            }
+        }
+        for (; i < size(); ++i)
+            keys.push_back(std::move(_keys[i]));
+        for (; j < batch.size(); ++j)
+            keys.push_back(std::move(batch[j]));
+
+        _keys = std::move(keys);
+    }
+
+    template<typename K, typename Compare>
+    typename flat_set<K, Compare>::const_iterator flat_set<K, Compare>::erase(const_iterator pos) {
+        size_t i = pos - cbegin();
+        _keys.erase(_keys.begin() + i);
+        return _iterator_at(i);
+    }
+
+    template<typename K, typename Compare>
+    size_t flat_set<K, Compare>::erase(const K &key) {
+        const_iterator it = find(key);
+        if (it == cend())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    //      PRIVATE
+
+    template<typename K, typename Compare>
+    template<typename IT>
+    rc::vector<K> flat_set<K, Compare>::_sorted_batch(IT first, IT last) const {
+        rc::vector<K> batch;
+        for (; first != last; ++first)
+            batch.push_back(*first);
+
+        K *data = batch.data();
+        if (!std::is_sorted(data, data + batch.size(), _comp))
+            std::sort(data, data + batch.size(), _comp);
+
+        // removes the duplicates in place.
+        size_t unique = 0;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (unique == 0 || !_equal(batch[unique - 1], batch[i])) {
+                if (unique != i)
+                    batch[unique] = std::move(batch[i]);
+                ++unique;
+            }
+        }
+        if (unique != batch.size())
+            batch.erase(batch.begin() + unique, batch.end());
+        return batch;
+    }
+}
@@ -0,0 +1,484 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Allocator.h"
+#include "Utility.h"
+
+namespace rc {
+    // link of a forward_list node; the list's before_begin() is a bare _forward_link embedded in the list.
+    struct _forward_link {
+        _forward_link *next = nullptr;
+    };
+
+    template<typename T>
+    struct _forward_node : _forward_link {
+        // the list constructs and destroys `data`, in place.
+        union {
+            T data;
+        };
+
+        template<typename... Args>
+        explicit _forward_node(Args &&... args) : data(std::forward<Args>(args)...) {}
+
+        ~_forward_node() {}
+
+        static _forward_node *from(_forward_link *link) { return static_cast<_forward_node *>(link); }
+    };
+
+    /**
+     * Forward iterator of a forward_list.
+     * @tparam T const qualified for the const iterator.
+     */
+    template<typename T>
+    class forward_list_iterator {
+        template<typename _T, typename _Alloc>
+        friend
+        class forward_list;
+
+        template<typename _T>
+        friend
+        class forward_list_iterator;
+
+    public:
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type *;
+        using const_pointer = value_type const *;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using iterator_category = forward_iterator_tag;
+
+    private:
+        using _node = _forward_node<std::remove_const_t<T>>;
+
+        _forward_link *_link;
+
+    public:
+        forward_list_iterator() : _link(nullptr) {}
+
+        explicit forward_list_iterator(_forward_link *link) : _link(link) {}
+
+        // iterator -> const_iterator
+        template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+        forward_list_iterator(forward_list_iterator<U> const &other) : _link(other._link) {}
+
+    public:
+        reference operator*() const { return _node::from(_link)->data; }
+
+        pointer operator->() const { return &_node::from(_link)->data; }
+
+        forward_list_iterator &operator++() {
+            _link = _link->next;
+            return *this;
+        }
+
+        forward_list_iterator operator++(int) {
+            forward_list_iterator cpy(*this);
+            _link = _link->next;
+            return cpy;
+        }
+
+        // COMPARE
+        bool operator==(const forward_list_iterator &rhs) const { return this->_link == rhs._link; }
+
+        bool operator!=(const forward_list_iterator &rhs) const { return this->_link != rhs._link; }
+    };
+
+    /**
+     * Singly linked list: one pointer of overhead per element, and no allocation for an empty list.
+     *
+     * The head link is embedded in the list and plays the role of the node before the first element
+     * (before_begin()), so every modifier works on the node *after* an iterator, like std::forward_list.
+     * As in std::forward_list, there is no size(): keeping it would cost a member and O(n) splices.
+     */
+    template<typename T, typename Alloc = rc::allocator<T>>
+    class forward_list {
+    public:
+        using value_type = T;
+        using iterator = forward_list_iterator<T>;
+        using const_iterator = forward_list_iterator<const T>;
+
+    private:
+        using _node = _forward_node<T>;
+        using _node_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_node>;
+
+        _forward_link _head;
+
+    public:
+        forward_list() = default;
+
+        forward_list(forward_list const &other);
+
+        forward_list(forward_list &&other) noexcept;
+
+        forward_list &operator=(forward_list const &other);
+
+        forward_list &operator=(forward_list &&other) noexcept;
+
+        forward_list(std::initializer_list<T> init);
+
+        ~forward_list();
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] bool empty() const noexcept { return _head.next == nullptr; }
+
+        //      ELEMENT ACCESS
+
+        T &front() { return _node::from(_head.next)->data; }
+
+        T const &front() const { return _node::from(_head.next)->data; }
+
+        //      MODIFIERS
+
+        void clear() noexcept;
+
+        void push_front(const T &value) { emplace_front(value); }
+
+        void push_front(T &&value) { emplace_front(std::move(value)); }
+
+        template<typename... Args>
+        T &emplace_front(Args &&... args);
+
+        void pop_front() { erase_after(cbefore_begin()); }
+
+        // Constructs an element in place after `pos`.
+        template<typename... Args>
+        iterator emplace_after(const_iterator pos, Args &&... args);
+
+        iterator insert_after(const_iterator pos, const T &value) { return emplace_after(pos, value); }
+
+        iterator insert_after(const_iterator pos, T &&value) { return emplace_after(pos, std::move(value)); }
+
+        // Returns an iterator to the last inserted element, or `pos` if none.
+        iterator insert_after(const_iterator pos, size_t count, const T &value);
+
+        template<typename IT, typename = std::enable_if_t<!std::is_integral_v<IT>>>
+        iterator insert_after(const_iterator pos, IT first, IT last);
+
+        // Removes the element following `pos`, and returns the one following it.
+        iterator erase_after(const_iterator pos);
+
+        // Removes the elements in (first, last).
+        iterator erase_after(const_iterator first, const_iterator last);
+
+        //      OPERATIONS
+        // None of them allocates nor copies an element: nodes are relinked.
+
+        // Moves every element of `other` after `pos`.
+        void splice_after(const_iterator pos, forward_list &other);
+
+        // Moves the element following `it` after `pos`.
+        void splice_after(const_iterator pos, forward_list &other, const_iterator it);
+
+        // Moves the elements in (first, last) after `pos`.
+        void splice_after(const_iterator pos, forward_list &other, const_iterator first, const_iterator last);
+
+        // Merges the sorted list `other` into this sorted list. Equal elements of this list come first.
+        template<typename Compare = std::less<T>>
+        void merge(forward_list &other, Compare comp = Compare());
+
+        // Stable merge sort, O(n log n), O(1) memory.
+        template<typename Compare = std::less<T>>
+        void sort(Compare comp = Compare());
+
+        void reverse() noexcept;
+
+        //      ITERATORS
+
+        iterator before_begin() noexcept { return iterator(&_head); }
+
+        const_iterator before_begin() const noexcept { return cbefore_begin(); }
+
+        const_iterator cbefore_begin() const noexcept { return const_iterator(const_cast<_forward_link *>(&_head)); }
+
+        iterator begin() noexcept { return iterator(_head.next); }
+
+        const_iterator begin() const noexcept { return cbegin(); }
+
+        const_iterator cbegin() const noexcept { return const_iterator(_head.next); }
+
+        iterator end() noexcept { return iterator(nullptr); }
+
+        const_iterator end() const noexcept { return cend(); }
+
+        const_iterator cend() const noexcept { return const_iterator(nullptr); }
+
+    private:
+        template<typename... Args>
+        static _node *_create(Args &&... args);
+
+        static void _destroy(_forward_link *link);
+
+        // merges two sorted null-terminated chains; `a` wins ties.
+        template<typename Compare>
+        static _forward_link *_merge_chains(_forward_link *a, _forward_link *b, Compare &comp);
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, typename Alloc>
+    forward_list<T, Alloc>::forward_list(const forward_list &other) {
+        insert_after(cbefore_begin(), other.begin(), other.end());
+    }
+
+    template<typename T, typename Alloc>
+    forward_list<T, Alloc>::forward_list(forward_list &&other) noexcept {
+        _head.next = other._head.next;
+        other._head.next = nullptr;
+    }
+
+    template<typename T, typename Alloc>
+    forward_list<T, Alloc>::forward_list(std::initializer_list<T> init) {
+        insert_after(cbefore_begin(), init.begin(), init.end());
+    }
+
+    template<typename T, typename Alloc>
+    forward_list<T, Alloc> &forward_list<T, Alloc>::operator=(const forward_list &other) {
+        if (this == &other)
+            return *this;
+
+        // assign the existing elements, then insert or erase the difference.
+        const_iterator prev = cbefore_begin();
+        iterator it = begin();
+        const_iterator other_it = other.begin();
+        for (; it != end() && other_it != other.end(); ++it, ++other_it, ++prev)
+            *it = *other_it;
+        if (other_it == other.end())
+            erase_after(prev, end());
+        else
+            insert_after(prev, other_it, other.end());
+        return *this;
+    }
+
+    template<typename T, typename Alloc>
+    forward_list<T, Alloc> &forward_list<T, Alloc>::operator=(forward_list &&other) noexcept {
+        if (this != &other) {
+            clear();
+            _head.next = other._head.next;
+            other._head.next = nullptr;
+        }
+        return *this;
+    }
+
+    template<typename T, typename Alloc>
+    forward_list<T, Alloc>::~forward_list() {
+        clear();
+    }
+
+    //      MODIFIERS
+
+    template<typename T, typename Alloc>
+    void forward_list<T, Alloc>::clear() noexcept {
+        _forward_link *link = _head.next;
+        while (link) {
+            _forward_link *next = link->next;
+            _destroy(link);
+            link = next;
+        }
+        _head.next = nullptr;
+    }
+
+    template<typename T, typename Alloc>
+    template<typename... Args>
+    T &forward_list<T, Alloc>::emplace_front(Args &&... args) {
+        return *emplace_after(cbefore_begin(), std::forward<Args>(args)...);
+    }
+
+    template<typename T, typename Alloc>
+    template<typename... Args>
+    typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::emplace_after(const_iterator pos, Args &&... args) {
+        _node *node = _create(std::forward<Args>(args)...);
+        node->next = pos._link->next;
+        pos._link->next = node;
+        return iterator(node);
+    }
+
+    template<typename T, typename Alloc>
+    typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::insert_after(const_iterator pos, size_t count, const T &value) {
+        iterator it(pos._link);
+        for (size_t i = 0; i < count; ++i)
+            it = emplace_after(it, value);
+        return it;
+    }
+
+    template<typename T, typename Alloc>
+    template<typename IT, typename>
+    typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::insert_after(const_iterator pos, IT first, IT last) {
+        iterator it(pos._link);
+        for (; first != last; ++first)
+            it = emplace_after(it, *first);
+        return it;
+    }
+
+    template<typename T, typename Alloc>
+    typename forward_list<T, Alloc>::iterator forward_list<T, Alloc>::erase_after(const_iterator pos) {
+        _forward_link *victim = pos._link->next;
+        pos._link->next = victim->next;
+        _destroy(victim);
+        return iterator(pos._link->next);
+    }
+
+    template<typename T, typename Alloc>
+    typename forward_list<T, Alloc>::iterator
+    forward_list<T, Alloc>::erase_after(const_iterator first, const_iterator last) {
+        _forward_link *link = first._link->next;
+        while (link != last._link) {
+            _forward_link *next = link->next;
+            _destroy(link);
+            link = next;
+        }
+        first._link->next = last._link;
+        return iterator(last._link);
+    }
+
+    //      OPERATIONS
+
+    template<typename T, typename Alloc>
+    void forward_list<T, Alloc>::splice_after(const_iterator pos, forward_list &other) {
+        if (&other == this || other.empty())
+            return;
+        _forward_link *last = &other._head;
+        while (last->next)
+            last = last->next;
+        last->next = pos._link->next;
+        pos._link->next = other._head.next;
+        other._head.next = nullptr;
+    }
+
+    template<typename T, typename Alloc>
+    void forward_list<T, Alloc>::splice_after(const_iterator pos, forward_list &, const_iterator it) {
+        _forward_link *moved = it._link->next;
+        if (pos._link == it._link || pos._link == moved)
+            return;
+        it._link->next = moved->next;
+        moved->next = pos._link->next;
+        pos._link->next = moved;
+    }
+
+    template<typename T, typename Alloc>
+    void forward_list<T, Alloc>::splice_after(const_iterator pos, forward_list &, const_iterator first,
+                                              const_iterator last) {
+        if (first == last || first._link->next == last._link)
+            return;
+        _forward_link *begin = first._link->next;
+        _forward_link *tail = begin;
+        while (tail->next != last._link)
+            tail = tail->next;
+
+        first._link->next = last._link;
+        tail->next = pos._link->next;
+        pos._link->next = begin;
+    }
+
+    template<typename T, typename Alloc>
+    template<typename Compare>
+    void forward_list<T, Alloc>::merge(forward_list &other, Compare comp) {
+        if (&other == this)
+            return;
+        _head.next = _merge_chains(_head.next, other._head.next, comp);
+        other._head.next = nullptr;
+    }
+
+    template<typename T, typename Alloc>
+    template<typename Compare>
+    void forward_list<T, Alloc>::sort(Compare comp) {
+        if (!_head.next || !_head.next->next)
+            return;
+
+        // Bottom-up: bins[i] holds a sorted chain of 2^i nodes (or is empty), filled like a binary counter.
+        _forward_link *bins[64] = {};
+        size_t fill = 0;
+        _forward_link *link = _head.next;
+        while (link) {
+            _forward_link *next = link->next;
+            link->next = nullptr;
+
+            _forward_link *carry = link;
+            size_t i = 0;
+            for (; i < fill && bins[i]; ++i) {
+                carry = _merge_chains(bins[i], carry, comp);
+                bins[i] = nullptr;
+            }
+            bins[i] = carry;
+            if (i == fill)
+                ++fill;
+            link = next;
+        }
+
+        _forward_link *sorted = nullptr;
+        for (size_t i = 0; i < fill; ++i) {
+            if (bins[i])
+                sorted = sorted ? _merge_chains(bins[i], sorted, comp) : bins[i];
+        }
+        _head.next = sorted;
+    }
+
+    template<typename T, typename Alloc>
+    void forward_list<T, Alloc>::reverse() noexcept {
+        _forward_link *reversed = nullptr;
+        _forward_link *link = _head.next;
+        while (link) {
+            _forward_link *next = link->next;
+            link->next = reversed;
+            reversed = link;
+            link = next;
+        }
+        _head.next = reversed;
+    }
+
+    //      PRIVATE
+
+    template<typename T, typename Alloc>
+    template<typename... Args>
+    typename forward_list<T, Alloc>::_node *forward_list<T, Alloc>::_create(Args &&... args) {
+        _node_alloc alloc;
+        _node *node = alloc.allocate(1);
+        try {
+            new(static_cast<void *>(node))_node(std::forward<Args>(args)...);
+        } catch (...) {
+            alloc.deallocate(node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    template<typename T, typename Alloc>
+    void forward_list<T, Alloc>::_destroy(_forward_link *link) {
+        _node *node = _node::from(link);
+        node->data.~T();
+        node->~_node();
+        _node_alloc alloc;
+        alloc.deallocate(node, 1);
+    }
+
+    template<typename T, typename Alloc>
+    template<typename Compare>
+    _forward_link *forward_list<T, Alloc>::_merge_chains(_forward_link *a, _forward_link *b, Compare &comp) {
+        _forward_link head;
+        _forward_link *tail = &head;
+        while (a && b) {
+            if (comp(_node::from(b)->data, _node::from(a)->data)) {
+                tail->next = b;
+                b = b->next;
+            } else {
+                tail->next = a;
+                a = a->next;
+            }
+            tail = tail->next;
+        }
+        tail->next = a ? a : b;
+        return head.next;
+    }
+}
@@ -0,0 +1,603 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cstdint>
+#include <stdexcept>
+#include <functional>
+#include <memory>
+#include <new>
+#include "Allocator.h"
+#include "Utility.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace rc {
+    /**
+     * A window of 16 consecutive control bytes, compared all at once.
+     * A control byte is either `empty` (sign bit set) or the 7 low bits of the hash of the stored key.
+     */
+    struct hash_ctrl_group {
+        static constexpr size_t width = 16;
+        static constexpr int8_t empty = -128;
+
+#if defined(__SSE2__)
+        __m128i ctrl;
+
+        explicit hash_ctrl_group(const int8_t *pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+        // bit i is set if the i-th byte equals h2
+        uint32_t match(int8_t h2) const {
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+        }
+
+        // bit i is set if the i-th byte is empty
+        uint32_t match_empty() const {
+            return _mm_movemask_epi8(ctrl);
+        }
+#else
+        const int8_t *ctrl;
+
+        explicit hash_ctrl_group(const int8_t *pos) : ctrl(pos) {}
+
+        uint32_t match(int8_t h2) const {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < width; ++i)
+                mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+            return mask;
+        }
+
+        uint32_t match_empty() const {
+            return match(empty);
+        }
+#endif
+    };
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    class hash_map;
+
+    template<typename VT>
+    class hash_map_iterator {
+        // hash_map<> must have access to the _slot private member.
+        template<typename, typename, typename, typename, typename>
+        friend
+        class hash_map;
+
+        template<typename>
+        friend
+        class hash_map_iterator;
+
+    public:
+        using value_type = VT;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type *;
+        using reference = value_type &;
+        using iterator_category = forward_iterator_tag;
+
+    private:
+        const int8_t *_ctrl;
+        const int8_t *_end;
+        VT *_slot;
+
+        void _skip_empty() {
+            while (_ctrl != _end && *_ctrl == hash_ctrl_group::empty) {
+                ++_ctrl;
+                ++_slot;
+            }
+        }
+
+    public:
+        hash_map_iterator() : _ctrl(nullptr), _end(nullptr), _slot(nullptr) {}
+
+        hash_map_iterator(const int8_t *ctrl, const int8_t *end, VT *slot) : _ctrl(ctrl), _end(end), _slot(slot) {
+            _skip_empty();
+        }
+
+        // iterator -> const_iterator conversion
+        template<typename U>
+        hash_map_iterator(hash_map_iterator<U> const &other) : _ctrl(other._ctrl), _end(other._end), _slot(other._slot) {}
+
+        hash_map_iterator(hash_map_iterator const &other) = default;
+
+        hash_map_iterator &operator=(hash_map_iterator const &other) = default;
+
+        ~hash_map_iterator() = default;
+
+    public:
+        reference operator*() const { return *_slot; }
+
+        pointer operator->() const { return _slot; }
+
+        hash_map_iterator &operator++() {
+            ++_ctrl;
+            ++_slot;
+            _skip_empty();
+            return *this;
+        }
+
+        hash_map_iterator operator++(int) {
+            hash_map_iterator cpy(*this);
+            ++*this;
+            return cpy;
+        }
+
+        // COMPARE
+        bool operator==(const hash_map_iterator &rhs) const { return this->_ctrl == rhs._ctrl; }
+
+        bool operator!=(const hash_map_iterator &rhs) const { return this->_ctrl != rhs._ctrl; }
+    };
+
+    /**
+     * Open addressing hash map, with linear probing over a control byte array scanned 16 slots at a time.
+     *
+     * Deletion never leaves a tombstone: the following elements of the probe run are shifted back
+     * over the hole, so a lookup can always stop at the first empty slot.
+     * Any insertion or erasure invalidates the iterators.
+     */
+    template<typename K, typename V,
+            typename Hash = std::hash<K>,
+            typename Eq = std::equal_to<K>,
+            typename Alloc = rc::allocator<Pair<const K, V>>>
+    class hash_map {
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = Pair<const K, V>;
+        using difference_type = ptrdiff_t;
+
+        using iterator = hash_map_iterator<value_type>;
+        using const_iterator = hash_map_iterator<const value_type>;
+
+    private:
+        using _group = hash_ctrl_group;
+        using _ctrl_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<int8_t>;
+
+        static constexpr size_t _min_capacity = _group::width;
+
+        // `_capacity + _group::width` bytes: the first group is cloned at the end,
+        // so that a group starting near the end can be loaded without wrapping around.
+        int8_t *_ctrl = nullptr;
+        value_type *_slots = nullptr;
+        size_t _capacity = 0; // 0 or a power of two >= _min_capacity
+        size_t _size = 0;
+        Hash _hash;
+        Eq _eq;
+
+    public:
+        hash_map() = default;
+
+        hash_map(hash_map const &other);
+
+        hash_map(hash_map &&other) noexcept;
+
+        hash_map &operator=(hash_map const &other);
+
+        hash_map &operator=(hash_map &&other) noexcept;
+
+        hash_map(std::initializer_list<value_type> init);
+
+        ~hash_map();
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+        // number of slots
+        [[nodiscard]] size_t bucket_count() const noexcept { return _capacity; }
+
+        [[nodiscard]] float load_factor() const noexcept {
+            return _capacity ? static_cast<float>(_size) / static_cast<float>(_capacity) : 0.f;
+        }
+
+        // makes room for at least `count` elements without rehashing
+        void reserve(size_t count);
+
+        // rebuilds the table with at least `count` slots (and enough for the current elements)
+        void rehash(size_t count);
+
+        //      LOOKUP
+
+        iterator find(const K &key);
+
+        const_iterator find(const K &key) const;
+
+        bool contains(const K &key) const;
+
+        size_t count(const K &key) const;
+
+        // access specified element with bounds checking
+        V &at(const K &key);
+
+        const V &at(const K &key) const;
+
+        // access or insert specified element
+        V &operator[](const K &key);
+
+        //      MODIFIERS
+
+        Pair<iterator, bool> insert(const value_type &value);
+
+        Pair<iterator, bool> insert(value_type &&value);
+
+        // Constructs the value in-place if the key is not already present.
+        template<typename KK, typename... Args>
+        Pair<iterator, bool> try_emplace(KK &&key, Args &&... args);
+
+        size_t erase(const K &key);
+
+        void erase(const_iterator pos);
+
+        void clear() noexcept;
+
+    private:
+        static size_t _mix(size_t hash) {
+            // spreads the entropy of weak hashes (like the identity std::hash<int>) over all the bits.
+            __uint128_t m = static_cast<__uint128_t>(hash) * 0x9E3779B97F4A7C15ull;
+            return static_cast<size_t>(m ^ (m >> 64));
+        }
+
+        static size_t _h1(size_t hash) { return hash >> 7; }
+
+        static int8_t _h2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+        size_t _hash_of(const K &key) const { return _mix(_hash(key)); }
+
+        // index of the slot holding `key`, or _capacity.
+        size_t _find_index(const K &key) const;
+
+        // index of the first empty slot of the probe run of `hash`.
+        size_t _find_empty(size_t hash) const;
+
+        void _set_ctrl(size_t i, int8_t h2) {
+            _ctrl[i] = h2;
+            if (i < _group::width)
+                _ctrl[_capacity + i] = h2;
+        }
+
+        // moves the element of the slot `from` to the empty slot `to`
+        void _relocate(size_t from, size_t to) {
+            new(static_cast<void *>(_slots + to))value_type{std::move(const_cast<K &>(_slots[from].first)),
+                                                            std::move(_slots[from].second)};
+            _slots[from].~value_type();
+            _set_ctrl(to, _ctrl[from]);
+        }
+
+        void _erase_at(size_t i);
+
+        void _destroy_all() noexcept;
+
+        void _release() noexcept;
+
+        static size_t _capacity_for(size_t count);
+
+    public:
+        // BEGIN
+        iterator begin() noexcept { return iterator(_ctrl, _ctrl + _capacity, _slots); }
+
+        const_iterator begin() const noexcept { return const_iterator(_ctrl, _ctrl + _capacity, _slots); }
+
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        // END
+        iterator end() noexcept { return iterator(_ctrl + _capacity, _ctrl + _capacity, _slots + _capacity); }
+
+        const_iterator end() const noexcept {
+            return const_iterator(_ctrl + _capacity, _ctrl + _capacity, _slots + _capacity);
+        }
+
+        const_iterator cend() const noexcept { return end(); }
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    hash_map<K, V, Hash, Eq, Alloc>::hash_map(const hash_map &other) : _hash(other._hash), _eq(other._eq) {
+        if (other._capacity == 0)
+            return;
+
+        Alloc alloc;
+        _ctrl_alloc ctrl_alloc;
+        _ctrl = ctrl_alloc.allocate(other._capacity + _group::width);
+        _slots = alloc.allocate(other._capacity);
+        _capacity = other._capacity;
+
+        // same capacity and same hash: every element keeps its slot.
+        for (size_t i = 0; i < _capacity + _group::width; ++i)
+            _ctrl[i] = other._ctrl[i];
+        for (size_t i = 0; i < _capacity; ++i) {
+            if (_ctrl[i] != _group::empty)
+                new(static_cast<void *>(_slots + i))value_type(other._slots[i]);
+        }
+        _size = other._size;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    hash_map<K, V, Hash, Eq, Alloc>::hash_map(hash_map &&other) noexcept
+            : _ctrl(other._ctrl), _slots(other._slots), _capacity(other._capacity), _size(other._size),
+              _hash(std::move(other._hash)), _eq(std::move(other._eq)) {
+        other._ctrl = nullptr;
+        other._slots = nullptr;
+        other._capacity = 0;
+        other._size = 0;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    hash_map<K, V, Hash, Eq, Alloc> &hash_map<K, V, Hash, Eq, Alloc>::operator=(const hash_map &other) {
+        if (this != &other) {
+            hash_map cpy(other);
+            *this = std::move(cpy);
+        }
+        return *this;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    hash_map<K, V, Hash, Eq, Alloc> &hash_map<K, V, Hash, Eq, Alloc>::operator=(hash_map &&other) noexcept {
+        if (this != &other) {
+            _release();
+            _ctrl = other._ctrl;
+            _slots = other._slots;
+            _capacity = other._capacity;
+            _size = other._size;
+            _hash = std::move(other._hash);
+            _eq = std::move(other._eq);
+            other._ctrl = nullptr;
+            other._slots = nullptr;
+            other._capacity = 0;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    hash_map<K, V, Hash, Eq, Alloc>::hash_map(std::initializer_list<value_type> init) {
+        reserve(init.size());
+        for (auto &el: init)
+            insert(el);
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    hash_map<K, V, Hash, Eq, Alloc>::~hash_map() {
+        _release();
+    }
+
+    //      CAPACITY
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    size_t hash_map<K, V, Hash, Eq, Alloc>::_capacity_for(size_t count) {
+        // Linear probing runs get long quickly above a 3/4 load factor.
+        size_t capacity = _min_capacity;
+        while (capacity - capacity / 4 < count)
+            capacity *= 2;
+        return capacity;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    void hash_map<K, V, Hash, Eq, Alloc>::reserve(size_t count) {
+        if (_capacity_for(count) > _capacity)
+            rehash(_capacity_for(count));
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    void hash_map<K, V, Hash, Eq, Alloc>::rehash(size_t count) {
+        size_t new_capacity = _capacity_for(_size);
+        while (new_capacity < count)
+            new_capacity *= 2;
+        if (new_capacity == _capacity)
+            return;
+
+        Alloc alloc;
+        _ctrl_alloc ctrl_alloc;
+        int8_t *old_ctrl = _ctrl;
+        value_type *old_slots = _slots;
+        size_t old_capacity = _capacity;
+
+        _ctrl = ctrl_alloc.allocate(new_capacity + _group::width);
+        _slots = alloc.allocate(new_capacity);
+        _capacity = new_capacity;
+        for (size_t i = 0; i < _capacity + _group::width; ++i)
+            _ctrl[i] = _group::empty;
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] == _group::empty)
+                continue;
+            value_type &old = old_slots[i];
+            size_t j = _find_empty(_hash_of(old.first));
+            new(static_cast<void *>(_slots + j))value_type{std::move(const_cast<K &>(old.first)),
+                                                           std::move(old.second)};
+            old.~value_type();
+            _set_ctrl(j, old_ctrl[i]);
+        }
+
+        if (old_capacity) {
+            alloc.deallocate(old_slots, old_capacity);
+            ctrl_alloc.deallocate(old_ctrl, old_capacity + _group::width);
+        }
+    }
+
+    //      LOOKUP
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    size_t hash_map<K, V, Hash, Eq, Alloc>::_find_index(const K &key) const {
+        if (_capacity == 0)
+            return 0;
+
+        size_t hash = _hash_of(key);
+        size_t mask = _capacity - 1;
+        size_t pos = _h1(hash) & mask;
+        int8_t h2 = _h2(hash);
+
+        while (true) {
+            _group group(_ctrl + pos);
+            for (uint32_t match = group.match(h2); match; match &= match - 1) {
+                size_t i = (pos + __builtin_ctz(match)) & mask;
+                if (_eq(_slots[i].first, key))
+                    return i;
+            }
+            // no tombstones: an empty slot ends the probe run.
+            if (group.match_empty())
+                return _capacity;
+            pos = (pos + _group::width) & mask;
+        }
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    size_t hash_map<K, V, Hash, Eq, Alloc>::_find_empty(size_t hash) const {
+        size_t mask = _capacity - 1;
+        size_t pos = _h1(hash) & mask;
+
+        while (true) {
+            uint32_t match = _group(_ctrl + pos).match_empty();
+            if (match)
+                return (pos + __builtin_ctz(match)) & mask;
+            pos = (pos + _group::width) & mask;
+        }
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    typename hash_map<K, V, Hash, Eq, Alloc>::iterator hash_map<K, V, Hash, Eq, Alloc>::find(const K &key) {
+        size_t i = _find_index(key);
+        return iterator(_ctrl + i, _ctrl + _capacity, _slots + i);
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    typename hash_map<K, V, Hash, Eq, Alloc>::const_iterator
+    hash_map<K, V, Hash, Eq, Alloc>::find(const K &key) const {
+        size_t i = _find_index(key);
+        return const_iterator(_ctrl + i, _ctrl + _capacity, _slots + i);
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    bool hash_map<K, V, Hash, Eq, Alloc>::contains(const K &key) const {
+        return _find_index(key) != _capacity;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    size_t hash_map<K, V, Hash, Eq, Alloc>::count(const K &key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    V &hash_map<K, V, Hash, Eq, Alloc>::at(const K &key) {
+        size_t i = _find_index(key);
+        if (i == _capacity)
+            throw std::out_of_range("key not found");
+        return _slots[i].second;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    const V &hash_map<K, V, Hash, Eq, Alloc>::at(const K &key) const {
+        size_t i = _find_index(key);
+        if (i == _capacity)
+            throw std::out_of_range("key not found");
+        return _slots[i].second;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    V &hash_map<K, V, Hash, Eq, Alloc>::operator[](const K &key) {
+        return try_emplace(key).first->second;
+    }
+
+    //      MODIFIERS
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    Pair<typename hash_map<K, V, Hash, Eq, Alloc>::iterator, bool>
+    hash_map<K, V, Hash, Eq, Alloc>::insert(const value_type &value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    Pair<typename hash_map<K, V, Hash, Eq, Alloc>::iterator, bool>
+    hash_map<K, V, Hash, Eq, Alloc>::insert(value_type &&value) {
+        return try_emplace(std::move(const_cast<K &>(value.first)), std::move(value.second));
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    template<typename KK, typename... Args>
+    Pair<typename hash_map<K, V, Hash, Eq, Alloc>::iterator, bool>
+    hash_map<K, V, Hash, Eq, Alloc>::try_emplace(KK &&key, Args &&... args) {
+        size_t i = _find_index(key);
+        if (i != _capacity)
+            return {iterator(_ctrl + i, _ctrl + _capacity, _slots + i), false};
+
+        if (_size + 1 > _capacity - _capacity / 4)
+            rehash(_capacity_for(_size + 1));
+
+        size_t hash = _hash_of(key);
+        i = _find_empty(hash);
+        new(static_cast<void *>(_slots + i))value_type{std::forward<KK>(key), V(std::forward<Args>(args)...)};
+        _set_ctrl(i, _h2(hash));
+        ++_size;
+        return {iterator(_ctrl + i, _ctrl + _capacity, _slots + i), true};
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    size_t hash_map<K, V, Hash, Eq, Alloc>::erase(const K &key) {
+        size_t i = _find_index(key);
+        if (i == _capacity)
+            return 0;
+        _erase_at(i);
+        return 1;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    void hash_map<K, V, Hash, Eq, Alloc>::erase(const_iterator pos) {
+        _erase_at(pos._ctrl - _ctrl);
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    void hash_map<K, V, Hash, Eq, Alloc>::_erase_at(size_t i) {
+        size_t mask = _capacity - 1;
+        _slots[i].~value_type();
+        --_size;
+
+        // Backward shift: every following element of the run that is allowed to live in the hole
+        // (its home slot is not between the hole and itself) is moved back, until an empty slot is reached.
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask; _ctrl[j] != _group::empty; j = (j + 1) & mask) {
+            size_t home = _h1(_hash_of(_slots[j].first)) & mask;
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                _relocate(j, hole);
+                hole = j;
+            }
+        }
+        _set_ctrl(hole, _group::empty);
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    void hash_map<K, V, Hash, Eq, Alloc>::clear() noexcept {
+        _destroy_all();
+        for (size_t i = 0; i < _capacity + (_capacity ? _group::width : 0); ++i)
+            _ctrl[i] = _group::empty;
+    }
+
+    //      PRIVATE
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    void hash_map<K, V, Hash, Eq, Alloc>::_destroy_all() noexcept {
+        for (size_t i = 0; i < _capacity; ++i) {
+            if (_ctrl[i] != _group::empty)
+                _slots[i].~value_type();
+        }
+        _size = 0;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+    void hash_map<K, V, Hash, Eq, Alloc>::_release() noexcept {
+        if (_capacity == 0)
+            return;
+
+        Alloc alloc;
+        _ctrl_alloc ctrl_alloc;
+        _destroy_all();
+        alloc.deallocate(_slots, _capacity);
+        ctrl_alloc.deallocate(_ctrl, _capacity + _group::width);
+        _ctrl = nullptr;
+        _slots = nullptr;
+        _capacity = 0;
+    }
+}
@@ -0,0 +1,554 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "Allocator.h"
+#include "Utility.h"
+
+namespace rc {
+    // links of a free list of erased runs, stored in the first erased slot of each run.
+    struct hive_free_links {
+        uint16_t prev;
+        uint16_t next;
+    };
+
+    template<typename T>
+    union hive_slot {
+        T value;
+        hive_free_links links;
+
+        hive_slot() {}
+
+        ~hive_slot() {}
+    };
+
+    /**
+     * Block of a hive. skipfield[i] is 0 for a live element. A run of erased slots has its length in
+     * its first and last entries (the jump-counting skipfield), so that an iterator jumps over it in one step.
+     */
+    template<typename T>
+    struct hive_block {
+        hive_slot<T> *slots;
+        uint16_t *skipfield;
+        size_t capacity;
+        // slots used at least once: [0, end)
+        size_t end = 0;
+        // live elements
+        size_t size = 0;
+        // first slot of the first erased run, or _none
+        uint16_t free_head;
+        hive_block *prev = nullptr;
+        hive_block *next = nullptr;
+        // blocks with erased runs to reuse
+        hive_block *prev_free = nullptr;
+        hive_block *next_free = nullptr;
+    };
+
+    template<typename T, typename Alloc>
+    class hive;
+
+    /**
+     * @tparam T is const for the const_iterator.
+     */
+    template<typename T>
+    class hive_iterator {
+        // hive<> must have access to the private members.
+        template<typename, typename>
+        friend
+        class hive;
+
+        template<typename>
+        friend
+        class hive_iterator;
+
+    public:
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type *;
+        using reference = value_type &;
+        using iterator_category = bidirectional_iterator_tag;
+
+    private:
+        using _block = hive_block<std::remove_const_t<T>>;
+
+        _block *_block_ptr;
+        size_t _index;
+
+    public:
+        hive_iterator() : _block_ptr(nullptr), _index(0) {}
+
+        hive_iterator(_block *block, size_t index) : _block_ptr(block), _index(index) {}
+
+        // iterator -> const_iterator conversion
+        template<typename U>
+        hive_iterator(hive_iterator<U> const &other) : _block_ptr(other._block_ptr), _index(other._index) {}
+
+    public:
+        // POINTER
+        reference operator*() const { return _block_ptr->slots[_index].value; }
+
+        pointer operator->() const { return &_block_ptr->slots[_index].value; }
+
+        // INCREMENT / DECREMENT
+        hive_iterator &operator++() {
+            ++_index;
+            // the end iterator is past the last used slot of the last block.
+            if (_index < _block_ptr->end)
+                _index += _block_ptr->skipfield[_index];
+            if (_index == _block_ptr->end && _block_ptr->next) {
+                _block_ptr = _block_ptr->next;
+                _index = _block_ptr->skipfield[0];
+            }
+            return *this;
+        }
+
+        hive_iterator operator++(int) {
+            hive_iterator cpy(*this);
+            ++*this;
+            return cpy;
+        }
+
+        hive_iterator &operator--() {
+            for (;;) {
+                if (_index == 0) {
+                    _block_ptr = _block_ptr->prev;
+                    _index = _block_ptr->end;
+                }
+                --_index;
+                size_t skip = _block_ptr->skipfield[_index];
+                if (skip == 0)
+                    break;
+                // _index ends an erased run: the element before it, if the run doesn't start the block.
+                if (skip <= _index) {
+                    _index -= skip;
+                    break;
+                }
+                _index = 0;
+            }
+            return *this;
+        }
+
+        hive_iterator operator--(int) {
+            hive_iterator cpy(*this);
+            --*this;
+            return cpy;
+        }
+
+        // COMPARE
+        bool operator==(const hive_iterator &rhs) const { return _block_ptr == rhs._block_ptr && _index == rhs._index; }
+
+        bool operator!=(const hive_iterator &rhs) const { return !(*this == rhs); }
+    };
+
+    /**
+     * Unordered container whose elements never move: pointers and iterators to an element stay valid until
+     * it is erased, with O(1) insert and erase.
+     *
+     * Elements are stored in blocks of geometrically growing capacity (8 to 8192 slots). Erasing leaves a hole,
+     * reused by a later insert: each block keeps a free list of its erased runs, and the hive a list of the
+     * blocks that have some. A block left empty is kept in reserve for the next new block, so that a workload
+     * inserting and erasing around a block boundary doesn't allocate each time: only the largest such block is
+     * kept, the others are released.
+     *
+     * Iteration walks the blocks in order and jumps over each erased run in one step, using the skipfield.
+     */
+    template<typename T, typename Alloc = rc::allocator<T>>
+    class hive {
+    public:
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+
+        using iterator = hive_iterator<T>;
+        using const_iterator = hive_iterator<const T>;
+
+        static constexpr size_t min_block_capacity = 8;
+        static constexpr size_t max_block_capacity = 8192;
+
+    private:
+        using _block = hive_block<T>;
+        using _slot = hive_slot<T>;
+        using _block_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_block>;
+        using _slot_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_slot>;
+        using _skip_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<uint16_t>;
+
+        static constexpr uint16_t _none = UINT16_MAX;
+
+        _block *_first = nullptr;
+        _block *_last = nullptr;
+        _block *_free_blocks = nullptr;
+        // empty block, out of the chain, taken by the next new block
+        _block *_reserve = nullptr;
+        size_t _size = 0;
+        size_t _capacity = 0;
+
+    public:
+        hive() = default;
+
+        hive(std::initializer_list<T> init);
+
+        hive(hive const &other);
+
+        hive(hive &&other) noexcept;
+
+        hive &operator=(hive const &other);
+
+        hive &operator=(hive &&other) noexcept;
+
+        ~hive() { clear(); }
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+        // slots of all the blocks, the reserve included
+        [[nodiscard]] size_t capacity() const noexcept { return _capacity; }
+
+        //      MODIFIERS
+
+        iterator insert(const T &value) { return emplace(value); }
+
+        iterator insert(T &&value) { return emplace(std::move(value)); }
+
+        // Constructs the element in an erased slot if there is one, or after the last element.
+        template<typename... Args>
+        iterator emplace(Args &&... args);
+
+        // Returns the iterator following the erased element.
+        iterator erase(const_iterator pos);
+
+        void clear() noexcept;
+
+        //      LOOKUP
+
+        // Iterator to the element at `element`, which must be in the hive. O(number of blocks).
+        iterator get_iterator(const T *element);
+
+        //      ITERATORS
+
+        iterator begin() noexcept { return _first ? iterator(_first, _first->skipfield[0]) : end(); }
+
+        const_iterator begin() const noexcept { return const_cast<hive *>(this)->begin(); }
+
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        iterator end() noexcept { return iterator(_last, _last ? _last->end : 0); }
+
+        const_iterator end() const noexcept { return const_iterator(_last, _last ? _last->end : 0); }
+
+        const_iterator cend() const noexcept { return end(); }
+
+    private:
+        _block *_new_block(size_t capacity);
+
+        void _delete_block(_block *block) noexcept;
+
+        // keeps the emptied `block`, out of the chain, as the reserve if it is the largest, else releases it.
+        void _retire_block(_block *block) noexcept;
+
+        void _push_free_block(_block *block) noexcept;
+
+        void _unlink_free_block(_block *block) noexcept;
+
+        // moves the free list node of the run starting at `from` to `to`.
+        static void _move_free_node(_block *block, uint16_t from, uint16_t to) noexcept;
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, typename Alloc>
+    hive<T, Alloc>::hive(std::initializer_list<T> init) {
+        for (auto &value: init)
+            insert(value);
+    }
+
+    template<typename T, typename Alloc>
+    hive<T, Alloc>::hive(hive const &other) {
+        for (auto &value: other)
+            insert(value);
+    }
+
+    template<typename T, typename Alloc>
+    hive<T, Alloc>::hive(hive &&other) noexcept
+            : _first(other._first), _last(other._last), _free_blocks(other._free_blocks), _reserve(other._reserve),
+              _size(other._size), _capacity(other._capacity) {
+        other._first = other._last = other._free_blocks = other._reserve = nullptr;
+        other._size = 0;
+        other._capacity = 0;
+    }
+
+    template<typename T, typename Alloc>
+    hive<T, Alloc> &hive<T, Alloc>::operator=(hive const &other) {
+        if (this != &other) {
+            clear();
+            for (auto &value: other)
+                insert(value);
+        }
+        return *this;
+    }
+
+    template<typename T, typename Alloc>
+    hive<T, Alloc> &hive<T, Alloc>::operator=(hive &&other) noexcept {
+        if (this != &other) {
+            clear();
+            std::swap(_first, other._first);
+            std::swap(_last, other._last);
+            std::swap(_free_blocks, other._free_blocks);
+            std::swap(_reserve, other._reserve);
+            std::swap(_size, other._size);
+            std::swap(_capacity, other._capacity);
+        }
+        return *this;
+    }
+
+    //      MODIFIERS
+
+    template<typename T, typename Alloc>
+    template<typename... Args>
+    typename hive<T, Alloc>::iterator hive<T, Alloc>::emplace(Args &&... args) {
+        if (_free_blocks) {
+            // reuses the first slot of the first erased run: the run now starts one slot later.
+            _block *block = _free_blocks;
+            uint16_t slot = block->free_head;
+            uint16_t next = block->slots[slot].links.next;
+            size_t length = block->skipfield[slot];
+            std::construct_at(&block->slots[slot].value, std::forward<Args>(args)...);
+            block->skipfield[slot] = 0;
+            if (length == 1) {
+                block->free_head = next;
+                if (next != _none)
+                    block->slots[next].links.prev = _none;
+                else
+                    _unlink_free_block(block);
+            } else {
+                block->skipfield[slot + 1] = static_cast<uint16_t>(length - 1);
+                block->skipfield[slot + length - 1] = static_cast<uint16_t>(length - 1);
+                block->slots[slot + 1].links = {_none, next};
+                block->free_head = static_cast<uint16_t>(slot + 1);
+                if (next != _none)
+                    block->slots[next].links.prev = static_cast<uint16_t>(slot + 1);
+            }
+            ++block->size;
+            ++_size;
+            return iterator(block, slot);
+        }
+
+        _block *block = _last;
+        bool fresh = !block || block->end == block->capacity;
+        if (fresh) {
+            size_t capacity = _last ? 2 * _last->capacity : min_block_capacity;
+            block = _reserve ? _reserve : _new_block(capacity > max_block_capacity ? max_block_capacity : capacity);
+        }
+        size_t slot = block->end;
+        try {
+            std::construct_at(&block->slots[slot].value, std::forward<Args>(args)...);
+        } catch (...) {
+            // a new block is linked only once its first element is constructed.
+            if (fresh && block != _reserve)
+                _delete_block(block);
+            throw;
+        }
+        if (fresh) {
+            if (block == _reserve)
+                _reserve = nullptr;
+            block->prev = _last;
+            if (_last)
+                _last->next = block;
+            else
+                _first = block;
+            _last = block;
+        }
+        block->skipfield[slot] = 0;
+        ++block->end;
+        ++block->size;
+        ++_size;
+        return iterator(block, slot);
+    }
+
+    template<typename T, typename Alloc>
+    typename hive<T, Alloc>::iterator hive<T, Alloc>::erase(const_iterator pos) {
+        _block *block = pos._block_ptr;
+        size_t i = pos._index;
+        iterator next(block, i);
+        ++next;
+        std::destroy_at(&block->slots[i].value);
+        --_size;
+
+        if (--block->size == 0) {
+            if (block->free_head != _none)
+                _unlink_free_block(block);
+            if (block->prev)
+                block->prev->next = block->next;
+            else
+                _first = block->next;
+            if (block->next)
+                block->next->prev = block->prev;
+            else
+                _last = block->prev;
+            _retire_block(block);
+            // `next` was the end iterator of this block.
+            return next._block_ptr == block ? end() : next;
+        }
+
+        // merges the slot with the erased runs around it.
+        uint16_t *skipfield = block->skipfield;
+        size_t left = i > 0 ? skipfield[i - 1] : 0;
+        size_t right = i + 1 < block->end ? skipfield[i + 1] : 0;
+        auto slot = static_cast<uint16_t>(i);
+        if (left == 0 && right == 0) {
+            skipfield[i] = 1;
+            if (block->free_head == _none)
+                _push_free_block(block);
+            else
+                block->slots[block->free_head].links.prev = slot;
+            block->slots[i].links = {_none, block->free_head};
+            block->free_head = slot;
+        } else if (right == 0) {
+            auto length = static_cast<uint16_t>(left + 1);
+            skipfield[i - left] = length;
+            skipfield[i] = length;
+        } else if (left == 0) {
+            auto length = static_cast<uint16_t>(right + 1);
+            skipfield[i] = length;
+            skipfield[i + right] = length;
+            _move_free_node(block, static_cast<uint16_t>(i + 1), slot);
+        } else {
+            auto length = static_cast<uint16_t>(left + right + 1);
+            skipfield[i - left] = length;
+            skipfield[i + right] = length;
+            // the run at the right is now part of the left one: its free list node goes away.
+            hive_free_links links = block->slots[i + 1].links;
+            if (links.prev != _none)
+                block->slots[links.prev].links.next = links.next;
+            else
+                block->free_head = links.next;
+            if (links.next != _none)
+                block->slots[links.next].links.prev = links.prev;
+        }
+        return next;
+    }
+
+    template<typename T, typename Alloc>
+    void hive<T, Alloc>::clear() noexcept {
+        _block *block = _first;
+        while (block) {
+            _block *next = block->next;
+            for (size_t i = block->skipfield[0]; i < block->end;) {
+                std::destroy_at(&block->slots[i].value);
+                ++i;
+                if (i < block->end)
+                    i += block->skipfield[i];
+            }
+            _delete_block(block);
+            block = next;
+        }
+        if (_reserve)
+            _delete_block(_reserve);
+        _first = _last = _free_blocks = _reserve = nullptr;
+        _size = 0;
+        _capacity = 0;
+    }
+
+    //      LOOKUP
+
+    template<typename T, typename Alloc>
+    typename hive<T, Alloc>::iterator hive<T, Alloc>::get_iterator(const T *element) {
+        for (_block *block = _first; block; block = block->next) {
+            const auto *slot = reinterpret_cast<const _slot *>(element);
+            if (slot >= block->slots && slot < block->slots + block->end)
+                return iterator(block, slot - block->slots);
+        }
+        return end();
+    }
+
+    //      PRIVATE
+
+    template<typename T, typename Alloc>
+    typename hive<T, Alloc>::_block *hive<T, Alloc>::_new_block(size_t capacity) {
+        _block_alloc block_alloc;
+        _slot_alloc slot_alloc;
+        _skip_alloc skip_alloc;
+        _block *block = block_alloc.allocate(1);
+        std::construct_at(block);
+        block->slots = nullptr;
+        try {
+            block->slots = slot_alloc.allocate(capacity);
+            block->skipfield = skip_alloc.allocate(capacity);
+        } catch (...) {
+            if (block->slots)
+                slot_alloc.deallocate(block->slots, capacity);
+            std::destroy_at(block);
+            block_alloc.deallocate(block, 1);
+            throw;
+        }
+        block->capacity = capacity;
+        block->free_head = _none;
+        _capacity += capacity;
+        return block;
+    }
+
+    template<typename T, typename Alloc>
+    void hive<T, Alloc>::_delete_block(_block *block) noexcept {
+        _block_alloc block_alloc;
+        _slot_alloc slot_alloc;
+        _skip_alloc skip_alloc;
+        _capacity -= block->capacity;
+        slot_alloc.deallocate(block->slots, block->capacity);
+        skip_alloc.deallocate(block->skipfield, block->capacity);
+        std::destroy_at(block);
+        block_alloc.deallocate(block, 1);
+    }
+
+    template<typename T, typename Alloc>
+    void hive<T, Alloc>::_retire_block(_block *block) noexcept {
+        if (_reserve && _reserve->capacity >= block->capacity) {
+            _delete_block(block);
+            return;
+        }
+        if (_reserve)
+            _delete_block(_reserve);
+        block->end = 0;
+        block->free_head = _none;
+        block->prev = block->next = nullptr;
+        _reserve = block;
+    }
+
+    template<typename T, typename Alloc>
+    void hive<T, Alloc>::_push_free_block(_block *block) noexcept {
+        block->prev_free = nullptr;
+        block->next_free = _free_blocks;
+        if (_free_blocks)
+            _free_blocks->prev_free = block;
+        _free_blocks = block;
+    }
+
+    template<typename T, typename Alloc>
+    void hive<T, Alloc>::_unlink_free_block(_block *block) noexcept {
+        if (block->prev_free)
+            block->prev_free->next_free = block->next_free;
+        else
+            _free_blocks = block->next_free;
+        if (block->next_free)
+            block->next_free->prev_free = block->prev_free;
+        block->prev_free = block->next_free = nullptr;
+    }
+
+    template<typename T, typename Alloc>
+    void hive<T, Alloc>::_move_free_node(_block *block, uint16_t from, uint16_t to) noexcept {
+        hive_free_links links = block->slots[from].links;
+        block->slots[to].links = links;
+        if (links.prev != _none)
+            block->slots[links.prev].links.next = to;
+        else
+            block->free_head = to;
+        if (links.next != _none)
+            block->slots[links.next].links.prev = to;
+    }
+}
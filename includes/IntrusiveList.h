@@ -0,0 +1,399 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cassert>
+#include <bit>
+#include <type_traits>
+#include "Utility.h"
+
+namespace rc {
+    template<typename T, auto Hook>
+    class intrusive_list;
+
+    /**
+     * Links embedded in an element of an intrusive_list.
+     *
+     * Copying an element does not copy its links: the copy starts unlinked.
+     * @tparam Safe asserts that the element is not inserted twice, and is not destroyed while linked.
+     */
+    template<bool Safe>
+    class basic_list_hook {
+        template<typename T, auto Hook>
+        friend
+        class intrusive_list;
+
+        template<typename T, auto Hook>
+        friend
+        class intrusive_list_iterator;
+
+    private:
+        basic_list_hook *_next = nullptr;
+        basic_list_hook *_prev = nullptr;
+
+    public:
+        basic_list_hook() = default;
+
+        basic_list_hook(basic_list_hook const &) noexcept {}
+
+        basic_list_hook &operator=(basic_list_hook const &) noexcept { return *this; }
+
+        ~basic_list_hook() {
+            if constexpr (Safe)
+                assert(!is_linked() && "element destroyed while still in an intrusive_list");
+        }
+
+    public:
+        [[nodiscard]] bool is_linked() const noexcept { return _next != nullptr; }
+
+        // Removes the element from its list, whichever it is.
+        void unlink() noexcept {
+            _prev->_next = _next;
+            _next->_prev = _prev;
+            _next = _prev = nullptr;
+        }
+
+    private:
+        // links this hook before `next`.
+        void _link_before(basic_list_hook *next) noexcept {
+            if constexpr (Safe)
+                assert(!is_linked() && "element already in an intrusive_list");
+            _next = next;
+            _prev = next->_prev;
+            _prev->_next = this;
+            next->_prev = this;
+        }
+    };
+
+    using list_hook = basic_list_hook<false>;
+    using safe_list_hook = basic_list_hook<true>;
+
+    template<typename M>
+    struct _list_hook_traits;
+
+    template<typename C, bool Safe>
+    struct _list_hook_traits<basic_list_hook<Safe> C::*> {
+        using owner = C;
+        using hook = basic_list_hook<Safe>;
+    };
+
+    /**
+     * Bidirectional iterator of an intrusive_list; same shape as list_iterator.
+     * @tparam T const qualified for the const iterator.
+     */
+    template<typename T, auto Hook>
+    class intrusive_list_iterator {
+        template<typename _T, auto _Hook>
+        friend
+        class intrusive_list;
+
+        template<typename _T, auto _Hook>
+        friend
+        class intrusive_list_iterator;
+
+    public:
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type *;
+        using const_pointer = value_type const *;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using iterator_category = bidirectional_iterator_tag;
+
+    private:
+        using Node = typename _list_hook_traits<decltype(Hook)>::hook;
+        Node *_node;
+
+    public:
+        intrusive_list_iterator(Node *node) : _node(node) {}
+
+        intrusive_list_iterator() : _node(nullptr) {}
+
+        // iterator -> const_iterator
+        template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+        intrusive_list_iterator(intrusive_list_iterator<U, Hook> const &other) : _node(other._node) {}
+
+    public:
+        reference operator*() const { return *intrusive_list<std::remove_const_t<T>, Hook>::_from_hook(_node); }
+
+        pointer operator->() const { return intrusive_list<std::remove_const_t<T>, Hook>::_from_hook(_node); }
+
+        intrusive_list_iterator &operator++() {
+            _node = _node->_next;
+            return *this;
+        }
+
+        intrusive_list_iterator operator++(int) {
+            intrusive_list_iterator cpy(*this);
+            _node = _node->_next;
+            return cpy;
+        }
+
+        intrusive_list_iterator &operator--() {
+            _node = _node->_prev;
+            return *this;
+        }
+
+        intrusive_list_iterator operator--(int) {
+            intrusive_list_iterator cpy(*this);
+            _node = _node->_prev;
+            return cpy;
+        }
+
+        // COMPARE
+        bool operator==(const intrusive_list_iterator &rhs) const { return this->_node == rhs._node; }
+
+        bool operator!=(const intrusive_list_iterator &rhs) const { return this->_node != rhs._node; }
+    };
+
+    /**
+     * Doubly linked list of elements that embed their own links: `rc::intrusive_list<T, &T::hook>`.
+     *
+     * The list never allocates nor copies: it links the objects it is given, which must outlive their membership.
+     * Every operation is O(1) except size(), which walks the list: an element can unlink itself
+     * (`element.hook.unlink()`) without knowing its list, so the list can't keep a count.
+     * An element is in at most one list per hook; give it several hooks to be in several lists.
+     */
+    template<typename T, auto Hook>
+    class intrusive_list {
+        template<typename _T, auto _Hook>
+        friend
+        class intrusive_list_iterator;
+
+        using _hook = typename _list_hook_traits<decltype(Hook)>::hook;
+        static_assert(std::is_base_of_v<typename _list_hook_traits<decltype(Hook)>::owner, T>,
+                      "the hook must be a member of T");
+        static_assert(sizeof(_hook T::*) == sizeof(ptrdiff_t), "a pointer to data member must be an offset");
+
+    public:
+        using value_type = T;
+        using iterator = intrusive_list_iterator<T, Hook>;
+        using const_iterator = intrusive_list_iterator<const T, Hook>;
+
+    private:
+        // circular: _head._next is the first element, _head._prev the last one.
+        _hook _head;
+
+    public:
+        intrusive_list();
+
+        intrusive_list(intrusive_list const &other) = delete;
+
+        intrusive_list &operator=(intrusive_list const &other) = delete;
+
+        intrusive_list(intrusive_list &&other) noexcept;
+
+        intrusive_list &operator=(intrusive_list &&other) noexcept;
+
+        // Unlinks the remaining elements.
+        ~intrusive_list();
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] bool empty() const noexcept { return _head._next == &_head; }
+
+        // O(n)
+        [[nodiscard]] size_t size() const noexcept;
+
+        //      ELEMENT ACCESS
+
+        T &front() { return *_from_hook(_head._next); }
+
+        T const &front() const { return *_from_hook(_head._next); }
+
+        T &back() { return *_from_hook(_head._prev); }
+
+        T const &back() const { return *_from_hook(_head._prev); }
+
+        //      MODIFIERS
+
+        void push_front(T &value) noexcept { _hook_of(value)._link_before(_head._next); }
+
+        void push_back(T &value) noexcept { _hook_of(value)._link_before(&_head); }
+
+        void pop_front() noexcept { _head._next->unlink(); }
+
+        void pop_back() noexcept { _head._prev->unlink(); }
+
+        // Links `value` before `pos`.
+        iterator insert(const_iterator pos, T &value) noexcept;
+
+        // Unlinks the element, and returns the one following it.
+        iterator erase(const_iterator pos) noexcept;
+
+        iterator erase(const_iterator first, const_iterator last) noexcept;
+
+        // Unlinks every element.
+        void clear() noexcept;
+
+        // Moves every element of `other` before `pos`.
+        void splice(const_iterator pos, intrusive_list &other) noexcept;
+
+        // Moves the element `it` (from any list) before `pos`.
+        void splice(const_iterator pos, intrusive_list &other, const_iterator it) noexcept;
+
+        // Moves [first, last) before `pos`. `pos` must not be in the range.
+        void splice(const_iterator pos, intrusive_list &other, const_iterator first, const_iterator last) noexcept;
+
+        //      ITERATORS
+
+        // Iterator to an element known to be in this list.
+        static iterator iterator_to(T &value) noexcept { return iterator(&_hook_of(value)); }
+
+        static const_iterator iterator_to(T const &value) noexcept {
+            return const_iterator(&_hook_of(const_cast<T &>(value)));
+        }
+
+        iterator begin() noexcept { return iterator(_head._next); }
+
+        const_iterator begin() const noexcept { return cbegin(); }
+
+        const_iterator cbegin() const noexcept { return const_iterator(_head._next); }
+
+        iterator end() noexcept { return iterator(&_head); }
+
+        const_iterator end() const noexcept { return cend(); }
+
+        const_iterator cend() const noexcept { return const_iterator(const_cast<_hook *>(&_head)); }
+
+    private:
+        static _hook &_hook_of(T &value) noexcept { return value.*Hook; }
+
+        static T *_from_hook(_hook *hook) noexcept;
+
+        // offset of the hook in T.
+        static ptrdiff_t _hook_offset() noexcept;
+
+        // moves [first, last] (inclusive, linked) before `pos`.
+        static void _transfer(_hook *pos, _hook *first, _hook *last) noexcept;
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, auto Hook>
+    intrusive_list<T, Hook>::intrusive_list() {
+        _head._next = _head._prev = &_head;
+    }
+
+    template<typename T, auto Hook>
+    intrusive_list<T, Hook>::intrusive_list(intrusive_list &&other) noexcept : intrusive_list() {
+        splice(cend(), other);
+    }
+
+    template<typename T, auto Hook>
+    intrusive_list<T, Hook> &intrusive_list<T, Hook>::operator=(intrusive_list &&other) noexcept {
+        if (this != &other) {
+            clear();
+            splice(cend(), other);
+        }
+        return *this;
+    }
+
+    template<typename T, auto Hook>
+    intrusive_list<T, Hook>::~intrusive_list() {
+        clear();
+        // the sentinel is not an element: it must not look linked to the safe hook destructor.
+        _head._next = _head._prev = nullptr;
+    }
+
+    template<typename T, auto Hook>
+    size_t intrusive_list<T, Hook>::size() const noexcept {
+        size_t count = 0;
+        for (const _hook *hook = _head._next; hook != &_head; hook = hook->_next)
+            ++count;
+        return count;
+    }
+
+    //      MODIFIERS
+
+    template<typename T, auto Hook>
+    typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::insert(const_iterator pos, T &value) noexcept {
+        _hook &hook = _hook_of(value);
+        hook._link_before(pos._node);
+        return iterator(&hook);
+    }
+
+    template<typename T, auto Hook>
+    typename intrusive_list<T, Hook>::iterator intrusive_list<T, Hook>::erase(const_iterator pos) noexcept {
+        _hook *next = pos._node->_next;
+        pos._node->unlink();
+        return iterator(next);
+    }
+
+    template<typename T, auto Hook>
+    typename intrusive_list<T, Hook>::iterator
+    intrusive_list<T, Hook>::erase(const_iterator first, const_iterator last) noexcept {
+        while (first != last)
+            first = erase(first);
+        return iterator(last._node);
+    }
+
+    template<typename T, auto Hook>
+    void intrusive_list<T, Hook>::clear() noexcept {
+        _hook *hook = _head._next;
+        while (hook != &_head) {
+            _hook *next = hook->_next;
+            hook->_next = hook->_prev = nullptr;
+            hook = next;
+        }
+        _head._next = _head._prev = &_head;
+    }
+
+    template<typename T, auto Hook>
+    void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list &other) noexcept {
+        if (other.empty())
+            return;
+        _hook *first = other._head._next;
+        _hook *last = other._head._prev;
+        other._head._next = other._head._prev = &other._head;
+
+        first->_prev = pos._node->_prev;
+        last->_next = pos._node;
+        pos._node->_prev->_next = first;
+        pos._node->_prev = last;
+    }
+
+    template<typename T, auto Hook>
+    void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list &, const_iterator it) noexcept {
+        if (pos._node == it._node || pos._node->_prev == it._node)
+            return;
+        _transfer(pos._node, it._node, it._node);
+    }
+
+    template<typename T, auto Hook>
+    void intrusive_list<T, Hook>::splice(const_iterator pos, intrusive_list &, const_iterator first,
+                                         const_iterator last) noexcept {
+        if (first == last)
+            return;
+        _transfer(pos._node, first._node, last._node->_prev);
+    }
+
+    //      PRIVATE
+
+    template<typename T, auto Hook>
+    T *intrusive_list<T, Hook>::_from_hook(_hook *hook) noexcept {
+        return reinterpret_cast<T *>(reinterpret_cast<char *>(hook) - _hook_offset());
+    }
+
+    template<typename T, auto Hook>
+    ptrdiff_t intrusive_list<T, Hook>::_hook_offset() noexcept {
+        // The Itanium C++ ABI (GCC, Clang) represents a pointer to data member as the offset of the member in
+        // its class: the bits of Hook, converted to a member of T, are the offset. No object is involved; this
+        // relies on the ABI, not on the standard.
+        _hook T::*hook = Hook;
+        return std::bit_cast<ptrdiff_t>(hook);
+    }
+
+    template<typename T, auto Hook>
+    void intrusive_list<T, Hook>::_transfer(_hook *pos, _hook *first, _hook *last) noexcept {
+        // detach [first, last]
+        first->_prev->_next = last->_next;
+        last->_next->_prev = first->_prev;
+        // link it before pos
+        first->_prev = pos->_prev;
+        last->_next = pos;
+        pos->_prev->_next = first;
+        pos->_prev = last;
+    }
+}
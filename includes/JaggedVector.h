@@ -0,0 +1,246 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cassert>
+#include <barrier>
+#include <initializer_list>
+#include <span>
+#include <thread>
+#include <utility>
+#include "Allocator.h"
+#include "Vector.h"
+
+namespace rc {
+    /**
+     * Sequence of variable length rows, all stored back to back in a single rc::vector (the compressed sparse
+     * row layout): row i is values[offsets[i], offsets[i + 1]).
+     *
+     * Compared to a vector of vectors, a row costs one offset instead of a vector header plus a heap block,
+     * and a pass over every row reads memory sequentially. Rows can only be appended or removed at the end;
+     * see jagged_vector::builder to fill rows in any order.
+     */
+    template<typename T, typename Alloc = rc::allocator<T>>
+    class jagged_vector {
+    public:
+        using value_type = T;
+        using row_type = std::span<T>;
+        using const_row_type = std::span<const T>;
+
+        class builder;
+
+    private:
+        vector<T, Alloc> _values;
+        // rows() + 1 entries starting at 0, or none while there is no row.
+        vector<size_t> _offsets;
+
+    public:
+        jagged_vector() = default;
+
+        jagged_vector(std::initializer_list<std::initializer_list<T>> rows);
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t rows() const noexcept { return _offsets.empty() ? 0 : _offsets.size() - 1; }
+
+        // total number of values
+        [[nodiscard]] size_t size() const noexcept { return _values.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return rows() == 0; }
+
+        void reserve(size_t rows, size_t values);
+
+        //      ELEMENT ACCESS
+
+        row_type row(size_t i) { return row_type(_values.data() + _offsets[i], row_size(i)); }
+
+        const_row_type row(size_t i) const { return const_row_type(_values.data() + _offsets[i], row_size(i)); }
+
+        row_type operator[](size_t i) { return row(i); }
+
+        const_row_type operator[](size_t i) const { return row(i); }
+
+        [[nodiscard]] size_t row_size(size_t i) const { return _offsets[i + 1] - _offsets[i]; }
+
+        // every value, row after row
+        row_type values() noexcept { return row_type(_values.data(), _values.size()); }
+
+        const_row_type values() const noexcept { return const_row_type(_values.data(), _values.size()); }
+
+        // rows() + 1 offsets in values(), or none if there is no row.
+        std::span<const size_t> offsets() const noexcept { return {_offsets.data(), _offsets.size()}; }
+
+        //      MODIFIERS
+
+        // Appends the row [first, last).
+        template<typename IT>
+        void push_row(IT first, IT last);
+
+        // Appends a row holding the elements of `range`.
+        template<typename R>
+        void push_row(R const &range) { push_row(range.begin(), range.end()); }
+
+        void push_row(std::initializer_list<T> values) { push_row(values.begin(), values.end()); }
+
+        // Appends a value to the last row.
+        void push_back(const T &value);
+
+        void pop_row();
+
+        void clear() noexcept;
+
+    private:
+        jagged_vector(vector<T, Alloc> &&values, vector<size_t> &&offsets)
+                : _values(std::move(values)), _offsets(std::move(offsets)) {}
+    };
+
+    /**
+     * Builds a jagged_vector whose rows are filled in any order, in two passes over the input:
+     * count() the values of every row, allocate(), then fill() them, and build().
+     *
+     * Different threads may count or fill at the same time, as long as each row is only touched by one of them.
+     */
+    template<typename T, typename Alloc>
+    class jagged_vector<T, Alloc>::builder {
+        vector<T, Alloc> _values;
+        // counts, then offsets once allocated.
+        vector<size_t> _offsets;
+        // next free slot of each row
+        vector<size_t> _cursors;
+
+    public:
+        explicit builder(size_t rows);
+
+        void count(size_t row, size_t n = 1) { _offsets[row + 1] += n; }
+
+        // Ends the counting pass: turns the counts into offsets (with a parallel prefix sum if `threads` > 1),
+        // and allocates the values, default constructed.
+        void allocate(unsigned threads = 1);
+
+        void fill(size_t row, const T &value) { _values[_cursors[row]++] = value; }
+
+        void fill(size_t row, T &&value) { _values[_cursors[row]++] = std::move(value); }
+
+        // Every counted value must have been filled.
+        jagged_vector build() &&;
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, typename Alloc>
+    jagged_vector<T, Alloc>::jagged_vector(std::initializer_list<std::initializer_list<T>> rows) {
+        size_t values = 0;
+        for (auto &row: rows)
+            values += row.size();
+        reserve(rows.size(), values);
+        for (auto &row: rows)
+            push_row(row);
+    }
+
+    template<typename T, typename Alloc>
+    void jagged_vector<T, Alloc>::reserve(size_t rows, size_t values) {
+        _offsets.reserve(rows + 1);
+        _values.reserve(values);
+    }
+
+    //      MODIFIERS
+
+    template<typename T, typename Alloc>
+    template<typename IT>
+    void jagged_vector<T, Alloc>::push_row(IT first, IT last) {
+        if (_offsets.empty())
+            _offsets.push_back(0);
+        for (; first != last; ++first)
+            _values.push_back(*first);
+        _offsets.push_back(_values.size());
+    }
+
+    template<typename T, typename Alloc>
+    void jagged_vector<T, Alloc>::push_back(const T &value) {
+        assert(!empty() && "push_back() needs a row to append to");
+        _values.push_back(value);
+        ++_offsets.back();
+    }
+
+    template<typename T, typename Alloc>
+    void jagged_vector<T, Alloc>::pop_row() {
+        size_t first = _offsets[_offsets.size() - 2];
+        while (_values.size() > first)
+            _values.pop_back();
+        _offsets.pop_back();
+        if (_offsets.size() == 1)
+            _offsets.clear();
+    }
+
+    template<typename T, typename Alloc>
+    void jagged_vector<T, Alloc>::clear() noexcept {
+        _values.clear();
+        _offsets.clear();
+    }
+
+    //      BUILDER
+
+    template<typename T, typename Alloc>
+    jagged_vector<T, Alloc>::builder::builder(size_t rows) {
+        _offsets.resize(rows + 1, 0);
+    }
+
+    template<typename T, typename Alloc>
+    void jagged_vector<T, Alloc>::builder::allocate(unsigned threads) {
+        // inclusive prefix sum of the counts: _offsets[i] becomes the number of values before row i.
+        size_t *sums = _offsets.data();
+        size_t n = _offsets.size();
+        constexpr size_t min_chunk = 1 << 16;
+        if (threads > n / min_chunk)
+            threads = static_cast<unsigned>(n / min_chunk);
+
+        if (threads <= 1) {
+            for (size_t i = 1; i < n; ++i)
+                sums[i] += sums[i - 1];
+        } else {
+            // each thread sums its chunk, the chunk totals are scanned, then each chunk is scanned from its base.
+            vector<size_t> totals;
+            totals.resize(threads, 0);
+            std::barrier sync(threads);
+            auto worker = [&](unsigned t) {
+                size_t begin = n * t / threads;
+                size_t end = n * (t + 1) / threads;
+                size_t total = 0;
+                for (size_t i = begin; i < end; ++i)
+                    total += sums[i];
+                totals[t] = total;
+                sync.arrive_and_wait();
+
+                size_t base = 0;
+                for (unsigned c = 0; c < t; ++c)
+                    base += totals[c];
+                for (size_t i = begin; i < end; ++i) {
+                    base += sums[i];
+                    sums[i] = base;
+                }
+            };
+            vector<std::thread> pool;
+            pool.reserve(threads - 1);
+            for (unsigned t = 1; t < threads; ++t)
+                pool.emplace_back(worker, t);
+            worker(0);
+            for (auto &thread: pool)
+                thread.join();
+        }
+
+        _cursors.resize(n - 1, 0);
+        for (size_t i = 0; i + 1 < n; ++i)
+            _cursors[i] = sums[i];
+        _values.resize(sums[n - 1]);
+    }
+
+    template<typename T, typename Alloc>
+    jagged_vector<T, Alloc> jagged_vector<T, Alloc>::builder::build() &&{
+        for (size_t i = 0; i < _cursors.size(); ++i)
+            assert(_cursors[i] == _offsets[i + 1] && "a counted value was not filled");
+        if (_cursors.empty())
+            return jagged_vector();
+        return jagged_vector(std::move(_values), std::move(_offsets));
+    }
+}
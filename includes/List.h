@@ -7,27 +7,43 @@
 #include "ListIterator.h"
 #include "ReverseIterator.h"
 #include <cassert>
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <utility>
 
 namespace rc {
     template<typename T>
     class list {
     public:
+        struct _slab;
+
         struct Node {
-            T data;
+            // In a union, so that the sentinel node holds no element: the list constructs and destroys `data`.
+            union {
+                T data;
+            };
             Node *next;
             Node *prev;
+            // the block allocated by compact() holding this node, or nullptr if the node was allocated alone.
+            _slab *slab = nullptr;
 
-            Node() : prev(nullptr), next(nullptr) {};
-
-            Node(Node const &other) = default;
+            // sentinel
+            Node() : next(nullptr), prev(nullptr) {};
 
-            Node(T value) : data(value), prev(nullptr), next(nullptr) {}
+            Node(Node const &other) = delete;
 
-            Node(T value, Node *prev, Node *next) : data(value), prev(prev), next(next) {}
+            // Constructs the element in place from `args`, which are forwarded untouched.
+            template<typename... Args>
+            Node(Node *prev, Node *next, Args &&... args) : data(std::forward<Args>(args)...), next(next), prev(prev) {}
 
-            Node(Node *prev, Node *next) : prev(prev), next(next) {}
+            ~Node() {}
+        };
 
-            ~Node() = default;
+        // Contiguous nodes allocated by compact(). Freed with its last node, whichever list it belongs to by then.
+        struct _slab {
+            Node *nodes;
+            size_t live;
         };
 
     public:
@@ -87,6 +103,55 @@ namespace rc {
 
         iterator insert(const iterator position, T &&value);
 
+        // Constructs an element in place before `pos`.
+        template<typename... Args>
+        iterator emplace(const iterator pos, Args &&... args);
+
+        template<typename... Args>
+        T &emplace_back(Args &&... args);
+
+        template<typename... Args>
+        T &emplace_front(Args &&... args);
+
+        //      OPERATIONS
+        // None of them allocates nor copies an element: nodes are relinked.
+
+        // Moves every element of `other` before `pos`.
+        void splice(iterator pos, list &other);
+
+        // Moves the element `it` of `other` before `pos`.
+        void splice(iterator pos, list &other, iterator it);
+
+        // Moves [first, last) of `other` before `pos`. O(n) to count the elements, unless `other` is this list.
+        void splice(iterator pos, list &other, iterator first, iterator last);
+
+        // Merges the sorted list `other` into this sorted list. Equal elements of this list come first.
+        template<typename Compare = std::less<T>>
+        void merge(list &other, Compare comp = Compare());
+
+        // Stable merge sort, O(n log n).
+        template<typename Compare = std::less<T>>
+        void sort(Compare comp = Compare());
+
+        void reverse() noexcept;
+
+        // Removes the consecutive duplicates, and returns the number of removed elements.
+        template<typename BinaryPredicate = std::equal_to<T>>
+        size_t unique(BinaryPredicate pred = BinaryPredicate());
+
+        //      LOCALITY
+
+        // Moves all the elements into one contiguous block of nodes, in list order, so that a traversal
+        // reads memory sequentially. Invalidates every iterator and reference to the elements.
+        void compact();
+
+        // Calls `f` on every element in order, prefetching two nodes ahead to hide the latency of the links.
+        template<typename F>
+        void for_each(F f);
+
+        template<typename F>
+        void for_each(F f) const;
+
         size_t size() const;
 
         bool empty() const;
@@ -139,6 +204,23 @@ namespace rc {
         const_reverse_iterator rend() const noexcept { return const_reverse_iterator(cbegin()); }
 
         const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+    private:
+        // destroys the element of the node, then frees it.
+        static void _destroy(Node *node);
+
+        // frees a slab whose nodes are all destroyed.
+        static void _free_slab(_slab *slab);
+
+        // detaches the nodes [first, last] (last included) from the chain, without touching the size.
+        void _unlink(Node *first, Node *last);
+
+        // links the detached nodes [first, last] before `pos`, without touching the size.
+        void _link(Node *pos, Node *first, Node *last);
+
+        // merges two sorted null-terminated chains linked by `next` only.
+        template<typename Compare>
+        static Node *_merge_chains(Node *a, Node *b, Compare &comp);
     };
 
     //              IMPLEMENTATIONS
@@ -155,6 +237,51 @@ namespace rc {
         insert(begin(), other.begin(), other.end());
     }
 
+    template<typename T>
+    list<T>::list(list &&other) {
+        // `other` keeps a new empty sentinel.
+        _first = _last = new Node();
+        std::swap(_first, other._first);
+        std::swap(_last, other._last);
+        std::swap(_size, other._size);
+    }
+
+    template<typename T>
+    list<T>::list(std::initializer_list<T> init) {
+        _first = _last = new Node();
+        insert(begin(), init.begin(), init.end());
+    }
+
+    template<typename T>
+    list<T> &list<T>::operator=(const list &other) {
+        if (this == &other)
+            return *this;
+
+        // assign the existing elements, then insert or erase the difference.
+        iterator it = begin();
+        const_iterator other_it = other.begin();
+        for (; it != end() && other_it != other.end(); ++it, ++other_it)
+            *it = *other_it;
+        if (other_it == other.end())
+            erase(it, end());
+        else
+            insert(end(), other_it, other.end());
+        return *this;
+    }
+
+    template<typename T>
+    list<T> &list<T>::operator=(list &&other) {
+        if (this == &other)
+            return *this;
+
+        // `other` gets our emptied sentinel.
+        clear();
+        std::swap(_first, other._first);
+        std::swap(_last, other._last);
+        std::swap(_size, other._size);
+        return *this;
+    }
+
     template<typename T>
     list<T>::~list() {
         clear();
@@ -183,11 +310,12 @@ namespace rc {
 
     // MODIFIERS
     template<typename T>
-    typename list<T>::iterator list<T>::insert(const list::iterator position, T &&value) {
+    template<typename... Args>
+    typename list<T>::iterator list<T>::emplace(const list::iterator pos, Args &&... args) {
 
         // Creates a new node that takes its place between the element preceding the one pointed to by the "pos"
-        //      iterator and the one pointed to by the iterator.
-        Node *tmp = new Node(std::move(value), position._node->prev, position._node);
+        //      iterator and the one pointed to by the iterator. The element is built directly in the node.
+        Node *tmp = new Node(pos._node->prev, pos._node, std::forward<Args>(args)...);
 
         if (tmp->prev)
             tmp->prev->next = tmp;
@@ -200,20 +328,25 @@ namespace rc {
     }
 
     template<typename T>
-    typename list<T>::iterator list<T>::insert(const list::iterator pos, const T &value) {
+    template<typename... Args>
+    T &list<T>::emplace_back(Args &&... args) {
+        return *emplace(end(), std::forward<Args>(args)...);
+    }
 
-        // Creates a new node that takes its place between the element preceding the one pointed to by the "pos"
-        //      iterator and the one pointed to by the iterator.
-        Node *tmp = new Node(value, pos._node->prev, pos._node);
+    template<typename T>
+    template<typename... Args>
+    T &list<T>::emplace_front(Args &&... args) {
+        return *emplace(begin(), std::forward<Args>(args)...);
+    }
 
-        if (tmp->prev)
-            tmp->prev->next = tmp;
-        else
-            _first = tmp;
+    template<typename T>
+    typename list<T>::iterator list<T>::insert(const list::iterator position, T &&value) {
+        return emplace(position, std::move(value));
+    }
 
-        tmp->next->prev = tmp;
-        ++_size;
-        return iterator(tmp);
+    template<typename T>
+    typename list<T>::iterator list<T>::insert(const list::iterator pos, const T &value) {
+        return emplace(pos, value);
     }
 
     template<typename T>
@@ -223,13 +356,15 @@ namespace rc {
             return pos;
 
         Node *prev = pos._node->prev;
-        Node *first_inserted = prev;
+        Node *first_inserted = nullptr;
 
         // each elements to insert before pos:
         for (IT it = first; it != last; ++it) {
             ++_size;
             // creating a new node linked with the previous one
-            Node *tmp = new Node(*it, prev, nullptr);
+            Node *tmp = new Node(prev, nullptr, *it);
+            if (!first_inserted)
+                first_inserted = tmp;
 
             // them link the previous to the new one
             if (prev)
@@ -244,7 +379,7 @@ namespace rc {
         if (prev)
             prev->next = pos._node;
 
-        return first_inserted ? first_inserted : begin();
+        return iterator(first_inserted);
     }
 
     template<typename T>
@@ -258,12 +393,14 @@ namespace rc {
             return pos;
 
         Node *prev = pos._node->prev;
-        Node *first_inserted = prev;
+        Node *first_inserted = nullptr;
 
         // Pour chauque element a inserer AVANT pos:
-        for (int i = 0; i < count; ++i) {
+        for (size_t i = 0; i < count; ++i) {
             // on cree un nouveau Node, avec le contenu de l'it, et en prev l'element avant pos.
-            Node *tmp = new Node(value, prev, nullptr);
+            Node *tmp = new Node(prev, nullptr, value);
+            if (!first_inserted)
+                first_inserted = tmp;
 
             // Si on a un element avant, on l'accroche, sinon, celui ci est le premier.
             if (prev)
@@ -280,7 +417,7 @@ namespace rc {
             prev->next = pos._node;
         _size += count;
 
-        return first_inserted;
+        return iterator(first_inserted);
     }
 
     template<typename T>
@@ -292,7 +429,7 @@ namespace rc {
             iterator tmp(runner);
             --_size;
             ++runner;
-            delete tmp._node; // ... here, then accessed ...
+            _destroy(tmp._node); // ... here, then accessed ...
         }
         if (first_prev_node != nullptr) // ...here .
             first_prev_node->next = last._node;
@@ -308,16 +445,19 @@ namespace rc {
     void list<T>::pop_back() {
         --_size;
         Node *tmp = _last->prev;
-        _last->prev = _last->prev->prev;
-        _last->prev->next = _last;
-        delete tmp;
+        _last->prev = tmp->prev;
+        if (tmp->prev)
+            tmp->prev->next = _last;
+        else
+            _first = _last;
+        _destroy(tmp);
     }
 
     template<typename T>
     void list<T>::pop_front() {
         --_size;
         _first = _first->next;
-        delete _first->prev;
+        _destroy(_first->prev);
         _first->prev = nullptr;
     }
 
@@ -348,5 +488,276 @@ namespace rc {
         erase(begin(), end());
     }
 
+    // OPERATIONS
+
+    template<typename T>
+    void list<T>::splice(iterator pos, list &other) {
+        if (&other == this || other.empty())
+            return;
+        Node *first = other._first;
+        Node *last = other._last->prev;
+        other._unlink(first, last);
+        _link(pos._node, first, last);
+        _size += other._size;
+        other._size = 0;
+    }
+
+    template<typename T>
+    void list<T>::splice(iterator pos, list &other, iterator it) {
+        if (pos._node == it._node || pos._node->prev == it._node)
+            return;
+        other._unlink(it._node, it._node);
+        _link(pos._node, it._node, it._node);
+        --other._size;
+        ++_size;
+    }
+
+    template<typename T>
+    void list<T>::splice(iterator pos, list &other, iterator first, iterator last) {
+        if (first == last)
+            return;
+        if (&other != this) {
+            size_t count = 0;
+            for (iterator it = first; it != last; ++it)
+                ++count;
+            other._size -= count;
+            _size += count;
+        }
+        Node *tail = last._node->prev;
+        other._unlink(first._node, tail);
+        _link(pos._node, first._node, tail);
+    }
+
+    template<typename T>
+    template<typename Compare>
+    void list<T>::merge(list &other, Compare comp) {
+        if (&other == this || other.empty())
+            return;
+
+        Node *node = _first;
+        while (!other.empty()) {
+            Node *candidate = other._first;
+            if (node == _last) {
+                splice(end(), other);
+                return;
+            }
+            if (comp(candidate->data, node->data))
+                splice(iterator(node), other, iterator(candidate));
+            else
+                node = node->next;
+        }
+    }
+
+    template<typename T>
+    template<typename Compare>
+    void list<T>::sort(Compare comp) {
+        if (_size < 2)
+            return;
+
+        // Bottom-up: bins[i] holds a sorted chain of 2^i nodes (or is empty). Each node is merged in like
+        // a binary counter increment, so equal runs are merged and a bin never holds later nodes than bins[i - 1].
+        Node *bins[64] = {};
+        size_t fill = 0;
+        _last->prev->next = nullptr;
+        Node *node = _first;
+        while (node) {
+            Node *next = node->next;
+            node->next = nullptr;
+
+            Node *carry = node;
+            size_t i = 0;
+            for (; i < fill && bins[i]; ++i) {
+                carry = _merge_chains(bins[i], carry, comp);
+                bins[i] = nullptr;
+            }
+            bins[i] = carry;
+            if (i == fill)
+                ++fill;
+            node = next;
+        }
+
+        Node *sorted = nullptr;
+        for (size_t i = 0; i < fill; ++i) {
+            if (bins[i])
+                sorted = sorted ? _merge_chains(bins[i], sorted, comp) : bins[i];
+        }
+
+        // restore the prev links, and the sentinel
+        Node *prev = nullptr;
+        _first = sorted;
+        for (node = sorted; node; node = node->next) {
+            node->prev = prev;
+            prev = node;
+        }
+        prev->next = _last;
+        _last->prev = prev;
+    }
+
+    template<typename T>
+    void list<T>::reverse() noexcept {
+        if (_size < 2)
+            return;
+        Node *old_first = _first;
+        Node *old_back = _last->prev;
+        for (Node *node = _first; node != _last;) {
+            Node *next = node->next;
+            std::swap(node->next, node->prev);
+            node = next;
+        }
+        _first = old_back;
+        _first->prev = nullptr;
+        old_first->next = _last;
+        _last->prev = old_first;
+    }
+
+    template<typename T>
+    template<typename BinaryPredicate>
+    size_t list<T>::unique(BinaryPredicate pred) {
+        if (_size < 2)
+            return 0;
+        size_t removed = 0;
+        Node *kept = _first;
+        Node *node = kept->next;
+        while (node != _last) {
+            Node *next = node->next;
+            if (pred(kept->data, node->data)) {
+                _unlink(node, node);
+                _destroy(node);
+                ++removed;
+            } else {
+                kept = node;
+            }
+            node = next;
+        }
+        _size -= removed;
+        return removed;
+    }
+
+    // LOCALITY
+
+    template<typename T>
+    void list<T>::compact() {
+        if (_size == 0)
+            return;
+
+        auto *slab = new _slab{nullptr, _size};
+        try {
+            slab->nodes = static_cast<Node *>(::operator new(_size * sizeof(Node), std::align_val_t(alignof(Node))));
+        } catch (...) {
+            delete slab;
+            throw;
+        }
+        // every element is moved before the old nodes are freed: if a move throws, the list keeps them.
+        size_t built = 0;
+        try {
+            for (Node *old = _first; old != _last; old = old->next, ++built) {
+                Node *prev = built ? slab->nodes + built - 1 : nullptr;
+                Node *node = new(static_cast<void *>(slab->nodes + built))Node(prev, nullptr, std::move(old->data));
+                node->slab = slab;
+                if (prev)
+                    prev->next = node;
+            }
+        } catch (...) {
+            while (built > 0) {
+                Node *node = slab->nodes + --built;
+                node->data.~T();
+                node->~Node();
+            }
+            _free_slab(slab);
+            throw;
+        }
+
+        for (Node *old = _first; old != _last;) {
+            Node *next = old->next;
+            _destroy(old);
+            old = next;
+        }
+        Node *last = slab->nodes + _size - 1;
+        _first = slab->nodes;
+        last->next = _last;
+        _last->prev = last;
+    }
+
+    template<typename T>
+    template<typename F>
+    void list<T>::for_each(F f) {
+        for (Node *node = _first; node != _last; node = node->next) {
+            // node->next is at worst the sentinel, whose next is null: prefetching null is harmless.
+            __builtin_prefetch(node->next->next);
+            f(node->data);
+        }
+    }
+
+    template<typename T>
+    template<typename F>
+    void list<T>::for_each(F f) const {
+        for (const Node *node = _first; node != _last; node = node->next) {
+            __builtin_prefetch(node->next->next);
+            f(node->data);
+        }
+    }
+
+    // PRIVATE
+
+    template<typename T>
+    void list<T>::_destroy(Node *node) {
+        node->data.~T();
+        _slab *slab = node->slab;
+        if (!slab) {
+            delete node;
+            return;
+        }
+        node->~Node();
+        if (--slab->live == 0)
+            _free_slab(slab);
+    }
+
+    template<typename T>
+    void list<T>::_free_slab(_slab *slab) {
+        ::operator delete(slab->nodes, std::align_val_t(alignof(Node)));
+        delete slab;
+    }
+
+    template<typename T>
+    void list<T>::_unlink(Node *first, Node *last) {
+        // `last` is never the sentinel, so it always has a next node.
+        if (first->prev)
+            first->prev->next = last->next;
+        else
+            _first = last->next;
+        last->next->prev = first->prev;
+    }
+
+    template<typename T>
+    void list<T>::_link(Node *pos, Node *first, Node *last) {
+        first->prev = pos->prev;
+        last->next = pos;
+        if (pos->prev)
+            pos->prev->next = first;
+        else
+            _first = first;
+        pos->prev = last;
+    }
+
+    template<typename T>
+    template<typename Compare>
+    typename list<T>::Node *list<T>::_merge_chains(Node *a, Node *b, Compare &comp) {
+        Node *head = nullptr;
+        Node **tail = &head;
+        while (a && b) {
+            // stable: `a` holds the earlier elements, it wins ties.
+            if (comp(b->data, a->data)) {
+                *tail = b;
+                b = b->next;
+            } else {
+                *tail = a;
+                a = a->next;
+            }
+            tail = &(*tail)->next;
+        }
+        *tail = a ? a : b;
+        return head;
+    }
+
 
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 //
 #pragma once
 
+#include <type_traits>
 #include "Utility.h"
 
 namespace rc {
@@ -104,7 +105,8 @@ namespace rc {
         using iterator_category = bidirectional_iterator_tag;
 
     private:
-        using Node = typename list<T>::Node;
+        // nodes of the list<T> this list_const_iterator<const T> walks
+        using Node = typename list<std::remove_const_t<T>>::Node;
         Node *_node;
 
     private:
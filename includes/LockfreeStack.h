@@ -0,0 +1,306 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include "Allocator.h"
+#include "Utility.h"
+
+namespace rc {
+    /**
+     * Unbounded lock-free LIFO stack (Treiber stack), usable as a free list shared between threads.
+     *
+     * The head is a single 64-bit word packing the top node's address (48 low bits) with a 16-bit version,
+     * bumped by every successful CAS: a pop racing with a pop / push / pop of the same node sees the version
+     * change and retries, instead of installing a stale `next` (ABA).
+     *
+     * Popped nodes are not freed while another thread may still read them: a pop publishes the node it is about
+     * to dereference in a hazard pointer, and popped nodes are retired, then freed in batches once no hazard
+     * pointer refers to them.
+     */
+    template<typename T, typename Alloc = rc::allocator<T>>
+    class lockfree_stack {
+        static_assert(sizeof(void *) == 8, "the tagged head packs a 48-bit pointer in 64 bits");
+
+    public:
+        using value_type = T;
+
+    private:
+        struct _node {
+            // atomic: a popping thread may read it while another thread that popped the node rewrites it.
+            std::atomic<_node *> next;
+            // constructed on push, destroyed on pop: the node memory itself lives until it is reclaimed.
+            union {
+                T value;
+            };
+
+            _node() {}
+
+            ~_node() {}
+        };
+
+        struct alignas(cache_line_size) _hazard {
+            std::atomic<_node *> pointer{nullptr};
+            std::atomic<bool> owned{false};
+        };
+
+        using _node_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_node>;
+
+        static constexpr size_t _hazard_count = 64;
+        // retired nodes are scanned by batches, so each scan frees at least half of them.
+        static constexpr size_t _scan_threshold = 2 * _hazard_count;
+        static constexpr uint64_t _pointer_mask = (uint64_t(1) << 48) - 1;
+
+        alignas(cache_line_size) std::atomic<uint64_t> _head{0};
+        alignas(cache_line_size) std::atomic<_node *> _retired{nullptr};
+        std::atomic<size_t> _retired_count{0};
+        _hazard _hazards[_hazard_count];
+
+    public:
+        lockfree_stack() = default;
+
+        lockfree_stack(lockfree_stack const &other) = delete;
+
+        lockfree_stack &operator=(lockfree_stack const &other) = delete;
+
+        // Not thread safe: no other thread may use the stack anymore.
+        ~lockfree_stack();
+
+    public:
+        void push(const T &value) { emplace(value); }
+
+        void push(T &&value) { emplace(std::move(value)); }
+
+        template<typename... Args>
+        void emplace(Args &&... args);
+
+        // Pushes [first, last) with a single CAS: the elements come out in reverse order, as if pushed one by one.
+        template<typename IT>
+        void push_chain(IT first, IT last);
+
+        // Moves the top element to `out`, or returns false if the stack is empty.
+        bool try_pop(T &out);
+
+        // Only a snapshot while other threads are running.
+        [[nodiscard]] bool empty() const noexcept { return _pointer(_head.load(std::memory_order_acquire)) == nullptr; }
+
+    private:
+        static _node *_pointer(uint64_t head) { return reinterpret_cast<_node *>(head & _pointer_mask); }
+
+        static uint64_t _pack(_node *node, uint64_t previous) {
+            // the version lives in the 16 high bits, and wraps around.
+            return reinterpret_cast<uintptr_t>(node) | ((previous & ~_pointer_mask) + (_pointer_mask + 1));
+        }
+
+        template<typename... Args>
+        static _node *_create(Args &&... args);
+
+        static void _free(_node *node);
+
+        // links the chain [top ... bottom] on top of the stack.
+        void _publish(_node *top, _node *bottom);
+
+        _hazard &_acquire_hazard();
+
+        void _retire(_node *node);
+
+        // frees the retired nodes no hazard pointer refers to.
+        void _scan();
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, typename Alloc>
+    lockfree_stack<T, Alloc>::~lockfree_stack() {
+        _node *node = _pointer(_head.load(std::memory_order_acquire));
+        while (node) {
+            _node *next = node->next.load(std::memory_order_relaxed);
+            node->value.~T();
+            _free(node);
+            node = next;
+        }
+        node = _retired.load(std::memory_order_acquire);
+        while (node) {
+            _node *next = node->next.load(std::memory_order_relaxed);
+            _free(node);
+            node = next;
+        }
+    }
+
+    template<typename T, typename Alloc>
+    template<typename... Args>
+    void lockfree_stack<T, Alloc>::emplace(Args &&... args) {
+        _node *node = _create(std::forward<Args>(args)...);
+        _publish(node, node);
+    }
+
+    template<typename T, typename Alloc>
+    template<typename IT>
+    void lockfree_stack<T, Alloc>::push_chain(IT first, IT last) {
+        if (first == last)
+            return;
+        // link the chain privately, the last element on top.
+        _node *bottom = _create(*first);
+        _node *top = bottom;
+        try {
+            for (++first; first != last; ++first) {
+                _node *node = _create(*first);
+                node->next.store(top, std::memory_order_relaxed);
+                top = node;
+            }
+        } catch (...) {
+            // the chain is still private: frees it.
+            while (top) {
+                _node *next = top->next.load(std::memory_order_relaxed);
+                top->value.~T();
+                _free(top);
+                top = next;
+            }
+            throw;
+        }
+        _publish(top, bottom);
+    }
+
+    template<typename T, typename Alloc>
+    bool lockfree_stack<T, Alloc>::try_pop(T &out) {
+        _hazard &hazard = _acquire_hazard();
+        uint64_t head = _head.load(std::memory_order_acquire);
+        _node *node;
+        while (true) {
+            node = _pointer(head);
+            if (!node)
+                break;
+
+            // protect the node, then check it is still the top: from now on, it can't be freed.
+            hazard.pointer.store(node, std::memory_order_seq_cst);
+            uint64_t current = _head.load(std::memory_order_seq_cst);
+            if (current != head) {
+                head = current;
+                continue;
+            }
+            // `next` may be stale if the node was popped meanwhile, but then the version changed and the CAS fails.
+            _node *next = node->next.load(std::memory_order_relaxed);
+            if (_head.compare_exchange_weak(head, _pack(next, head), std::memory_order_acq_rel,
+                                            std::memory_order_acquire))
+                break;
+        }
+        hazard.pointer.store(nullptr, std::memory_order_release);
+        hazard.owned.store(false, std::memory_order_release);
+        if (!node)
+            return false;
+
+        out = std::move(node->value);
+        node->value.~T();
+        _retire(node);
+        return true;
+    }
+
+    //      PRIVATE
+
+    template<typename T, typename Alloc>
+    template<typename... Args>
+    typename lockfree_stack<T, Alloc>::_node *lockfree_stack<T, Alloc>::_create(Args &&... args) {
+        _node_alloc alloc;
+        _node *node = alloc.allocate(1);
+        new(static_cast<void *>(node))_node;
+        try {
+            new(static_cast<void *>(&node->value))T(std::forward<Args>(args)...);
+        } catch (...) {
+            alloc.deallocate(node, 1);
+            throw;
+        }
+        node->next.store(nullptr, std::memory_order_relaxed);
+        return node;
+    }
+
+    template<typename T, typename Alloc>
+    void lockfree_stack<T, Alloc>::_free(_node *node) {
+        node->~_node();
+        _node_alloc alloc;
+        alloc.deallocate(node, 1);
+    }
+
+    template<typename T, typename Alloc>
+    void lockfree_stack<T, Alloc>::_publish(_node *top, _node *bottom) {
+        uint64_t head = _head.load(std::memory_order_relaxed);
+        do {
+            bottom->next.store(_pointer(head), std::memory_order_relaxed);
+        } while (!_head.compare_exchange_weak(head, _pack(top, head), std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    template<typename T, typename Alloc>
+    typename lockfree_stack<T, Alloc>::_hazard &lockfree_stack<T, Alloc>::_acquire_hazard() {
+        // each thread starts from its own slot, so it usually takes it at the first try.
+        thread_local const size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+        for (size_t i = 0;; ++i) {
+            _hazard &hazard = _hazards[(hint + i) % _hazard_count];
+            if (!hazard.owned.load(std::memory_order_relaxed) &&
+                !hazard.owned.exchange(true, std::memory_order_acquire))
+                return hazard;
+            if (i % _hazard_count == _hazard_count - 1)
+                std::this_thread::yield();
+        }
+    }
+
+    template<typename T, typename Alloc>
+    void lockfree_stack<T, Alloc>::_retire(_node *node) {
+        // the retired list is only pushed to, and taken whole by _scan(): no ABA.
+        _node *retired = _retired.load(std::memory_order_relaxed);
+        do {
+            node->next.store(retired, std::memory_order_relaxed);
+        } while (!_retired.compare_exchange_weak(retired, node, std::memory_order_release,
+                                                 std::memory_order_relaxed));
+        if (_retired_count.fetch_add(1, std::memory_order_relaxed) + 1 >= _scan_threshold)
+            _scan();
+    }
+
+    template<typename T, typename Alloc>
+    void lockfree_stack<T, Alloc>::_scan() {
+        _node *chain = _retired.exchange(nullptr, std::memory_order_acquire);
+        if (!chain)
+            return;
+
+        _node *protected_nodes[_hazard_count];
+        size_t protected_count = 0;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (auto &hazard: _hazards) {
+            if (_node *node = hazard.pointer.load(std::memory_order_seq_cst))
+                protected_nodes[protected_count++] = node;
+        }
+        std::sort(protected_nodes, protected_nodes + protected_count);
+
+        size_t taken = 0;
+        _node *kept = nullptr;
+        _node *kept_bottom = nullptr;
+        size_t kept_count = 0;
+        while (chain) {
+            _node *next = chain->next.load(std::memory_order_relaxed);
+            ++taken;
+            if (std::binary_search(protected_nodes, protected_nodes + protected_count, chain)) {
+                chain->next.store(kept, std::memory_order_relaxed);
+                if (!kept)
+                    kept_bottom = chain;
+                kept = chain;
+                ++kept_count;
+            } else {
+                _free(chain);
+            }
+            chain = next;
+        }
+        _retired_count.fetch_sub(taken - kept_count, std::memory_order_relaxed);
+
+        if (kept) {
+            _node *retired = _retired.load(std::memory_order_relaxed);
+            do {
+                kept_bottom->next.store(retired, std::memory_order_relaxed);
+            } while (!_retired.compare_exchange_weak(retired, kept, std::memory_order_release,
+                                                     std::memory_order_relaxed));
+        }
+    }
+}
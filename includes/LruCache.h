@@ -0,0 +1,342 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "HashMap.h"
+#include "List.h"
+#include "Utility.h"
+
+namespace rc {
+    struct lru_cache_stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+    };
+
+    /**
+     * Fixed capacity cache evicting the least recently used entry.
+     *
+     * The entries live in an rc::list ordered from the most to the least recently used, and a hash_map
+     * indexes the list nodes by key. A hit splices its node to the front; once full, an insertion reuses
+     * the node of the evicted entry, and an erased node is kept aside for the next insertion:
+     * after the cache filled up once, no operation allocates anymore. The key and value of an erased node are
+     * reset to K() and V(), releasing what they held (the node itself is freed if they can't be).
+     * Not thread safe: see sharded_lru_cache.
+     */
+    template<typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+    class lru_cache {
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        // the key is not const, so that a node can be reused for another key.
+        using value_type = Pair<K, V>;
+        using const_iterator = typename list<value_type>::const_iterator;
+
+    private:
+        using _list_iterator = typename list<value_type>::iterator;
+
+        list<value_type> _order; // most recently used first
+        list<value_type> _spare; // nodes of erased entries, reused before allocating
+        hash_map<K, _list_iterator, Hash, Eq> _index;
+        size_t _capacity;
+        lru_cache_stats _stats;
+
+    public:
+        // The index is sized for `capacity` entries once and for all.
+        explicit lru_cache(size_t capacity);
+
+        lru_cache(lru_cache const &other) = delete;
+
+        lru_cache &operator=(lru_cache const &other) = delete;
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _index.size(); }
+
+        [[nodiscard]] size_t capacity() const noexcept { return _capacity; }
+
+        [[nodiscard]] bool empty() const noexcept { return _index.empty(); }
+
+        //      LOOKUP
+
+        // The value of `key` marked as the most recently used, or nullptr. Counts a hit or a miss.
+        V *find(const K &key);
+
+        // Same as find(), without touching the recency order nor the counters.
+        V const *peek(const K &key) const;
+
+        bool contains(const K &key) const { return _index.contains(key); }
+
+        //      MODIFIERS
+
+        // Inserts or assigns the value of `key`, as the most recently used entry, evicting the least recently
+        // used one if the cache is full. If storing the new entry throws, the evicted one is still gone.
+        template<typename KK, typename... Args>
+        V &put(KK &&key, Args &&... args);
+
+        bool erase(const K &key);
+
+        // Keeps the nodes for the next insertions.
+        void clear();
+
+        //      STATISTICS
+
+        [[nodiscard]] lru_cache_stats stats() const noexcept { return _stats; }
+
+        void reset_stats() noexcept { _stats = lru_cache_stats(); }
+
+        //      ITERATORS
+        // From the most to the least recently used.
+
+        const_iterator begin() const noexcept { return _order.begin(); }
+
+        const_iterator end() const noexcept { return _order.end(); }
+
+    private:
+        // releases the entry of `node`, and keeps the node aside if possible.
+        void _release(_list_iterator node);
+    };
+
+    /**
+     * lru_cache split in independent shards, each behind its own mutex, picked by the hash of the key.
+     *
+     * Threads looking up different keys mostly take different locks. The recency order is per shard, so the
+     * evicted entry is the least recently used of its shard, not of the whole cache.
+     * Lookups return a copy, since a reference would outlive the lock.
+     */
+    template<typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+    class sharded_lru_cache {
+    private:
+        struct alignas(cache_line_size) _shard {
+            std::mutex mutex;
+            lru_cache<K, V, Hash, Eq> cache;
+
+            explicit _shard(size_t capacity) : cache(capacity) {}
+        };
+
+        std::unique_ptr<std::optional<_shard>[]> _shards;
+        size_t _shard_count;
+        Hash _hash;
+
+    public:
+        // `capacity` is split evenly between the shards (rounded up).
+        explicit sharded_lru_cache(size_t capacity, size_t shard_count = 16);
+
+        sharded_lru_cache(sharded_lru_cache const &other) = delete;
+
+        sharded_lru_cache &operator=(sharded_lru_cache const &other) = delete;
+
+    public:
+        [[nodiscard]] size_t shard_count() const noexcept { return _shard_count; }
+
+        // Locks every shard in turn: only a snapshot while other threads are running.
+        [[nodiscard]] size_t size() const;
+
+        std::optional<V> get(const K &key);
+
+        template<typename KK, typename... Args>
+        void put(KK &&key, Args &&... args);
+
+        bool erase(const K &key);
+
+        // Sum of the counters of the shards.
+        [[nodiscard]] lru_cache_stats stats() const;
+
+    private:
+        _shard &_shard_of(const K &key) const;
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    lru_cache<K, V, Hash, Eq>::lru_cache(size_t capacity) : _capacity(capacity) {
+        assert(capacity > 0 && "an lru_cache needs room for at least one entry");
+        _index.reserve(capacity);
+    }
+
+    //      LOOKUP
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    V *lru_cache<K, V, Hash, Eq>::find(const K &key) {
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            ++_stats.misses;
+            return nullptr;
+        }
+        ++_stats.hits;
+        _list_iterator node = it->second;
+        _order.splice(_order.begin(), _order, node);
+        return &node->second;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    V const *lru_cache<K, V, Hash, Eq>::peek(const K &key) const {
+        auto it = _index.find(key);
+        if (it == _index.end())
+            return nullptr;
+        return &it->second->second;
+    }
+
+    //      MODIFIERS
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    template<typename KK, typename... Args>
+    V &lru_cache<K, V, Hash, Eq>::put(KK &&key, Args &&... args) {
+        auto found = _index.find(key);
+        if (found != _index.end()) {
+            _list_iterator node = found->second;
+            node->second = V(std::forward<Args>(args)...);
+            _order.splice(_order.begin(), _order, node);
+            return node->second;
+        }
+
+        if (_index.size() < _capacity && _spare.empty()) {
+            _order.emplace_front(std::forward<KK>(key), V(std::forward<Args>(args)...));
+            try {
+                _index.try_emplace(_order.front().first, _order.begin());
+            } catch (...) {
+                _order.pop_front();
+                throw;
+            }
+            return _order.front().second;
+        }
+
+        // built before touching the cache, which stays unchanged if they throw.
+        K new_key(std::forward<KK>(key));
+        V value(std::forward<Args>(args)...);
+        _list_iterator node;
+        if (_index.size() < _capacity) {
+            node = _spare.begin();
+            _order.splice(_order.begin(), _spare, node);
+        } else {
+            // recycles the node of the least recently used entry.
+            node = _order.end();
+            --node;
+            _index.erase(node->first);
+            ++_stats.evictions;
+            _order.splice(_order.begin(), _order, node);
+        }
+        try {
+            node->first = std::move(new_key);
+            node->second = std::move(value);
+            _index.try_emplace(node->first, node);
+        } catch (...) {
+            // the node has no index entry anymore: it goes away, with the entry it held.
+            _list_iterator next = node;
+            ++next;
+            _order.erase(node, next);
+            throw;
+        }
+        return node->second;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    bool lru_cache<K, V, Hash, Eq>::erase(const K &key) {
+        auto found = _index.find(key);
+        if (found == _index.end())
+            return false;
+        _list_iterator node = found->second;
+        _index.erase(found);
+        _release(node);
+        return true;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    void lru_cache<K, V, Hash, Eq>::clear() {
+        _index.clear();
+        while (!_order.empty())
+            _release(_order.begin());
+    }
+
+    //      PRIVATE
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    void lru_cache<K, V, Hash, Eq>::_release(_list_iterator node) {
+        if constexpr (std::is_default_constructible_v<K> && std::is_default_constructible_v<V>) {
+            node->first = K();
+            node->second = V();
+            _spare.splice(_spare.begin(), _order, node);
+        } else {
+            _list_iterator next = node;
+            ++next;
+            _order.erase(node, next);
+        }
+    }
+
+    //      SHARDED
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    sharded_lru_cache<K, V, Hash, Eq>::sharded_lru_cache(size_t capacity, size_t shard_count)
+            : _shards(new std::optional<_shard>[shard_count]), _shard_count(shard_count) {
+        assert(shard_count > 0 && "a sharded_lru_cache needs at least one shard");
+        size_t per_shard = (capacity + shard_count - 1) / shard_count;
+        for (size_t i = 0; i < shard_count; ++i)
+            _shards[i].emplace(per_shard);
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    size_t sharded_lru_cache<K, V, Hash, Eq>::size() const {
+        size_t total = 0;
+        for (size_t i = 0; i < _shard_count; ++i) {
+            std::lock_guard<std::mutex> lock(_shards[i]->mutex);
+            total += _shards[i]->cache.size();
+        }
+        return total;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    std::optional<V> sharded_lru_cache<K, V, Hash, Eq>::get(const K &key) {
+        _shard &shard = _shard_of(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (V *value = shard.cache.find(key))
+            return *value;
+        return std::nullopt;
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    template<typename KK, typename... Args>
+    void sharded_lru_cache<K, V, Hash, Eq>::put(KK &&key, Args &&... args) {
+        _shard &shard = _shard_of(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.cache.put(std::forward<KK>(key), std::forward<Args>(args)...);
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    bool sharded_lru_cache<K, V, Hash, Eq>::erase(const K &key) {
+        _shard &shard = _shard_of(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.cache.erase(key);
+    }
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    lru_cache_stats sharded_lru_cache<K, V, Hash, Eq>::stats() const {
+        lru_cache_stats total;
+        for (size_t i = 0; i < _shard_count; ++i) {
+            std::lock_guard<std::mutex> lock(_shards[i]->mutex);
+            lru_cache_stats stats = _shards[i]->cache.stats();
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+            total.evictions += stats.evictions;
+        }
+        return total;
+    }
+
+    //      PRIVATE
+
+    template<typename K, typename V, typename Hash, typename Eq>
+    typename sharded_lru_cache<K, V, Hash, Eq>::_shard &
+    sharded_lru_cache<K, V, Hash, Eq>::_shard_of(const K &key) const {
+        // the high bits of the mixed hash: the shard's own index probes with the lower ones.
+        __uint128_t m = static_cast<__uint128_t>(_hash(key)) * 0x9E3779B97F4A7C15ull;
+        size_t hash = static_cast<size_t>(m ^ (m >> 64));
+        return *_shards[(hash >> 32) % _shard_count];
+    }
+}
@@ -0,0 +1,427 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include "Array.hpp"
+#include "Vector.h"
+
+namespace rc {
+    inline constexpr size_t dynamic_extent = static_cast<size_t>(-1);
+
+    /**
+     * The extents of a multidimensional index space, each one static (a template argument) or dynamic
+     * (`dynamic_extent`, given at construction).
+     */
+    template<size_t... E>
+    class extents {
+        static_assert(sizeof...(E) > 0, "extents need at least one dimension");
+
+    public:
+        static constexpr size_t rank() noexcept { return sizeof...(E); }
+
+        static constexpr size_t rank_dynamic() noexcept { return ((E == dynamic_extent) + ... + 0); }
+
+        static constexpr size_t static_extent(size_t r) noexcept {
+            constexpr size_t e[] = {E...};
+            return e[r];
+        }
+
+    private:
+        // static extents are stored too, but extent() reads them from the template arguments.
+        array<size_t, sizeof...(E)> _extents{(E == dynamic_extent ? 0 : E)...};
+
+    public:
+        // The dynamic extents are 0.
+        constexpr extents() noexcept = default;
+
+        // One size per dynamic extent, in order.
+        template<typename... I, typename = std::enable_if_t<
+                sizeof...(I) == rank_dynamic() && rank_dynamic() != 0 && (std::is_integral_v<I> && ...)>>
+        constexpr explicit extents(I... dynamic) noexcept {
+            size_t sizes[] = {static_cast<size_t>(dynamic)...};
+            size_t next = 0;
+            for (size_t r = 0; r < rank(); ++r) {
+                if (static_extent(r) == dynamic_extent)
+                    _extents[r] = sizes[next++];
+            }
+        }
+
+        constexpr size_t extent(size_t r) const noexcept {
+            return static_extent(r) == dynamic_extent ? _extents[r] : static_extent(r);
+        }
+
+        // number of elements
+        constexpr size_t size() const noexcept {
+            size_t size = 1;
+            for (size_t r = 0; r < rank(); ++r)
+                size *= extent(r);
+            return size;
+        }
+
+        constexpr bool operator==(extents const &rhs) const noexcept {
+            for (size_t r = 0; r < rank(); ++r) {
+                if (extent(r) != rhs.extent(r))
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    template<size_t R, size_t... E>
+    struct _dextents : _dextents<R - 1, dynamic_extent, E...> {
+    };
+
+    template<size_t... E>
+    struct _dextents<0, E...> {
+        using type = extents<E...>;
+    };
+
+    // R dynamic extents.
+    template<size_t R>
+    using dextents = typename _dextents<R>::type;
+
+    //      LAYOUTS
+    // A layout maps a multidimensional index to an offset in the storage, through its nested mapping<Extents>.
+
+    // Row major, the last index is contiguous (C arrays).
+    struct layout_right {
+        template<typename Extents>
+        class mapping {
+            Extents _extents;
+
+        public:
+            constexpr mapping() = default;
+
+            constexpr mapping(Extents const &ext) : _extents(ext) {}
+
+            constexpr Extents const &extents() const noexcept { return _extents; }
+
+            template<typename... I>
+            constexpr size_t operator()(I... idx) const noexcept {
+                static_assert(sizeof...(I) == Extents::rank(), "one index per dimension");
+                size_t indices[] = {static_cast<size_t>(idx)...};
+                size_t offset = 0;
+                for (size_t r = 0; r < Extents::rank(); ++r)
+                    offset = offset * _extents.extent(r) + indices[r];
+                return offset;
+            }
+
+            constexpr size_t stride(size_t r) const noexcept {
+                size_t stride = 1;
+                for (size_t i = r + 1; i < Extents::rank(); ++i)
+                    stride *= _extents.extent(i);
+                return stride;
+            }
+
+            constexpr size_t required_span_size() const noexcept { return _extents.size(); }
+        };
+    };
+
+    // Column major, the first index is contiguous (Fortran arrays).
+    struct layout_left {
+        template<typename Extents>
+        class mapping {
+            Extents _extents;
+
+        public:
+            constexpr mapping() = default;
+
+            constexpr mapping(Extents const &ext) : _extents(ext) {}
+
+            constexpr Extents const &extents() const noexcept { return _extents; }
+
+            template<typename... I>
+            constexpr size_t operator()(I... idx) const noexcept {
+                static_assert(sizeof...(I) == Extents::rank(), "one index per dimension");
+                size_t indices[] = {static_cast<size_t>(idx)...};
+                size_t offset = 0;
+                for (size_t r = Extents::rank(); r; --r)
+                    offset = offset * _extents.extent(r - 1) + indices[r - 1];
+                return offset;
+            }
+
+            constexpr size_t stride(size_t r) const noexcept {
+                size_t stride = 1;
+                for (size_t i = 0; i < r; ++i)
+                    stride *= _extents.extent(i);
+                return stride;
+            }
+
+            constexpr size_t required_span_size() const noexcept { return _extents.size(); }
+        };
+    };
+
+    // Arbitrary strides, in elements: what a subview of a row or column major span is.
+    struct layout_stride {
+        template<typename Extents>
+        class mapping {
+            Extents _extents;
+            array<size_t, Extents::rank()> _strides{};
+
+        public:
+            constexpr mapping() = default;
+
+            constexpr mapping(Extents const &ext, array<size_t, Extents::rank()> const &strides)
+                    : _extents(ext), _strides(strides) {}
+
+            constexpr Extents const &extents() const noexcept { return _extents; }
+
+            template<typename... I>
+            constexpr size_t operator()(I... idx) const noexcept {
+                static_assert(sizeof...(I) == Extents::rank(), "one index per dimension");
+                size_t indices[] = {static_cast<size_t>(idx)...};
+                size_t offset = 0;
+                for (size_t r = 0; r < Extents::rank(); ++r)
+                    offset += indices[r] * _strides[r];
+                return offset;
+            }
+
+            constexpr size_t stride(size_t r) const noexcept { return _strides[r]; }
+
+            constexpr size_t required_span_size() const noexcept {
+                size_t last = 0;
+                for (size_t r = 0; r < Extents::rank(); ++r) {
+                    if (_extents.extent(r) == 0)
+                        return 0;
+                    last += (_extents.extent(r) - 1) * _strides[r];
+                }
+                return last + 1;
+            }
+        };
+    };
+
+    /**
+     * Two dimensions cut in B x B tiles, each one contiguous and row major, the tiles themselves in row major
+     * order: neighbours along both the rows and the columns are close in memory, so a pass in either direction
+     * touches B times fewer cache lines than a column pass over a row major matrix.
+     * The extents are padded up to a multiple of B.
+     */
+    template<size_t B = 16>
+    struct layout_blocked {
+        static_assert(B && (B & (B - 1)) == 0, "the tile size must be a power of two");
+
+        template<typename Extents>
+        class mapping {
+            static_assert(Extents::rank() == 2, "layout_blocked only tiles matrices");
+
+            Extents _extents;
+            size_t _tiles_per_row = 0;
+
+        public:
+            constexpr mapping() = default;
+
+            constexpr mapping(Extents const &ext) : _extents(ext), _tiles_per_row((ext.extent(1) + B - 1) / B) {}
+
+            constexpr Extents const &extents() const noexcept { return _extents; }
+
+            constexpr size_t operator()(size_t i, size_t j) const noexcept {
+                size_t tile = (i / B) * _tiles_per_row + j / B;
+                return tile * B * B + (i % B) * B + j % B;
+            }
+
+            constexpr size_t required_span_size() const noexcept {
+                return (_extents.extent(0) + B - 1) / B * _tiles_per_row * B * B;
+            }
+        };
+    };
+
+    /**
+     * Non owning multidimensional view of contiguous storage, like C++23 std::mdspan: `span(i, j)`.
+     */
+    template<typename T, typename Extents, typename Layout = layout_right>
+    class mdspan {
+    public:
+        using element_type = T;
+        using extents_type = Extents;
+        using layout_type = Layout;
+        using mapping_type = typename Layout::template mapping<Extents>;
+
+    private:
+        T *_data = nullptr;
+        mapping_type _mapping;
+
+    public:
+        constexpr mdspan() = default;
+
+        constexpr mdspan(T *data, mapping_type const &mapping) : _data(data), _mapping(mapping) {}
+
+        constexpr mdspan(T *data, Extents const &ext) : _data(data), _mapping(ext) {}
+
+        // One size per dynamic extent.
+        template<typename... I, typename = std::enable_if_t<
+                sizeof...(I) == Extents::rank_dynamic() && (std::is_integral_v<I> && ...)>>
+        constexpr explicit mdspan(T *data, I... dynamic) : _data(data), _mapping(Extents(dynamic...)) {}
+
+        // mdspan<T> -> mdspan<const T>
+        template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+        constexpr mdspan(mdspan<U, Extents, Layout> const &other) : _data(other.data()), _mapping(other.mapping()) {}
+
+    public:
+        template<typename... I>
+        constexpr T &operator()(I... idx) const { return _data[_mapping(idx...)]; }
+
+        static constexpr size_t rank() noexcept { return Extents::rank(); }
+
+        constexpr size_t extent(size_t r) const noexcept { return _mapping.extents().extent(r); }
+
+        constexpr Extents const &extents() const noexcept { return _mapping.extents(); }
+
+        // number of elements
+        constexpr size_t size() const noexcept { return _mapping.extents().size(); }
+
+        constexpr size_t stride(size_t r) const noexcept { return _mapping.stride(r); }
+
+        constexpr T *data() const noexcept { return _data; }
+
+        constexpr mapping_type const &mapping() const noexcept { return _mapping; }
+    };
+
+    /**
+     * Multidimensional array owning its elements, stored in an rc::vector laid out by `Layout`:
+     * `rc::mdarray<float, rc::extents<1024, 1024>, rc::layout_blocked<>>`.
+     */
+    template<typename T, typename Extents, typename Layout = layout_right>
+    class mdarray {
+    public:
+        using element_type = T;
+        using extents_type = Extents;
+        using layout_type = Layout;
+        using mapping_type = typename Layout::template mapping<Extents>;
+        using view_type = mdspan<T, Extents, Layout>;
+        using const_view_type = mdspan<const T, Extents, Layout>;
+
+    private:
+        mapping_type _mapping;
+        vector<T> _storage;
+
+    public:
+        // Every element, padding included, is initialized to `value`.
+        explicit mdarray(Extents const &ext = Extents(), const T &value = T());
+
+        // One size per dynamic extent.
+        template<typename... I, typename = std::enable_if_t<
+                sizeof...(I) == Extents::rank_dynamic() && Extents::rank_dynamic() != 0 &&
+                (std::is_integral_v<I> && ...)>>
+        explicit mdarray(I... dynamic) : mdarray(Extents(dynamic...)) {}
+
+    public:
+        template<typename... I>
+        T &operator()(I... idx) { return _storage[_mapping(idx...)]; }
+
+        template<typename... I>
+        const T &operator()(I... idx) const { return _storage[_mapping(idx...)]; }
+
+        static constexpr size_t rank() noexcept { return Extents::rank(); }
+
+        size_t extent(size_t r) const noexcept { return _mapping.extents().extent(r); }
+
+        Extents const &extents() const noexcept { return _mapping.extents(); }
+
+        // number of elements
+        size_t size() const noexcept { return _mapping.extents().size(); }
+
+        // number of stored elements, padding included
+        size_t container_size() const noexcept { return _storage.size(); }
+
+        T *data() noexcept { return _storage.data(); }
+
+        const T *data() const noexcept { return _storage.data(); }
+
+        mapping_type const &mapping() const noexcept { return _mapping; }
+
+        view_type view() noexcept { return view_type(data(), _mapping); }
+
+        const_view_type view() const noexcept { return const_view_type(data(), _mapping); }
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, typename Extents, typename Layout>
+    mdarray<T, Extents, Layout>::mdarray(Extents const &ext, const T &value) : _mapping(ext) {
+        _storage.resize(_mapping.required_span_size(), value);
+    }
+
+    //      SUBVIEWS
+
+    template<typename Mapping, typename Indices, size_t... R>
+    constexpr size_t _offset_of(Mapping const &mapping, Indices const &indices, std::index_sequence<R...>) {
+        return mapping(indices[R]...);
+    }
+
+    /**
+     * The box of `sizes` elements starting at `offsets`, as a strided view of the same rank.
+     * The layout must have strides, which layout_blocked has not.
+     */
+    template<typename T, typename Extents, typename Layout>
+    constexpr mdspan<T, dextents<Extents::rank()>, layout_stride>
+    subview(mdspan<T, Extents, Layout> const &span, array<size_t, Extents::rank()> const &offsets,
+            array<size_t, Extents::rank()> const &sizes) {
+        constexpr size_t R = Extents::rank();
+        array<size_t, R> strides{};
+        for (size_t r = 0; r < R; ++r) {
+            assert(offsets[r] + sizes[r] <= span.extent(r) && "subview out of bounds");
+            strides[r] = span.stride(r);
+        }
+        auto ext = [&]<size_t... I>(std::index_sequence<I...>) {
+            return dextents<R>(sizes[I]...);
+        }(std::make_index_sequence<R>());
+        T *origin = span.data() + _offset_of(span.mapping(), offsets, std::make_index_sequence<R>());
+        return mdspan<T, dextents<R>, layout_stride>(origin, layout_stride::mapping<dextents<R>>(ext, strides));
+    }
+
+    //      KERNELS
+    // Matrix passes walking tiles small enough for both the source and the destination tile to stay in L1,
+    // whatever the two layouts: one of them is always read or written against its contiguous direction.
+
+    inline constexpr size_t md_kernel_tile = 32;
+
+    // dst(j, i) = src(i, j)
+    template<typename T, typename SE, typename SL, typename U, typename DE, typename DL>
+    void transpose(mdspan<T, SE, SL> const &src, mdspan<U, DE, DL> const &dst) {
+        static_assert(SE::rank() == 2 && DE::rank() == 2, "transpose() takes matrices");
+        assert(src.extent(0) == dst.extent(1) && src.extent(1) == dst.extent(0) && "transposed extents expected");
+        size_t rows = src.extent(0);
+        size_t cols = src.extent(1);
+        for (size_t ii = 0; ii < rows; ii += md_kernel_tile) {
+            size_t i_end = ii + md_kernel_tile < rows ? ii + md_kernel_tile : rows;
+            for (size_t jj = 0; jj < cols; jj += md_kernel_tile) {
+                size_t j_end = jj + md_kernel_tile < cols ? jj + md_kernel_tile : cols;
+                for (size_t i = ii; i < i_end; ++i) {
+                    for (size_t j = jj; j < j_end; ++j)
+                        dst(j, i) = src(i, j);
+                }
+            }
+        }
+    }
+
+    // dst(i, j) = src(i, j), converting between layouts.
+    template<typename T, typename SE, typename SL, typename U, typename DE, typename DL>
+    void copy(mdspan<T, SE, SL> const &src, mdspan<U, DE, DL> const &dst) {
+        static_assert(SE::rank() == DE::rank(), "copy() needs spans of the same rank");
+        for (size_t r = 0; r < SE::rank(); ++r)
+            assert(src.extent(r) == dst.extent(r) && "copy() needs spans of the same extents");
+
+        if constexpr (std::is_same_v<SL, DL> && !std::is_same_v<SL, layout_stride>) {
+            // same mapping: the storage is copied as is.
+            size_t span = src.mapping().required_span_size();
+            for (size_t i = 0; i < span; ++i)
+                dst.data()[i] = src.data()[i];
+        } else {
+            static_assert(SE::rank() == 2, "copy() only converts the layout of matrices");
+            size_t rows = src.extent(0);
+            size_t cols = src.extent(1);
+            for (size_t ii = 0; ii < rows; ii += md_kernel_tile) {
+                size_t i_end = ii + md_kernel_tile < rows ? ii + md_kernel_tile : rows;
+                for (size_t jj = 0; jj < cols; jj += md_kernel_tile) {
+                    size_t j_end = jj + md_kernel_tile < cols ? jj + md_kernel_tile : cols;
+                    for (size_t i = ii; i < i_end; ++i) {
+                        for (size_t j = jj; j < j_end; ++j)
+                            dst(i, j) = src(i, j);
+                    }
+                }
+            }
+        }
+    }
+}
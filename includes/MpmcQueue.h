@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <new>
+#include "Allocator.h"
+#include "Utility.h"
+
+namespace rc {
+    /**
+     * Bounded, lock-free, multi producer / multi consumer queue.
+     *
+     * Every cell carries a sequence number telling which lap of the ring it is ready for:
+     * `pos` when it is free for the producer that claimed `pos`, `pos + 1` once that element is published,
+     * and `pos + capacity` once consumed. Producers and consumers only contend on their own position counter,
+     * each on its own cache line, and a single CAS claims a cell.
+     *
+     * @tparam Blocking enables push()/pop(), which sleep on a futex (std::atomic::wait) while the queue is
+     * full / empty. It costs a fence per operation to detect sleeping threads, so it is opt-in.
+     */
+    template<typename T, bool Blocking = false, typename Alloc = rc::allocator<T>>
+    class mpmc_queue {
+    public:
+        using value_type = T;
+
+    private:
+        struct _cell {
+            std::atomic<size_t> sequence;
+            alignas(T) unsigned char bytes[sizeof(T)];
+
+            T *data() { return reinterpret_cast<T *>(bytes); }
+        };
+
+        using _cell_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_cell>;
+
+        // read-only after construction, shared by everybody
+        _cell *_cells;
+        size_t _mask;
+
+        alignas(cache_line_size) std::atomic<size_t> _enqueue_pos{0};
+        alignas(cache_line_size) std::atomic<size_t> _dequeue_pos{0};
+
+        // blocking mode only: the epochs are the futex words, bumped when a sleeping thread has to be woken up.
+        alignas(cache_line_size) std::atomic<uint32_t> _push_epoch{0};
+        std::atomic<uint32_t> _waiting_consumers{0};
+        alignas(cache_line_size) std::atomic<uint32_t> _pop_epoch{0};
+        std::atomic<uint32_t> _waiting_producers{0};
+
+    public:
+        // The capacity is rounded up to a power of two, and allocated once.
+        explicit mpmc_queue(size_t capacity);
+
+        mpmc_queue(mpmc_queue const &other) = delete;
+
+        mpmc_queue &operator=(mpmc_queue const &other) = delete;
+
+        ~mpmc_queue();
+
+    public:
+
+        //      NON BLOCKING
+
+        // Adds an element, or returns false if the queue is full.
+        bool try_push(const T &value) { return try_emplace(value); }
+
+        bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+        template<typename... Args>
+        bool try_emplace(Args &&... args);
+
+        // Moves the oldest element to `out`, or returns false if the queue is empty.
+        bool try_pop(T &out);
+
+        //      BLOCKING
+
+        // Waits for a free cell.
+        void push(const T &value);
+
+        void push(T &&value);
+
+        // Waits for an element.
+        T pop();
+
+        //      CAPACITY
+
+        // Only a snapshot while other threads are running.
+        [[nodiscard]] size_t size() const noexcept;
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] size_t capacity() const noexcept { return _mask + 1; }
+
+    private:
+        // wakes the threads sleeping on `epoch`, if any.
+        void _notify(std::atomic<uint32_t> &waiters, std::atomic<uint32_t> &epoch);
+
+        // retries `attempt` until it succeeds, sleeping on `epoch` in between.
+        template<typename F>
+        void _wait_until(std::atomic<uint32_t> &waiters, std::atomic<uint32_t> &epoch, F &&attempt);
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, bool Blocking, typename Alloc>
+    mpmc_queue<T, Blocking, Alloc>::mpmc_queue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+
+        _cell_alloc alloc;
+        _cells = alloc.allocate(size);
+        _mask = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            new(static_cast<void *>(_cells + i))_cell;
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template<typename T, bool Blocking, typename Alloc>
+    mpmc_queue<T, Blocking, Alloc>::~mpmc_queue() {
+        size_t end = _enqueue_pos.load(std::memory_order_relaxed);
+        for (size_t pos = _dequeue_pos.load(std::memory_order_relaxed); pos != end; ++pos)
+            _cells[pos & _mask].data()->~T();
+
+        _cell_alloc alloc;
+        alloc.deallocate(_cells, _mask + 1);
+    }
+
+    //      NON BLOCKING
+
+    template<typename T, bool Blocking, typename Alloc>
+    template<typename... Args>
+    bool mpmc_queue<T, Blocking, Alloc>::try_emplace(Args &&... args) {
+        _cell *cell;
+        size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = _cells + (pos & _mask);
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                // the cell is free for this lap: claim it.
+                if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                // the cell still holds the element of the previous lap: full.
+                return false;
+            } else {
+                // another producer claimed it first.
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        new(static_cast<void *>(cell->data()))T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        _notify(_waiting_consumers, _push_epoch);
+        return true;
+    }
+
+    template<typename T, bool Blocking, typename Alloc>
+    bool mpmc_queue<T, Blocking, Alloc>::try_pop(T &out) {
+        _cell *cell;
+        size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = _cells + (pos & _mask);
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<ptrdiff_t>(sequence - (pos + 1));
+            if (diff == 0) {
+                if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                // nothing published in this cell yet: empty.
+                return false;
+            } else {
+                pos = _dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        out = std::move(*cell->data());
+        cell->data()->~T();
+        // frees the cell for the producer of the next lap.
+        cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+        _notify(_waiting_producers, _pop_epoch);
+        return true;
+    }
+
+    //      BLOCKING
+
+    template<typename T, bool Blocking, typename Alloc>
+    void mpmc_queue<T, Blocking, Alloc>::push(const T &value) {
+        static_assert(Blocking, "push() requires a mpmc_queue<T, true>");
+        _wait_until(_waiting_producers, _pop_epoch, [&] { return try_emplace(value); });
+    }
+
+    template<typename T, bool Blocking, typename Alloc>
+    void mpmc_queue<T, Blocking, Alloc>::push(T &&value) {
+        static_assert(Blocking, "push() requires a mpmc_queue<T, true>");
+        // `value` is only moved from once a cell has been claimed.
+        _wait_until(_waiting_producers, _pop_epoch, [&] { return try_emplace(std::move(value)); });
+    }
+
+    template<typename T, bool Blocking, typename Alloc>
+    T mpmc_queue<T, Blocking, Alloc>::pop() {
+        static_assert(Blocking, "pop() requires a mpmc_queue<T, true>");
+        T value;
+        _wait_until(_waiting_consumers, _push_epoch, [&] { return try_pop(value); });
+        return value;
+    }
+
+    //      CAPACITY
+
+    template<typename T, bool Blocking, typename Alloc>
+    size_t mpmc_queue<T, Blocking, Alloc>::size() const noexcept {
+        size_t head = _dequeue_pos.load(std::memory_order_acquire);
+        size_t tail = _enqueue_pos.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    //      PRIVATE
+
+    template<typename T, bool Blocking, typename Alloc>
+    void mpmc_queue<T, Blocking, Alloc>::_notify(std::atomic<uint32_t> &waiters, std::atomic<uint32_t> &epoch) {
+        if constexpr (Blocking) {
+            // Pairs with the fence of _wait_until(): either the sleeper sees our element,
+            // or we see the sleeper and wake it up.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed)) {
+                epoch.fetch_add(1, std::memory_order_release);
+                epoch.notify_all();
+            }
+        }
+    }
+
+    template<typename T, bool Blocking, typename Alloc>
+    template<typename F>
+    void mpmc_queue<T, Blocking, Alloc>::_wait_until(std::atomic<uint32_t> &waiters, std::atomic<uint32_t> &epoch,
+                                                     F &&attempt) {
+        if (attempt())
+            return;
+        while (true) {
+            uint32_t seen = epoch.load(std::memory_order_acquire);
+            waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            bool done = attempt();
+            if (!done)
+                epoch.wait(seen, std::memory_order_acquire);
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+            if (done)
+                return;
+        }
+    }
+}
@@ -0,0 +1,612 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cstdint>
+#include <cassert>
+#include <bit>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "Utility.h"
+#include "Vector.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace rc {
+    /**
+     * Vector of unsigned integers stored with a fixed number of bits each, back to back in 64 bit words.
+     *
+     * The width is chosen at construction, and widened (the whole vector is repacked) when a value
+     * that doesn't fit is stored. Elements are returned by value: there is no reference to a packed integer.
+     */
+    class packed_int_vector {
+    public:
+        using value_type = uint64_t;
+
+        class const_iterator;
+
+    private:
+        vector<uint64_t> _words;
+        size_t _size = 0;
+        unsigned _width;
+
+    public:
+        explicit packed_int_vector(unsigned width = 1);
+
+        packed_int_vector(size_t count, uint64_t value);
+
+        packed_int_vector(std::initializer_list<uint64_t> list);
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+        // bits per element
+        [[nodiscard]] unsigned width() const noexcept { return _width; }
+
+        // bytes of packed data
+        [[nodiscard]] size_t bytes() const noexcept { return _words.size() * sizeof(uint64_t); }
+
+        void reserve(size_t count) { _words.reserve(_word_count(count, _width)); }
+
+        // Repacks every element with `width` bits, if it is larger than the current width.
+        void widen(unsigned width);
+
+        //      ELEMENT ACCESS
+
+        uint64_t operator[](size_t i) const noexcept;
+
+        uint64_t at(size_t i) const;
+
+        uint64_t back() const { return (*this)[_size - 1]; }
+
+        //      MODIFIERS
+
+        // Widens the vector first if `value` doesn't fit.
+        void set(size_t i, uint64_t value);
+
+        void push_back(uint64_t value);
+
+        void pop_back();
+
+        void resize(size_t count, uint64_t value = 0);
+
+        void clear() noexcept;
+
+        //      ITERATORS
+
+        const_iterator begin() const noexcept;
+
+        const_iterator end() const noexcept;
+
+    private:
+        static size_t _word_count(size_t count, unsigned width) { return (count * width + 63) / 64; }
+
+        static uint64_t _mask(unsigned width) { return width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1; }
+
+        static unsigned _bits(uint64_t value) { return value ? static_cast<unsigned>(std::bit_width(value)) : 1; }
+
+        // writes `value` at `i`, which must fit in the current width, over zeroed bits.
+        void _put(size_t i, uint64_t value) noexcept;
+    };
+
+    class packed_int_vector::const_iterator {
+        friend class packed_int_vector;
+
+    public:
+        using value_type = uint64_t;
+        using difference_type = ptrdiff_t;
+        using iterator_category = random_access_iterator_tag;
+
+    private:
+        const packed_int_vector *_vector = nullptr;
+        size_t _index = 0;
+
+        const_iterator(const packed_int_vector *vector, size_t index) : _vector(vector), _index(index) {}
+
+    public:
+        const_iterator() = default;
+
+        uint64_t operator*() const { return (*_vector)[_index]; }
+
+        uint64_t operator[](difference_type n) const { return (*_vector)[_index + n]; }
+
+        const_iterator &operator++() {
+            ++_index;
+            return *this;
+        }
+
+        const_iterator operator++(int) { return const_iterator(_vector, _index++); }
+
+        const_iterator &operator--() {
+            --_index;
+            return *this;
+        }
+
+        const_iterator operator--(int) { return const_iterator(_vector, _index--); }
+
+        const_iterator &operator+=(difference_type n) {
+            _index += n;
+            return *this;
+        }
+
+        const_iterator operator+(difference_type n) const { return const_iterator(_vector, _index + n); }
+
+        const_iterator operator-(difference_type n) const { return const_iterator(_vector, _index - n); }
+
+        difference_type operator-(const_iterator const &other) const {
+            return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+        }
+
+        bool operator==(const_iterator const &other) const { return _index == other._index; }
+
+        bool operator!=(const_iterator const &other) const { return _index != other._index; }
+
+        bool operator<(const_iterator const &other) const { return _index < other._index; }
+    };
+
+    /**
+     * Sorted sequence of 64 bit integers, compressed in blocks of 128 (the BP128 scheme).
+     *
+     * A block keeps its first value (the frame of reference) uncompressed, and bit-packs the differences
+     * between its values with the smallest width that holds the largest one. The differences are taken 4
+     * values apart (value i minus value i - 4), and stored in 4 interleaved lanes: 4 values are then unpacked
+     * and added to the previous 4 with single SSE2 instructions. Blocks whose differences don't fit 32 bits
+     * are stored uncompressed.
+     *
+     * The first values double as skip pointers: a lookup binary searches them, then decodes a single block.
+     * The last, partial block is buffered uncompressed until it is full.
+     */
+    class packed_sorted_vector {
+    public:
+        using value_type = uint64_t;
+
+        static constexpr size_t block_size = 128;
+
+        class const_iterator;
+
+    private:
+        // width of a block stored uncompressed
+        static constexpr unsigned _raw = 64;
+
+        struct _block {
+            uint64_t first;
+            // position of the block in _data, in 32 bit words
+            size_t offset;
+            unsigned width;
+        };
+
+        vector<_block> _blocks;
+        // 4 * width words per packed block, or 2 * block_size for an uncompressed one.
+        vector<uint32_t> _data;
+        vector<uint64_t> _tail;
+
+    public:
+        packed_sorted_vector() = default;
+
+        // [first, last) must be sorted.
+        template<typename IT, typename = std::enable_if_t<!std::is_integral_v<IT>>>
+        packed_sorted_vector(IT first, IT last);
+
+        packed_sorted_vector(std::initializer_list<uint64_t> list) : packed_sorted_vector(list.begin(), list.end()) {}
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _blocks.size() * block_size + _tail.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        // number of blocks, the partial one included.
+        [[nodiscard]] size_t block_count() const noexcept { return _blocks.size() + !_tail.empty(); }
+
+        // bytes of compressed data, block headers and partial block included.
+        [[nodiscard]] size_t bytes() const noexcept {
+            return _blocks.size() * sizeof(_block) + _data.size() * sizeof(uint32_t) + _tail.size() * sizeof(uint64_t);
+        }
+
+        //      ELEMENT ACCESS
+
+        // Decodes a single value: O(block_size / 4).
+        uint64_t operator[](size_t i) const;
+
+        uint64_t at(size_t i) const;
+
+        uint64_t back() const { return (*this)[size() - 1]; }
+
+        // Decodes block `b` into `out`, and returns its number of values.
+        size_t decode(size_t b, uint64_t *out) const;
+
+        //      LOOKUP
+
+        // Position of the first value not less than `value`, or size().
+        size_t lower_bound(uint64_t value) const;
+
+        bool contains(uint64_t value) const {
+            size_t i = lower_bound(value);
+            return i < size() && (*this)[i] == value;
+        }
+
+        //      MODIFIERS
+
+        // `value` must not be less than back().
+        void push_back(uint64_t value);
+
+        void clear() noexcept;
+
+        //      ITERATORS
+
+        const_iterator begin() const;
+
+        const_iterator end() const;
+
+    private:
+        void _flush();
+
+        template<unsigned W>
+        static void _unpack(const uint32_t *in, uint64_t first, uint64_t *out);
+
+        // lane sum of the packed differences up to value `i` of the block.
+        static uint64_t _value(const uint32_t *in, unsigned width, uint64_t first, size_t i);
+    };
+
+    /**
+     * Forward iterator decoding a whole block at a time.
+     * It holds the decoded block: prefer to keep it rather than to copy it.
+     */
+    class packed_sorted_vector::const_iterator {
+        friend class packed_sorted_vector;
+
+    public:
+        using value_type = uint64_t;
+        using difference_type = ptrdiff_t;
+        using iterator_category = forward_iterator_tag;
+
+    private:
+        const packed_sorted_vector *_vector = nullptr;
+        size_t _index = 0;
+        size_t _count = 0;
+        size_t _pos = 0;
+        uint64_t _buffer[block_size];
+
+        const_iterator(const packed_sorted_vector *vector, size_t index) : _vector(vector), _index(index) {}
+
+        void _load() {
+            _count = _vector->decode(_index / block_size, _buffer);
+            _pos = 0;
+        }
+
+    public:
+        const_iterator() = default;
+
+        uint64_t operator*() const { return _buffer[_pos]; }
+
+        const_iterator &operator++() {
+            ++_index;
+            if (++_pos == _count && _index < _vector->size())
+                _load();
+            return *this;
+        }
+
+        bool operator==(const_iterator const &other) const { return _index == other._index; }
+
+        bool operator!=(const_iterator const &other) const { return _index != other._index; }
+    };
+
+    //              IMPLEMENTATIONS
+
+    //      PACKED INT VECTOR
+
+    inline packed_int_vector::packed_int_vector(unsigned width) : _width(width) {
+        if (width == 0 || width > 64)
+            throw std::out_of_range("width must be between 1 and 64");
+    }
+
+    inline packed_int_vector::packed_int_vector(size_t count, uint64_t value) : _width(_bits(value)) {
+        resize(count, value);
+    }
+
+    inline packed_int_vector::packed_int_vector(std::initializer_list<uint64_t> list) : _width(1) {
+        uint64_t max = 0;
+        for (uint64_t value: list)
+            max |= value;
+        _width = _bits(max);
+        reserve(list.size());
+        for (uint64_t value: list)
+            push_back(value);
+    }
+
+    inline void packed_int_vector::widen(unsigned width) {
+        if (width <= _width)
+            return;
+        if (width > 64)
+            throw std::out_of_range("width must be between 1 and 64");
+        packed_int_vector wider(width);
+        wider._words.resize(_word_count(_size, width), 0);
+        wider._size = _size;
+        for (size_t i = 0; i < _size; ++i)
+            wider._put(i, (*this)[i]);
+        *this = std::move(wider);
+    }
+
+    inline uint64_t packed_int_vector::operator[](size_t i) const noexcept {
+        size_t bit = i * _width;
+        size_t word = bit / 64;
+        unsigned shift = bit % 64;
+        uint64_t value = _words[word] >> shift;
+        if (shift + _width > 64)
+            value |= _words[word + 1] << (64 - shift);
+        return value & _mask(_width);
+    }
+
+    inline uint64_t packed_int_vector::at(size_t i) const {
+        if (i >= _size)
+            throw std::out_of_range("index out of bounds");
+        return (*this)[i];
+    }
+
+    inline void packed_int_vector::set(size_t i, uint64_t value) {
+        if (i >= _size)
+            throw std::out_of_range("index out of bounds");
+        widen(_bits(value));
+        size_t bit = i * _width;
+        size_t word = bit / 64;
+        unsigned shift = bit % 64;
+        _words[word] &= ~(_mask(_width) << shift);
+        if (shift + _width > 64)
+            _words[word + 1] &= ~(_mask(_width) >> (64 - shift));
+        _put(i, value);
+    }
+
+    inline void packed_int_vector::push_back(uint64_t value) {
+        widen(_bits(value));
+        if (_words.size() < _word_count(_size + 1, _width))
+            _words.push_back(0);
+        _put(_size++, value);
+    }
+
+    inline void packed_int_vector::pop_back() {
+        assert(_size > 0 && "pop_back() on an empty packed_int_vector");
+        set(_size - 1, 0);
+        --_size;
+        if (_words.size() > _word_count(_size, _width))
+            _words.pop_back();
+    }
+
+    inline void packed_int_vector::resize(size_t count, uint64_t value) {
+        if (count < _size) {
+            while (_size > count)
+                pop_back();
+            return;
+        }
+        widen(_bits(value));
+        _words.resize(_word_count(count, _width), 0);
+        while (_size < count)
+            _put(_size++, value);
+    }
+
+    inline void packed_int_vector::clear() noexcept {
+        _words.clear();
+        _size = 0;
+    }
+
+    inline packed_int_vector::const_iterator packed_int_vector::begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    inline packed_int_vector::const_iterator packed_int_vector::end() const noexcept {
+        return const_iterator(this, _size);
+    }
+
+    inline void packed_int_vector::_put(size_t i, uint64_t value) noexcept {
+        size_t bit = i * _width;
+        size_t word = bit / 64;
+        unsigned shift = bit % 64;
+        _words[word] |= value << shift;
+        if (shift + _width > 64)
+            _words[word + 1] |= value >> (64 - shift);
+    }
+
+    //      PACKED SORTED VECTOR
+
+    template<typename IT, typename>
+    packed_sorted_vector::packed_sorted_vector(IT first, IT last) {
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    inline uint64_t packed_sorted_vector::operator[](size_t i) const {
+        size_t b = i / block_size;
+        if (b == _blocks.size())
+            return _tail[i % block_size];
+        const _block &block = _blocks[b];
+        return _value(_data.data() + block.offset, block.width, block.first, i % block_size);
+    }
+
+    inline uint64_t packed_sorted_vector::at(size_t i) const {
+        if (i >= size())
+            throw std::out_of_range("index out of bounds");
+        return (*this)[i];
+    }
+
+    inline size_t packed_sorted_vector::decode(size_t b, uint64_t *out) const {
+        if (b == _blocks.size()) {
+            for (size_t i = 0; i < _tail.size(); ++i)
+                out[i] = _tail[i];
+            return _tail.size();
+        }
+        const _block &block = _blocks[b];
+        const uint32_t *in = _data.data() + block.offset;
+        if (block.width == _raw) {
+            for (size_t i = 0; i < block_size; ++i)
+                out[i] = in[2 * i] | uint64_t(in[2 * i + 1]) << 32;
+            return block_size;
+        }
+        // one instantiation per width, so that every shift and mask is a constant.
+        using unpack_fn = void (*)(const uint32_t *, uint64_t, uint64_t *);
+        static constexpr unpack_fn unpackers[] = {
+                _unpack<0>, _unpack<1>, _unpack<2>, _unpack<3>, _unpack<4>, _unpack<5>, _unpack<6>,
+                _unpack<7>, _unpack<8>, _unpack<9>, _unpack<10>, _unpack<11>, _unpack<12>, _unpack<13>,
+                _unpack<14>, _unpack<15>, _unpack<16>, _unpack<17>, _unpack<18>, _unpack<19>, _unpack<20>,
+                _unpack<21>, _unpack<22>, _unpack<23>, _unpack<24>, _unpack<25>, _unpack<26>, _unpack<27>,
+                _unpack<28>, _unpack<29>, _unpack<30>, _unpack<31>, _unpack<32>};
+        unpackers[block.width](in, block.first, out);
+        return block_size;
+    }
+
+    inline size_t packed_sorted_vector::lower_bound(uint64_t value) const {
+        // number of blocks starting below `value`: the answer is in the last of them, or right after it.
+        size_t low = 0, high = _blocks.size();
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (_blocks[mid].first < value)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        if (low > 0) {
+            uint64_t buffer[block_size];
+            decode(low - 1, buffer);
+            for (size_t i = 0; i < block_size; ++i) {
+                if (buffer[i] >= value)
+                    return (low - 1) * block_size + i;
+            }
+        }
+        if (low < _blocks.size())
+            return low * block_size;
+        for (size_t i = 0; i < _tail.size(); ++i) {
+            if (_tail[i] >= value)
+                return _blocks.size() * block_size + i;
+        }
+        return size();
+    }
+
+    inline void packed_sorted_vector::push_back(uint64_t value) {
+        assert((empty() || value >= back()) && "packed_sorted_vector values must be pushed in order");
+        if (_tail.capacity() == 0)
+            _tail.reserve(block_size);
+        _tail.push_back(value);
+        if (_tail.size() == block_size)
+            _flush();
+    }
+
+    inline void packed_sorted_vector::clear() noexcept {
+        _blocks.clear();
+        _data.clear();
+        _tail.clear();
+    }
+
+    inline packed_sorted_vector::const_iterator packed_sorted_vector::begin() const {
+        const_iterator it(this, 0);
+        if (!empty())
+            it._load();
+        return it;
+    }
+
+    inline packed_sorted_vector::const_iterator packed_sorted_vector::end() const {
+        return const_iterator(this, size());
+    }
+
+    //      PRIVATE
+
+    inline void packed_sorted_vector::_flush() {
+        const uint64_t *values = _tail.data();
+        uint64_t first = values[0];
+        uint64_t max = 0;
+        for (size_t i = 4; i < block_size; ++i)
+            max |= values[i] - values[i - 4];
+        for (size_t i = 0; i < 4; ++i)
+            max |= values[i] - first;
+
+        size_t offset = _data.size();
+        if (max >> 32) {
+            _blocks.push_back({first, offset, _raw});
+            for (size_t i = 0; i < block_size; ++i) {
+                _data.push_back(static_cast<uint32_t>(values[i]));
+                _data.push_back(static_cast<uint32_t>(values[i] >> 32));
+            }
+        } else {
+            unsigned width = max ? static_cast<unsigned>(std::bit_width(max)) : 0;
+            _blocks.push_back({first, offset, width});
+            _data.resize(offset + 4 * width, 0);
+            uint32_t *out = _data.data() + offset;
+            // value i is the (i / 4)-th of lane i % 4; word k of a lane is out[4 * k + lane].
+            for (size_t i = 0; i < block_size && width > 0; ++i) {
+                uint64_t delta = values[i] - (i < 4 ? first : values[i - 4]);
+                size_t bit = (i / 4) * width;
+                size_t word = 4 * (bit / 32) + i % 4;
+                unsigned shift = bit % 32;
+                out[word] |= static_cast<uint32_t>(delta << shift);
+                if (shift + width > 32)
+                    out[word + 4] |= static_cast<uint32_t>(delta >> (32 - shift));
+            }
+        }
+        _tail.clear();
+    }
+
+    template<unsigned W>
+    void packed_sorted_vector::_unpack(const uint32_t *in, uint64_t first, uint64_t *out) {
+#if defined(__SSE2__)
+        const __m128i mask = _mm_set1_epi32(W == 32 ? -1 : static_cast<int>((uint64_t(1) << W) - 1));
+        const __m128i zero = _mm_setzero_si128();
+        // lanes 0, 1 and lanes 2, 3 of the previous 4 values, widened to 64 bits.
+        __m128i low = _mm_set1_epi64x(static_cast<long long>(first));
+        __m128i high = low;
+        #pragma GCC unroll 32
+        for (unsigned j = 0; j < block_size / 4; ++j) {
+            __m128i delta = zero;
+            if constexpr (W > 0) {
+                unsigned bit = j * W;
+                unsigned shift = bit % 32;
+                const __m128i *word = reinterpret_cast<const __m128i *>(in) + bit / 32;
+                delta = _mm_srli_epi32(_mm_loadu_si128(word), static_cast<int>(shift));
+                if (shift + W > 32)
+                    delta = _mm_or_si128(delta, _mm_slli_epi32(_mm_loadu_si128(word + 1), static_cast<int>(32 - shift)));
+                delta = _mm_and_si128(delta, mask);
+            }
+            low = _mm_add_epi64(low, _mm_unpacklo_epi32(delta, zero));
+            high = _mm_add_epi64(high, _mm_unpackhi_epi32(delta, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 * j), low);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4 * j + 2), high);
+        }
+#else
+        uint64_t previous[4] = {first, first, first, first};
+        for (unsigned j = 0; j < block_size / 4; ++j) {
+            for (unsigned lane = 0; lane < 4; ++lane) {
+                if constexpr (W > 0) {
+                    unsigned bit = j * W;
+                    unsigned shift = bit % 32;
+                    uint64_t delta = in[4 * (bit / 32) + lane] >> shift;
+                    if (shift + W > 32)
+                        delta |= uint64_t(in[4 * (bit / 32) + 4 + lane]) << (32 - shift);
+                    previous[lane] += delta & ((uint64_t(1) << W) - 1);
+                }
+                out[4 * j + lane] = previous[lane];
+            }
+        }
+#endif
+    }
+
+    inline uint64_t packed_sorted_vector::_value(const uint32_t *in, unsigned width, uint64_t first, size_t i) {
+        if (width == _raw)
+            return in[2 * i] | uint64_t(in[2 * i + 1]) << 32;
+        size_t lane = i % 4;
+        uint64_t value = first;
+        for (size_t j = 0; j <= i / 4 && width > 0; ++j) {
+            size_t bit = j * width;
+            unsigned shift = bit % 32;
+            uint64_t delta = in[4 * (bit / 32) + lane] >> shift;
+            if (shift + width > 32)
+                delta |= uint64_t(in[4 * (bit / 32) + 4 + lane]) << (32 - shift);
+            value += delta & ((uint64_t(1) << width) - 1);
+        }
+        return value;
+    }
+}
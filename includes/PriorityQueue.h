@@ -0,0 +1,368 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cassert>
+#include <functional>
+#include <type_traits>
+#include "Vector.h"
+
+namespace rc {
+    /**
+     * d-ary heap backed by an rc::vector.
+     * Like std::priority_queue, top() is the greatest element according to `Compare` (use std::greater for a min-heap).
+     *
+     * A wider node (4 children by default) halves the depth of a binary heap, and its children share
+     * one or two cache lines, so a sift down touches fewer lines at the price of more comparisons per level.
+     * Sifting moves a "hole" along the path: each element on the way is moved once, instead of swapped.
+     *
+     * @tparam TrackPositions maintains a handle -> position table so that an element can be updated
+     * (see decrease_key()) after it was pushed. push() then returns the element's handle.
+     */
+    template<typename T, typename Compare = std::less<T>, size_t Arity = 4, bool TrackPositions = false>
+    class priority_queue {
+        static_assert(Arity >= 2, "a heap node needs at least two children");
+
+    public:
+        using value_type = T;
+        using handle_type = size_t;
+
+        // push() returns a handle only when positions are tracked.
+        using push_result = std::conditional_t<TrackPositions, handle_type, void>;
+
+    private:
+        static constexpr size_t _npos = static_cast<size_t>(-1);
+
+        rc::vector<T> _data;
+        Compare _comp;
+
+        // positions tracking only
+        rc::vector<handle_type> _handle_at; // heap index -> handle
+        rc::vector<size_t> _position; // handle -> heap index, or _npos once released
+        rc::vector<handle_type> _free_handles;
+
+    public:
+        priority_queue() = default;
+
+        explicit priority_queue(const Compare &comp) : _comp(comp) {}
+
+        // Builds the heap in O(n).
+        template<typename IT>
+        priority_queue(IT first, IT last, const Compare &comp = Compare());
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _data.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return _data.empty(); }
+
+        void reserve(size_t new_cap);
+
+        //      ELEMENT ACCESS
+
+        const T &top() const { return _data.front(); }
+
+        //      MODIFIERS
+
+        push_result push(const T &value) { return emplace(value); }
+
+        push_result push(T &&value) { return emplace(std::move(value)); }
+
+        template<typename... Args>
+        push_result emplace(Args &&... args);
+
+        // Appends a batch of elements. A large batch is merged with a single O(n) heapify
+        // instead of one sift up per element.
+        // When positions are tracked, the handles of the new elements are written to `handles`.
+        template<typename IT, typename OUT_IT = std::nullptr_t>
+        void push_range(IT first, IT last, OUT_IT handles = nullptr);
+
+        // Removes the top element.
+        void pop();
+
+        void clear() noexcept;
+
+        //      POSITIONS TRACKING
+
+        handle_type top_handle() const;
+
+        bool contains(handle_type handle) const;
+
+        const T &get(handle_type handle) const;
+
+        // Replaces the value of the element by one that ranks at least as high, moving it towards the top.
+        // With std::greater (a min-heap), this is the classic decrease-key.
+        void decrease_key(handle_type handle, T value);
+
+        // Replaces the value of the element, moving it up or down as needed.
+        void update(handle_type handle, T value);
+
+        // Removes any element.
+        void erase(handle_type handle);
+
+    private:
+        static size_t _parent(size_t i) { return (i - 1) / Arity; }
+
+        static size_t _first_child(size_t i) { return i * Arity + 1; }
+
+        // stores `value` in the hole `i`
+        void _fill(size_t i, T &&value, handle_type handle);
+
+        // moves the element of `from` to the hole `to`; `from` becomes the hole.
+        void _move_hole(size_t to, size_t from);
+
+        // moves the hole `i` up until `value` can be stored in it.
+        void _sift_up(size_t i, T &&value, handle_type handle);
+
+        // moves the hole `i` down until `value` can be stored in it.
+        void _sift_down(size_t i, T &&value, handle_type handle);
+
+        void _heapify();
+
+        handle_type _new_handle(size_t position);
+
+        // detaches the last element, and fills the hole `i` with it.
+        void _remove_at(size_t i);
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    template<typename IT>
+    priority_queue<T, Compare, Arity, TrackPositions>::priority_queue(IT first, IT last, const Compare &comp)
+            : _comp(comp) {
+        push_range(first, last);
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::reserve(size_t new_cap) {
+        _data.reserve(new_cap);
+        if constexpr (TrackPositions) {
+            _handle_at.reserve(new_cap);
+            _position.reserve(new_cap);
+        }
+    }
+
+    //      MODIFIERS
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    template<typename... Args>
+    typename priority_queue<T, Compare, Arity, TrackPositions>::push_result
+    priority_queue<T, Compare, Arity, TrackPositions>::emplace(Args &&... args) {
+        size_t i = _data.size();
+        _data.emplace_back(std::forward<Args>(args)...);
+        handle_type handle = 0;
+        if constexpr (TrackPositions) {
+            handle = _new_handle(i);
+            _handle_at.push_back(handle);
+        }
+        _sift_up(i, std::move(_data[i]), handle);
+
+        if constexpr (TrackPositions)
+            return handle;
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    template<typename IT, typename OUT_IT>
+    void priority_queue<T, Compare, Arity, TrackPositions>::push_range(IT first, IT last, OUT_IT handles) {
+        size_t old_size = _data.size();
+        for (; first != last; ++first) {
+            size_t i = _data.size();
+            _data.push_back(*first);
+            if constexpr (TrackPositions) {
+                handle_type handle = _new_handle(i);
+                _handle_at.push_back(handle);
+                if constexpr (!std::is_same_v<OUT_IT, std::nullptr_t>)
+                    *handles++ = handle;
+            }
+        }
+        size_t added = _data.size() - old_size;
+        if (added == 0)
+            return;
+
+        // Sifting up every new element costs about `added * depth` moves, heapify about `size` moves.
+        size_t depth = 0;
+        for (size_t n = _data.size(); n > 1; n /= Arity)
+            ++depth;
+        if (added * depth > _data.size()) {
+            _heapify();
+        } else {
+            for (size_t i = old_size; i < _data.size(); ++i) {
+                handle_type handle = 0;
+                if constexpr (TrackPositions)
+                    handle = _handle_at[i];
+                _sift_up(i, std::move(_data[i]), handle);
+            }
+        }
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::pop() {
+        if constexpr (TrackPositions) {
+            _position[_handle_at[0]] = _npos;
+            _free_handles.push_back(_handle_at[0]);
+        }
+        _remove_at(0);
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::clear() noexcept {
+        _data.clear();
+        _handle_at.clear();
+        _position.clear();
+        _free_handles.clear();
+    }
+
+    //      POSITIONS TRACKING
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    typename priority_queue<T, Compare, Arity, TrackPositions>::handle_type
+    priority_queue<T, Compare, Arity, TrackPositions>::top_handle() const {
+        static_assert(TrackPositions, "handles require TrackPositions");
+        return _handle_at.front();
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    bool priority_queue<T, Compare, Arity, TrackPositions>::contains(handle_type handle) const {
+        static_assert(TrackPositions, "handles require TrackPositions");
+        return handle < _position.size() && _position[handle] != _npos;
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    const T &priority_queue<T, Compare, Arity, TrackPositions>::get(handle_type handle) const {
+        static_assert(TrackPositions, "handles require TrackPositions");
+        return _data[_position[handle]];
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::decrease_key(handle_type handle, T value) {
+        static_assert(TrackPositions, "handles require TrackPositions");
+        size_t i = _position[handle];
+        assert(!_comp(value, _data[i]) && "decrease_key() can't move an element away from the top");
+        _sift_up(i, std::move(value), handle);
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::update(handle_type handle, T value) {
+        static_assert(TrackPositions, "handles require TrackPositions");
+        size_t i = _position[handle];
+        if (_comp(value, _data[i]))
+            _sift_down(i, std::move(value), handle);
+        else
+            _sift_up(i, std::move(value), handle);
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::erase(handle_type handle) {
+        static_assert(TrackPositions, "handles require TrackPositions");
+        size_t i = _position[handle];
+        _position[handle] = _npos;
+        _free_handles.push_back(handle);
+        _remove_at(i);
+    }
+
+    //      PRIVATE
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::_fill(size_t i, T &&value, handle_type handle) {
+        _data[i] = std::move(value);
+        if constexpr (TrackPositions) {
+            _handle_at[i] = handle;
+            _position[handle] = i;
+        }
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::_move_hole(size_t to, size_t from) {
+        _data[to] = std::move(_data[from]);
+        if constexpr (TrackPositions) {
+            _handle_at[to] = _handle_at[from];
+            _position[_handle_at[to]] = to;
+        }
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::_sift_up(size_t i, T &&value, handle_type handle) {
+        // `value` may live in the hole itself: it is moved out before the hole is overwritten.
+        T tmp(std::move(value));
+        while (i > 0) {
+            size_t parent = _parent(i);
+            if (!_comp(_data[parent], tmp))
+                break;
+            _move_hole(i, parent);
+            i = parent;
+        }
+        _fill(i, std::move(tmp), handle);
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::_sift_down(size_t i, T &&value, handle_type handle) {
+        T tmp(std::move(value));
+        size_t size = _data.size();
+        while (true) {
+            size_t child = _first_child(i);
+            if (child >= size)
+                break;
+
+            // greatest of the (up to) Arity children
+            size_t last = child + Arity < size ? child + Arity : size;
+            size_t best = child;
+            for (size_t c = child + 1; c < last; ++c) {
+                if (_comp(_data[best], _data[c]))
+                    best = c;
+            }
+            if (!_comp(tmp, _data[best]))
+                break;
+            _move_hole(i, best);
+            i = best;
+        }
+        _fill(i, std::move(tmp), handle);
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::_heapify() {
+        if (_data.size() < 2)
+            return;
+        // Floyd: sift down every internal node, bottom-up.
+        for (size_t i = _parent(_data.size() - 1) + 1; i-- > 0;) {
+            handle_type handle = 0;
+            if constexpr (TrackPositions)
+                handle = _handle_at[i];
+            _sift_down(i, std::move(_data[i]), handle);
+        }
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    typename priority_queue<T, Compare, Arity, TrackPositions>::handle_type
+    priority_queue<T, Compare, Arity, TrackPositions>::_new_handle(size_t position) {
+        if (!_free_handles.empty()) {
+            handle_type handle = _free_handles.back();
+            _free_handles.pop_back();
+            _position[handle] = position;
+            return handle;
+        }
+        _position.push_back(position);
+        return _position.size() - 1;
+    }
+
+    template<typename T, typename Compare, size_t Arity, bool TrackPositions>
+    void priority_queue<T, Compare, Arity, TrackPositions>::_remove_at(size_t i) {
+        size_t last = _data.size() - 1;
+        T value(std::move(_data[last]));
+        handle_type handle = 0;
+        if constexpr (TrackPositions) {
+            handle = _handle_at[last];
+            _handle_at.pop_back();
+        }
+        _data.pop_back();
+        if (i == last)
+            return;
+
+        // the last element may belong above or below the hole.
+        if (i > 0 && _comp(_data[_parent(i)], value))
+            _sift_up(i, std::move(value), handle);
+        else
+            _sift_down(i, std::move(value), handle);
+    }
+}
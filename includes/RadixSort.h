@@ -0,0 +1,275 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cstdint>
+#include <cstring>
+#include <barrier>
+#include <bit>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "Vector.h"
+
+namespace rc {
+    // Default key extractor of radix_sort(): the element itself.
+    struct radix_identity {
+        template<typename T>
+        constexpr const T &operator()(const T &value) const noexcept { return value; }
+    };
+
+    /**
+     * Maps a key to an unsigned integer with the same ordering.
+     * Signed integers get their sign bit flipped; floats get their sign bit flipped when positive,
+     * and all their bits flipped when negative (IEEE 754 magnitudes are then ordered as unsigned integers).
+     */
+    template<typename K>
+    constexpr auto radix_bits(K key) noexcept {
+        static_assert(std::is_arithmetic_v<K>, "radix_sort() keys must be integral or floating point");
+        if constexpr (std::is_same_v<K, bool>) {
+            return static_cast<uint8_t>(key);
+        } else if constexpr (std::is_floating_point_v<K>) {
+            static_assert(sizeof(K) == 4 || sizeof(K) == 8, "unsupported floating point type");
+            using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+            constexpr U sign = U(1) << (sizeof(U) * 8 - 1);
+            U bits = std::bit_cast<U>(key);
+            return (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+        } else {
+            using U = std::make_unsigned_t<K>;
+            if constexpr (std::is_signed_v<K>)
+                return static_cast<U>(static_cast<U>(key) ^ (U(1) << (sizeof(U) * 8 - 1)));
+            else
+                return static_cast<U>(key);
+        }
+    }
+
+    namespace _radix {
+        // 11 bit digits: 3 passes for 32 bit keys instead of 4, and a 2048 counters histogram still fits in L1.
+        template<typename U>
+        constexpr unsigned digit_bits = sizeof(U) <= 2 ? 8 : 11;
+
+        template<typename U>
+        constexpr unsigned passes = (sizeof(U) * 8 + digit_bits<U> - 1) / digit_bits<U>;
+
+        template<typename U>
+        constexpr size_t radix = size_t(1) << digit_bits<U>;
+
+        // below this size, an insertion sort is faster than clearing the histograms.
+        constexpr size_t min_size = 64;
+
+        template<typename U>
+        inline size_t digit(U bits, unsigned pass) {
+            return static_cast<size_t>(bits >> (pass * digit_bits<U>)) & (radix<U> - 1);
+        }
+
+        template<typename T, typename KeyFn>
+        void insertion_sort(T *first, T *last, KeyFn &key) {
+            for (T *it = first + 1; it < last; ++it) {
+                T value = *it;
+                auto bits = radix_bits(key(value));
+                T *hole = it;
+                for (; hole > first && radix_bits(key(hole[-1])) > bits; --hole)
+                    *hole = hole[-1];
+                *hole = value;
+            }
+        }
+
+        // scratch buffer taken from the allocator of the sorted container
+        template<typename T, typename Alloc>
+        struct buffer {
+            T *data;
+            size_t size;
+
+            explicit buffer(size_t n) : size(n) {
+                Alloc alloc;
+                data = alloc.allocate(n);
+            }
+
+            ~buffer() {
+                Alloc alloc;
+                alloc.deallocate(data, size);
+            }
+
+            buffer(buffer const &) = delete;
+
+            buffer &operator=(buffer const &) = delete;
+        };
+
+        // Distributes [src, src + n) into dst by the digit `pass`; `offsets` holds the first destination of each digit.
+        template<typename T, typename KeyFn>
+        void scatter(const T *src, size_t n, T *dst, size_t *offsets, unsigned pass, KeyFn &key) {
+            using U = decltype(radix_bits(key(*src)));
+            for (size_t i = 0; i < n; ++i)
+                dst[offsets[digit<U>(radix_bits(key(src[i])), pass)]++] = src[i];
+        }
+    }
+
+    /**
+     * Stable LSD radix sort of [first, last), ordered by `key(element)`.
+     *
+     * All the digit histograms are built in a single pass over the input, then every digit is distributed
+     * from one buffer to the other. A digit which has the same value for every element is skipped,
+     * so small keys in wide types (e.g. indexes in a uint64_t) only pay for their significant digits.
+     *
+     * @tparam Alloc allocates the scratch buffer, which has the size of the input.
+     * @tparam KeyFn projects an element to an integral or floating point key.
+     */
+    template<typename Alloc, typename T, typename KeyFn = radix_identity>
+    void radix_sort(T *first, T *last, KeyFn key = KeyFn()) {
+        static_assert(std::is_trivially_copyable_v<T>, "radix_sort() moves elements with plain copies");
+        using U = decltype(radix_bits(key(*first)));
+        constexpr unsigned passes = _radix::passes<U>;
+        constexpr size_t radix = _radix::radix<U>;
+
+        size_t n = last - first;
+        if (n < _radix::min_size) {
+            if (n > 1)
+                _radix::insertion_sort(first, last, key);
+            return;
+        }
+
+        std::vector<size_t> counts(passes * radix, 0);
+        for (size_t i = 0; i < n; ++i) {
+            U bits = radix_bits(key(first[i]));
+            for (unsigned p = 0; p < passes; ++p)
+                ++counts[p * radix + _radix::digit<U>(bits, p)];
+        }
+
+        _radix::buffer<T, Alloc> scratch(n);
+        T *src = first;
+        T *dst = scratch.data;
+        U first_bits = radix_bits(key(*first));
+        for (unsigned p = 0; p < passes; ++p) {
+            size_t *offsets = counts.data() + p * radix;
+            if (offsets[_radix::digit<U>(first_bits, p)] == n)
+                continue;
+
+            // counts -> exclusive prefix sums
+            size_t sum = 0;
+            for (size_t d = 0; d < radix; ++d) {
+                size_t count = offsets[d];
+                offsets[d] = sum;
+                sum += count;
+            }
+            _radix::scatter(src, n, dst, offsets, p, key);
+            std::swap(src, dst);
+        }
+        if (src != first)
+            std::memcpy(static_cast<void *>(first), src, n * sizeof(T));
+    }
+
+    template<typename T, typename Alloc, typename KeyFn = radix_identity>
+    void radix_sort(rc::vector<T, Alloc> &vector, KeyFn key = KeyFn()) {
+        radix_sort<Alloc>(vector.data(), vector.data() + vector.size(), key);
+    }
+
+    /**
+     * Multi-threaded radix_sort(): every thread owns a contiguous chunk of the input, counts its digits,
+     * then scatters its chunk to the positions reserved for it in each digit bucket, so the sort stays stable
+     * and the threads never write to the same destination.
+     *
+     * @param threads number of threads, the calling thread included. Inputs too small to be worth it are
+     * sorted by the calling thread alone.
+     */
+    template<typename Alloc, typename T, typename KeyFn = radix_identity>
+    void parallel_radix_sort(T *first, T *last, KeyFn key = KeyFn(),
+                             unsigned threads = std::thread::hardware_concurrency()) {
+        static_assert(std::is_trivially_copyable_v<T>, "radix_sort() moves elements with plain copies");
+        using U = decltype(radix_bits(key(*first)));
+        constexpr unsigned passes = _radix::passes<U>;
+        constexpr size_t radix = _radix::radix<U>;
+        constexpr size_t min_chunk = 1 << 16;
+
+        size_t n = last - first;
+        if (threads > n / min_chunk)
+            threads = static_cast<unsigned>(n / min_chunk);
+        if (threads <= 1) {
+            radix_sort<Alloc>(first, last, key);
+            return;
+        }
+
+        _radix::buffer<T, Alloc> scratch(n);
+        // counts[t][p][d]: occurrences of digit `d` of pass `p` in the chunk of thread `t`, for the first pass.
+        // Only the row of the current pass is reused by the next ones.
+        std::vector<size_t> counts(threads * passes * radix, 0);
+        std::vector<uint8_t> skip(passes, 0);
+        std::barrier sync(threads);
+        T *buffers[2] = {first, scratch.data};
+
+        auto worker = [&](unsigned t) {
+            size_t begin = n * t / threads;
+            size_t end = n * (t + 1) / threads;
+            size_t *own = counts.data() + t * passes * radix;
+
+            for (size_t i = begin; i < end; ++i) {
+                U bits = radix_bits(key(first[i]));
+                for (unsigned p = 0; p < passes; ++p)
+                    ++own[p * radix + _radix::digit<U>(bits, p)];
+            }
+            sync.arrive_and_wait();
+
+            if (t == 0) {
+                // a digit is constant if its bucket holds every element, all chunks summed.
+                U first_bits = radix_bits(key(*first));
+                for (unsigned p = 0; p < passes; ++p) {
+                    size_t d = _radix::digit<U>(first_bits, p);
+                    size_t total = 0;
+                    for (unsigned c = 0; c < threads; ++c)
+                        total += counts[(c * passes + p) * radix + d];
+                    skip[p] = total == n;
+                }
+            }
+            sync.arrive_and_wait();
+
+            std::vector<size_t> offsets(radix);
+            unsigned current = 0;
+            bool first_pass = true;
+            for (unsigned p = 0; p < passes; ++p) {
+                if (skip[p])
+                    continue;
+                const T *src = buffers[current];
+                T *dst = buffers[current ^ 1];
+
+                // the chunks moved since the histograms were built: count again.
+                if (!first_pass) {
+                    size_t *row = own + p * radix;
+                    std::fill(row, row + radix, 0);
+                    for (size_t i = begin; i < end; ++i)
+                        ++row[_radix::digit<U>(radix_bits(key(src[i])), p)];
+                    sync.arrive_and_wait();
+                }
+                first_pass = false;
+
+                // the chunk of thread `t` goes after every smaller digit, and after the same digit of chunks < t.
+                size_t sum = 0;
+                for (size_t d = 0; d < radix; ++d) {
+                    for (unsigned c = 0; c < threads; ++c) {
+                        if (c == t)
+                            offsets[d] = sum;
+                        sum += counts[(c * passes + p) * radix + d];
+                    }
+                }
+                _radix::scatter(src + begin, end - begin, dst, offsets.data(), p, key);
+                current ^= 1;
+                sync.arrive_and_wait();
+            }
+
+            if (current == 1)
+                std::memcpy(static_cast<void *>(first + begin), scratch.data + begin, (end - begin) * sizeof(T));
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t)
+            pool.emplace_back(worker, t);
+        worker(0);
+        for (auto &thread: pool)
+            thread.join();
+    }
+
+    template<typename T, typename Alloc, typename KeyFn = radix_identity>
+    void parallel_radix_sort(rc::vector<T, Alloc> &vector, KeyFn key = KeyFn(),
+                             unsigned threads = std::thread::hardware_concurrency()) {
+        parallel_radix_sort<Alloc>(vector.data(), vector.data() + vector.size(), key, threads);
+    }
+}
@@ -26,29 +26,29 @@ public:
     using iterator_category = typename rc::iterator_traits<IT>::iterator_category;
 
 public:
-    ReverseIterator(IT source) : _source(source) {}
+    constexpr ReverseIterator(IT source) : _source(source) {}
 
-    ReverseIterator(ReverseIterator const &o) = default;
+    constexpr ReverseIterator(ReverseIterator const &o) = default;
 
-    virtual ~ReverseIterator() = default;
+    constexpr ~ReverseIterator() = default;
 
     ReverseIterator() = delete;
 
-    ReverseIterator<IT> &operator=(const ReverseIterator<IT> &o) {
+    constexpr ReverseIterator<IT> &operator=(const ReverseIterator<IT> &o) {
         _source = o._source;
         return *this;
     }
 
 public:
     // POINTER
-    reference operator*() const {
+    constexpr reference operator*() const {
         // Since we instanciate this iterator with the end of the source of another,
         // we need to decrement the pointer for find the latest element of the iterated container.
         IT it(_source - 1);
         return *it;
     }
 
-    pointer operator->() const {
+    constexpr pointer operator->() const {
         // Since we instanciate this iterator with the end of the source of another,
         // we need to decrement the pointer for find the latest element of the iterated container.
         IT it(_source - 1);
@@ -56,29 +56,29 @@ public:
     }
 
     // INCREMENT / DECREMENT
-    ReverseIterator &operator++() {
+    constexpr ReverseIterator &operator++() {
         --_source;
         return *this;
     }
 
-    ReverseIterator &operator++(int) { return ReverseIterator<IT>(_source--); }
+    constexpr ReverseIterator operator++(int) { return ReverseIterator<IT>(_source--); }
 
-    ReverseIterator &operator--() {
+    constexpr ReverseIterator &operator--() {
         ++_source;
         return *this;
     }
 
-    ReverseIterator &operator--(int) {
+    constexpr ReverseIterator operator--(int) {
         return ReverseIterator<IT>(_source++);
     }
 
 
-    ReverseIterator &operator+=(const difference_type i) {
+    constexpr ReverseIterator &operator+=(const difference_type i) {
         _source -= i;
         return *this;
     }
 
-    ReverseIterator &operator-=(const difference_type i) {
+    constexpr ReverseIterator &operator-=(const difference_type i) {
         _source += i;
         return *this;
     }
@@ -86,47 +86,47 @@ public:
     // ARITHMETIC
 
     // it = it + scalar
-    ReverseIterator operator+(const difference_type i) { return ReverseIterator<IT>(_source - i); }
+    constexpr ReverseIterator operator+(const difference_type i) { return ReverseIterator<IT>(_source - i); }
 
     // it = scalar + it;
     template<typename U>
-    friend ReverseIterator<U>
+    friend constexpr ReverseIterator<U>
     operator+(typename ReverseIterator<U>::difference_type i, const ReverseIterator<U> &rhs);
 
     // it = it - scalar;
-    ReverseIterator operator-(const difference_type i) { return ReverseIterator<IT>(_source + i); }
+    constexpr ReverseIterator operator-(const difference_type i) { return ReverseIterator<IT>(_source + i); }
 
     // diff = it - it;
     template<typename T>
-    friend difference_type operator-(const ReverseIterator<T> &lhs, const ReverseIterator<T> &rhs);
+    friend constexpr difference_type operator-(const ReverseIterator<T> &lhs, const ReverseIterator<T> &rhs);
 
     // ACCESS
-    reference operator[](difference_type i) { return (*(_source - i - 1)); }
+    constexpr reference operator[](difference_type i) { return (*(_source - i - 1)); }
 
-    const_reference operator[](difference_type i) const { return (*(_source - i - 1)); }
+    constexpr const_reference operator[](difference_type i) const { return (*(_source - i - 1)); }
 
     // COMPARE
-    bool operator==(const ReverseIterator &rhs) const { return this->_source == rhs._source; }
+    constexpr bool operator==(const ReverseIterator &rhs) const { return this->_source == rhs._source; }
 
-    bool operator!=(const ReverseIterator &rhs) const { return this->_source != rhs._source; }
+    constexpr bool operator!=(const ReverseIterator &rhs) const { return this->_source != rhs._source; }
 
-    bool operator<(const ReverseIterator &rhs) const { return this->_source > rhs._source; }
+    constexpr bool operator<(const ReverseIterator &rhs) const { return this->_source > rhs._source; }
 
-    bool operator<=(const ReverseIterator &rhs) const { return this->_source >= rhs._source; }
+    constexpr bool operator<=(const ReverseIterator &rhs) const { return this->_source >= rhs._source; }
 
-    bool operator>(const ReverseIterator &rhs) const { return this->_source < rhs._source; }
+    constexpr bool operator>(const ReverseIterator &rhs) const { return this->_source < rhs._source; }
 
-    bool operator>=(const ReverseIterator &rhs) const { return this->_source <= rhs._source; }
+    constexpr bool operator>=(const ReverseIterator &rhs) const { return this->_source <= rhs._source; }
 
 };
 
 template<typename T>
-ptrdiff_t operator-(const ReverseIterator<T> &lhs, const ReverseIterator<T> &rhs) {
+constexpr ptrdiff_t operator-(const ReverseIterator<T> &lhs, const ReverseIterator<T> &rhs) {
     return rhs._source - lhs._source;
 }
 
 template<typename U>
-ReverseIterator<U>
+constexpr ReverseIterator<U>
 operator+(typename ReverseIterator<U>::difference_type i, const ReverseIterator<U> &rhs) {
     return rhs._source - i;
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cstdint>
+#include <stdexcept>
+#include "Vector.h"
+
+namespace rc {
+    // Stable reference to an element of a slot_map.
+    struct slot_map_key {
+        uint32_t index;
+        uint32_t generation;
+
+        bool operator==(const slot_map_key &other) const = default;
+    };
+
+    /**
+     * Unordered container handing out stable keys, with the elements packed in an rc::vector.
+     *
+     * A key goes through an indirection slot holding the element's current position.
+     * Erasing moves the last element into the hole (swap and pop) and updates its slot, so iteration stays
+     * a linear walk over contiguous memory. Every slot has a generation, bumped when its element is erased:
+     * a key kept after the erase no longer matches, instead of silently pointing to another element.
+     *
+     * Iteration order is not stable: it changes when elements are erased.
+     */
+    template<typename T, typename Alloc = rc::allocator<T>>
+    class slot_map {
+    public:
+        using key_type = slot_map_key;
+        using value_type = T;
+
+        using iterator = typename rc::vector<T, Alloc>::iterator;
+        using const_iterator = typename rc::vector<T, Alloc>::const_iterator;
+
+    private:
+        static constexpr uint32_t _npos = static_cast<uint32_t>(-1);
+
+        struct _slot {
+            // position of the element in _values, or next free slot
+            uint32_t index;
+            // odd while the slot is used
+            uint32_t generation;
+        };
+
+        using _uint_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<uint32_t>;
+        using _slot_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_slot>;
+
+        rc::vector<T, Alloc> _values;
+        rc::vector<uint32_t, _uint_alloc> _slot_of; // _values index -> slot index
+        rc::vector<_slot, _slot_alloc> _slots;
+        uint32_t _free_head = _npos;
+
+    public:
+        slot_map() = default;
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _values.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return _values.empty(); }
+
+        void reserve(size_t new_cap);
+
+        //      ELEMENT ACCESS
+
+        // Access an element with bounds and generation checking.
+        T &at(key_type key);
+
+        const T &at(key_type key) const;
+
+        // Access an element without any checks.
+        T &operator[](key_type key) { return _values[_slots[key.index].index]; }
+
+        const T &operator[](key_type key) const { return _values[_slots[key.index].index]; }
+
+        // Returns nullptr if the key was erased.
+        T *find(key_type key);
+
+        const T *find(key_type key) const;
+
+        bool contains(key_type key) const { return find(key) != nullptr; }
+
+        // Key of the element stored at `position` in the iteration order.
+        key_type key_at(size_t position) const;
+
+        T *data() noexcept { return _values.data(); }
+
+        //      ITERATORS
+
+        iterator begin() noexcept { return _values.begin(); }
+
+        iterator end() noexcept { return _values.end(); }
+
+        const_iterator begin() const noexcept { return _values.cbegin(); }
+
+        const_iterator end() const noexcept { return _values.cend(); }
+
+        //      MODIFIERS
+
+        key_type insert(const T &value) { return emplace(value); }
+
+        key_type insert(T &&value) { return emplace(std::move(value)); }
+
+        template<typename... Args>
+        key_type emplace(Args &&... args);
+
+        // Returns false if the key was already erased.
+        bool erase(key_type key);
+
+        void clear() noexcept;
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, typename Alloc>
+    void slot_map<T, Alloc>::reserve(size_t new_cap) {
+        _values.reserve(new_cap);
+        _slot_of.reserve(new_cap);
+        _slots.reserve(new_cap);
+    }
+
+    //      ELEMENT ACCESS
+
+    template<typename T, typename Alloc>
+    T &slot_map<T, Alloc>::at(key_type key) {
+        T *value = find(key);
+        if (value == nullptr)
+            throw std::out_of_range("key not found");
+        return *value;
+    }
+
+    template<typename T, typename Alloc>
+    const T &slot_map<T, Alloc>::at(key_type key) const {
+        const T *value = find(key);
+        if (value == nullptr)
+            throw std::out_of_range("key not found");
+        return *value;
+    }
+
+    template<typename T, typename Alloc>
+    T *slot_map<T, Alloc>::find(key_type key) {
+        if (key.index >= _slots.size() || _slots[key.index].generation != key.generation)
+            return nullptr;
+        return &_values[_slots[key.index].index];
+    }
+
+    template<typename T, typename Alloc>
+    const T *slot_map<T, Alloc>::find(key_type key) const {
+        if (key.index >= _slots.size() || _slots[key.index].generation != key.generation)
+            return nullptr;
+        return &_values[_slots[key.index].index];
+    }
+
+    template<typename T, typename Alloc>
+    typename slot_map<T, Alloc>::key_type slot_map<T, Alloc>::key_at(size_t position) const {
+        if (position >= _values.size())
+            throw std::out_of_range("index out of bounds");
+        uint32_t index = _slot_of[position];
+        return {index, _slots[index].generation};
+    }
+
+    //      MODIFIERS
+
+    template<typename T, typename Alloc>
+    template<typename... Args>
+    typename slot_map<T, Alloc>::key_type slot_map<T, Alloc>::emplace(Args &&... args) {
+        auto position = static_cast<uint32_t>(_values.size());
+        _values.emplace_back(std::forward<Args>(args)...);
+
+        uint32_t index;
+        if (_free_head != _npos) {
+            index = _free_head;
+            _free_head = _slots[index].index;
+            _slots[index].index = position;
+            ++_slots[index].generation;
+        } else {
+            index = static_cast<uint32_t>(_slots.size());
+            _slots.push_back({position, 1});
+        }
+        _slot_of.push_back(index);
+        return {index, _slots[index].generation};
+    }
+
+    template<typename T, typename Alloc>
+    bool slot_map<T, Alloc>::erase(key_type key) {
+        if (find(key) == nullptr)
+            return false;
+
+        _slot &slot = _slots[key.index];
+        uint32_t position = slot.index;
+        auto last = static_cast<uint32_t>(_values.size() - 1);
+        if (position != last) {
+            _values[position] = std::move(_values[last]);
+            _slot_of[position] = _slot_of[last];
+            _slots[_slot_of[position]].index = position;
+        }
+        _values.pop_back();
+        _slot_of.pop_back();
+
+        ++slot.generation;
+        slot.index = _free_head;
+        _free_head = key.index;
+        return true;
+    }
+
+    template<typename T, typename Alloc>
+    void slot_map<T, Alloc>::clear() noexcept {
+        for (size_t i = 0; i < _slot_of.size(); ++i) {
+            uint32_t index = _slot_of[i];
+            ++_slots[index].generation;
+            _slots[index].index = _free_head;
+            _free_head = index;
+        }
+        _values.clear();
+        _slot_of.clear();
+    }
+}
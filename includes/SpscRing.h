@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <atomic>
+#include <new>
+#include "Array.hpp"
+#include "Utility.h"
+
+namespace rc {
+    /**
+     * Lock-free, fixed capacity, single producer / single consumer queue.
+     *
+     * Elements live in inline storage (no allocation), indexed by two ever increasing counters:
+     * the producer owns `_tail`, the consumer owns `_head`, each on its own cache line.
+     * Each side also keeps a cached copy of the opposite counter on its line, and only reloads it
+     * (the only cross-core traffic) when the queue looks full or empty.
+     *
+     * @tparam N the capacity, a power of two.
+     */
+    template<typename T, size_t N>
+    class spsc_ring {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "spsc_ring capacity must be a power of two");
+
+    public:
+        using value_type = T;
+
+    private:
+        // uninitialized storage for one element
+        struct _slot {
+            alignas(T) unsigned char bytes[sizeof(T)];
+        };
+
+        // producer side
+        alignas(cache_line_size) std::atomic<size_t> _tail{0};
+        size_t _head_cache = 0;
+
+        // consumer side
+        alignas(cache_line_size) std::atomic<size_t> _head{0};
+        size_t _tail_cache = 0;
+
+        alignas(cache_line_size) rc::array<_slot, N> _slots;
+
+    public:
+        spsc_ring() = default;
+
+        spsc_ring(spsc_ring const &other) = delete;
+
+        spsc_ring &operator=(spsc_ring const &other) = delete;
+
+        ~spsc_ring();
+
+    public:
+
+        //      PRODUCER
+
+        // Adds an element, or returns false if the queue is full.
+        bool try_push(const T &value) { return try_emplace(value); }
+
+        bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+        template<typename... Args>
+        bool try_emplace(Args &&... args);
+
+        // Copies up to `count` elements from `first`, published all at once. Returns the number pushed.
+        template<typename IT>
+        size_t try_push_n(IT first, size_t count);
+
+        //      CONSUMER
+
+        // Moves the oldest element to `out`, or returns false if the queue is empty.
+        bool try_pop(T &out);
+
+        // Moves up to `count` elements to `out`, released all at once. Returns the number popped.
+        template<typename OUT_IT>
+        size_t try_pop_n(OUT_IT out, size_t count);
+
+        //      CAPACITY
+
+        // These are only snapshots when the other side is running.
+        [[nodiscard]] size_t size() const noexcept;
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+
+    private:
+        T *_at(size_t index) { return reinterpret_cast<T *>(_slots[index & (N - 1)].bytes); }
+
+        // free slots seen by the producer, reloading the consumer counter only when needed.
+        size_t _free_slots(size_t tail, size_t wanted);
+
+        // available elements seen by the consumer, reloading the producer counter only when needed.
+        size_t _available(size_t head, size_t wanted);
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, size_t N>
+    spsc_ring<T, N>::~spsc_ring() {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        for (size_t i = _head.load(std::memory_order_relaxed); i != tail; ++i)
+            _at(i)->~T();
+    }
+
+    template<typename T, size_t N>
+    size_t spsc_ring<T, N>::_free_slots(size_t tail, size_t wanted) {
+        size_t free = N - (tail - _head_cache);
+        if (free < wanted) {
+            _head_cache = _head.load(std::memory_order_acquire);
+            free = N - (tail - _head_cache);
+        }
+        return free;
+    }
+
+    template<typename T, size_t N>
+    size_t spsc_ring<T, N>::_available(size_t head, size_t wanted) {
+        size_t available = _tail_cache - head;
+        if (available < wanted) {
+            _tail_cache = _tail.load(std::memory_order_acquire);
+            available = _tail_cache - head;
+        }
+        return available;
+    }
+
+    //      PRODUCER
+
+    template<typename T, size_t N>
+    template<typename... Args>
+    bool spsc_ring<T, N>::try_emplace(Args &&... args) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (_free_slots(tail, 1) == 0)
+            return false;
+
+        new(static_cast<void *>(_at(tail)))T(std::forward<Args>(args)...);
+        // publishes the element: the consumer acquires `_tail` before reading it.
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T, size_t N>
+    template<typename IT>
+    size_t spsc_ring<T, N>::try_push_n(IT first, size_t count) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t free = _free_slots(tail, count);
+        if (count > free)
+            count = free;
+
+        for (size_t i = 0; i < count; ++i, ++first)
+            new(static_cast<void *>(_at(tail + i)))T(*first);
+        if (count)
+            _tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    //      CONSUMER
+
+    template<typename T, size_t N>
+    bool spsc_ring<T, N>::try_pop(T &out) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (_available(head, 1) == 0)
+            return false;
+
+        T *el = _at(head);
+        out = std::move(*el);
+        el->~T();
+        // hands the slot back: the producer acquires `_head` before reusing it.
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename T, size_t N>
+    template<typename OUT_IT>
+    size_t spsc_ring<T, N>::try_pop_n(OUT_IT out, size_t count) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t available = _available(head, count);
+        if (count > available)
+            count = available;
+
+        for (size_t i = 0; i < count; ++i, ++out) {
+            T *el = _at(head + i);
+            *out = std::move(*el);
+            el->~T();
+        }
+        if (count)
+            _head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    //      CAPACITY
+
+    template<typename T, size_t N>
+    size_t spsc_ring<T, N>::size() const noexcept {
+        size_t head = _head.load(std::memory_order_acquire);
+        return _tail.load(std::memory_order_acquire) - head;
+    }
+}
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "VectorIterator.h"
+#include "ReverseIterator.h"
+#include "Utility.h"
+
+namespace rc {
+    /**
+     * Vector with a compile time capacity, stored inline: it never allocates, and can live on the stack.
+     *
+     * The storage is left uninitialized; only the first size() elements are constructed. Growing past N throws
+     * std::length_error, and leaves the vector unchanged.
+     * When T is trivially copyable / destructible, so is the static_vector: it is then copied as raw bytes.
+     */
+    template<typename T, size_t N>
+    class static_vector {
+        static_assert(N > 0, "a static_vector needs room for at least one element");
+
+    public:
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+
+        using iterator = vector_iterator<T>;
+        using reverse_iterator = ReverseIterator<iterator>;
+
+        using const_iterator = vector_iterator<const T>;
+        using const_reverse_iterator = ReverseIterator<const_iterator>;
+
+    private:
+        size_t _size = 0;
+        alignas(T) unsigned char _storage[N * sizeof(T)];
+
+    public:
+        static_vector() noexcept {}
+
+        static_vector(size_t count, const T &value);
+
+        static_vector(std::initializer_list<T> list);
+
+        static_vector(static_vector const &other) requires std::is_trivially_copy_constructible_v<T> = default;
+
+        static_vector(static_vector const &other);
+
+        static_vector(static_vector &&other) noexcept requires std::is_trivially_move_constructible_v<T> = default;
+
+        static_vector(static_vector &&other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+        static_vector &operator=(static_vector const &other) requires std::is_trivially_copy_assignable_v<T> &&
+                                                                      std::is_trivially_destructible_v<T> = default;
+
+        static_vector &operator=(static_vector const &other);
+
+        static_vector &operator=(static_vector &&other) noexcept requires std::is_trivially_move_assignable_v<T> &&
+                                                                          std::is_trivially_destructible_v<T> = default;
+
+        static_vector &operator=(static_vector &&other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+        ~static_vector() requires std::is_trivially_destructible_v<T> = default;
+
+        ~static_vector() { clear(); }
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+
+        [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+
+        [[nodiscard]] static constexpr size_t max_size() noexcept { return N; }
+
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+        [[nodiscard]] bool full() const noexcept { return _size == N; }
+
+        //      ELEMENT ACCESS
+
+        T &back() { return data()[_size - 1]; }
+
+        const T &back() const { return data()[_size - 1]; }
+
+        T &front() { return data()[0]; }
+
+        const T &front() const { return data()[0]; }
+
+        // access specified element with bounds checking
+        T &at(difference_type i);
+
+        const T &at(difference_type i) const;
+
+        T &operator[](difference_type pos) { return data()[pos]; }
+
+        const T &operator[](difference_type pos) const { return data()[pos]; }
+
+        // Direct access to the underlying array
+        T *data() noexcept { return std::launder(reinterpret_cast<T *>(_storage)); }
+
+        const T *data() const noexcept { return std::launder(reinterpret_cast<const T *>(_storage)); }
+
+        //      MODIFIERS
+
+        void push_back(const T &value) { emplace_back(value); }
+
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+
+        // Adds the element, or returns false if the vector is full.
+        bool try_push_back(const T &value);
+
+        void pop_back() { std::destroy_at(data() + --_size); }
+
+        template<typename... Args>
+        T &emplace_back(Args &&... args);
+
+        // Inserts a new element into the container directly before pos.
+        template<typename... Args>
+        iterator emplace(iterator pos, Args &&... args);
+
+        template<typename IT, typename = std::enable_if_t<!std::is_integral_v<IT>>>
+        iterator insert(iterator pos, IT first, IT last);
+
+        iterator insert(iterator pos, size_t count, const T &value);
+
+        iterator insert(iterator pos, const T &value) { return insert(pos, 1, value); }
+
+        iterator insert(iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+
+        iterator erase(iterator pos) { return erase(pos, pos + 1); }
+
+        iterator erase(iterator first, iterator last);
+
+        void resize(size_t count, const T &value = T());
+
+        void clear() noexcept;
+
+    private:
+        static void _check_room(size_t count) {
+            if (count > N)
+                throw std::length_error("static_vector capacity exceeded");
+        }
+
+        // Moves the elements from `index` `count` slots to the right, then constructs the gap with
+        // `construct(slot)`. If a construction throws, the gap is closed again: the vector is unchanged.
+        // If a move throws, the elements from the failed one are lost, but the vector stays valid.
+        template<typename F>
+        void _fill_gap(size_t index, size_t count, F construct);
+
+    public:
+        // BEGIN
+        iterator begin() noexcept { return iterator(data()); }
+
+        const_iterator begin() const noexcept { return const_iterator(data()); }
+
+        const_iterator cbegin() const noexcept { return const_iterator(data()); }
+
+        // END
+        iterator end() noexcept { return iterator(data() + _size); }
+
+        const_iterator end() const noexcept { return const_iterator(data() + _size); }
+
+        const_iterator cend() const noexcept { return const_iterator(data() + _size); }
+
+        // REVERSE BEGIN
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+        // REVERSE END
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, size_t N>
+    static_vector<T, N>::static_vector(size_t count, const T &value) {
+        resize(count, value);
+    }
+
+    template<typename T, size_t N>
+    static_vector<T, N>::static_vector(std::initializer_list<T> list) {
+        _check_room(list.size());
+        for (auto &el: list)
+            emplace_back(el);
+    }
+
+    template<typename T, size_t N>
+    static_vector<T, N>::static_vector(const static_vector &other) {
+        for (const T &el: other)
+            emplace_back(el);
+    }
+
+    template<typename T, size_t N>
+    static_vector<T, N>::static_vector(static_vector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        for (T &el: other)
+            emplace_back(std::move(el));
+    }
+
+    template<typename T, size_t N>
+    static_vector<T, N> &static_vector<T, N>::operator=(const static_vector &other) {
+        if (this != &other) {
+            clear();
+            for (const T &el: other)
+                emplace_back(el);
+        }
+        return *this;
+    }
+
+    template<typename T, size_t N>
+    static_vector<T, N> &static_vector<T, N>::operator=(static_vector &&other)
+    noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            for (T &el: other)
+                emplace_back(std::move(el));
+        }
+        return *this;
+    }
+
+    //      ELEMENT ACCESS
+
+    template<typename T, size_t N>
+    T &static_vector<T, N>::at(difference_type i) {
+        if (i < 0 || static_cast<size_t>(i) >= _size)
+            throw std::out_of_range("index out of bounds");
+        return data()[i];
+    }
+
+    template<typename T, size_t N>
+    const T &static_vector<T, N>::at(difference_type i) const {
+        if (i < 0 || static_cast<size_t>(i) >= _size)
+            throw std::out_of_range("index out of bounds");
+        return data()[i];
+    }
+
+    //      MODIFIERS
+
+    template<typename T, size_t N>
+    bool static_vector<T, N>::try_push_back(const T &value) {
+        if (_size == N)
+            return false;
+        std::construct_at(data() + _size, value);
+        ++_size;
+        return true;
+    }
+
+    template<typename T, size_t N>
+    template<typename... Args>
+    T &static_vector<T, N>::emplace_back(Args &&... args) {
+        _check_room(_size + 1);
+        T *slot = std::construct_at(data() + _size, std::forward<Args>(args)...);
+        ++_size;
+        return *slot;
+    }
+
+    template<typename T, size_t N>
+    template<typename... Args>
+    typename static_vector<T, N>::iterator static_vector<T, N>::emplace(iterator pos, Args &&... args) {
+        size_t index = pos - begin();
+        _check_room(_size + 1);
+        if (index == _size) {
+            emplace_back(std::forward<Args>(args)...);
+            return begin() + index;
+        }
+        // built first: `args` may refer to an element about to move.
+        T value(std::forward<Args>(args)...);
+        _fill_gap(index, 1, [&](T *slot) { std::construct_at(slot, std::move(value)); });
+        return begin() + index;
+    }
+
+    template<typename T, size_t N>
+    template<typename IT, typename>
+    typename static_vector<T, N>::iterator static_vector<T, N>::insert(iterator pos, IT first, IT last) {
+        size_t index = pos - begin();
+        size_t count = rc::distance(first, last);
+        _check_room(_size + count);
+        _fill_gap(index, count, [&](T *slot) { std::construct_at(slot, *first++); });
+        return begin() + index;
+    }
+
+    template<typename T, size_t N>
+    typename static_vector<T, N>::iterator static_vector<T, N>::insert(iterator pos, size_t count, const T &value) {
+        size_t index = pos - begin();
+        _check_room(_size + count);
+        if (count == 0)
+            return pos;
+        // copied first: `value` may be an element about to move.
+        T copy(value);
+        _fill_gap(index, count, [&](T *slot) { std::construct_at(slot, copy); });
+        return begin() + index;
+    }
+
+    template<typename T, size_t N>
+    typename static_vector<T, N>::iterator static_vector<T, N>::erase(iterator first, iterator last) {
+        size_t index = first - begin();
+        size_t count = last - first;
+        if (count == 0)
+            return first;
+
+        T *elements = data();
+        for (size_t i = index; i + count < _size; ++i)
+            elements[i] = std::move(elements[i + count]);
+        for (size_t i = _size - count; i < _size; ++i)
+            std::destroy_at(elements + i);
+        _size -= count;
+        return begin() + index;
+    }
+
+    template<typename T, size_t N>
+    void static_vector<T, N>::resize(size_t count, const T &value) {
+        _check_room(count);
+        while (_size > count)
+            pop_back();
+        while (_size < count)
+            emplace_back(value);
+    }
+
+    template<typename T, size_t N>
+    void static_vector<T, N>::clear() noexcept {
+        T *elements = data();
+        for (size_t i = 0; i < _size; ++i)
+            std::destroy_at(elements + i);
+        _size = 0;
+    }
+
+    //      PRIVATE
+
+    template<typename T, size_t N>
+    template<typename F>
+    void static_vector<T, N>::_fill_gap(size_t index, size_t count, F construct) {
+        T *elements = data();
+        size_t end = _size;
+        size_t i = end;
+        try {
+            for (; i > index; --i) {
+                std::construct_at(elements + i - 1 + count, std::move(elements[i - 1]));
+                std::destroy_at(elements + i - 1);
+            }
+        } catch (...) {
+            // [0, i) are still in place, [i, end) were moved already: drops them.
+            for (size_t j = i; j < end; ++j)
+                std::destroy_at(elements + j + count);
+            _size = i;
+            throw;
+        }
+
+        size_t built = 0;
+        try {
+            for (; built < count; ++built)
+                construct(elements + index + built);
+        } catch (...) {
+            for (size_t j = 0; j < built; ++j)
+                std::destroy_at(elements + index + j);
+            for (size_t j = index; j < end; ++j) {
+                std::construct_at(elements + j, std::move(elements[j + count]));
+                std::destroy_at(elements + j + count);
+            }
+            throw;
+        }
+        _size = end + count;
+    }
+}
@@ -0,0 +1,513 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cstring>
+#include <bit>
+#include <compare>
+#include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "Allocator.h"
+#include "ReverseIterator.h"
+#include "Utility.h"
+#include "VectorIterator.h"
+
+namespace rc {
+    /**
+     * Contiguous, null terminated sequence of characters, 24 bytes large.
+     *
+     * Up to 23 chars (24 / sizeof(CharT) - 1 characters) are stored inline, in the string itself (the small
+     * string optimization): most keys and identifiers never allocate. Longer strings live on the heap, and grow
+     * like rc::vector (see rc::grow_capacity).
+     *
+     * The last byte tells the two apart. Inline, the last character holds the number of unused characters:
+     * it becomes the terminator when the buffer is full. On the heap, it is the top byte of the capacity,
+     * whose highest bit is set.
+     */
+    template<typename CharT, typename Alloc = rc::allocator<CharT>>
+    class basic_string {
+        static_assert(std::endian::native == std::endian::little, "the heap flag is read from the last byte");
+
+    public:
+        using value_type = CharT;
+        using traits_type = std::char_traits<CharT>;
+        using view_type = std::basic_string_view<CharT>;
+        using difference_type = ptrdiff_t;
+
+        using iterator = vector_iterator<CharT>;
+        using reverse_iterator = ReverseIterator<iterator>;
+
+        using const_iterator = vector_iterator<const CharT>;
+        using const_reverse_iterator = ReverseIterator<const_iterator>;
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+    private:
+        struct _heap_rep {
+            CharT *data;
+            size_t size;
+            // capacity | _heap_flag
+            size_t capacity;
+        };
+
+        static constexpr size_t _heap_flag = size_t(1) << (sizeof(size_t) * 8 - 1);
+        static constexpr size_t _inline_capacity = sizeof(_heap_rep) / sizeof(CharT) - 1;
+
+        union _rep {
+            _heap_rep heap;
+            CharT chars[_inline_capacity + 1];
+        };
+
+        _rep _storage;
+
+    public:
+        basic_string() noexcept { _set_inline_size(0); }
+
+        basic_string(const CharT *s) : basic_string(s, traits_type::length(s)) {}
+
+        basic_string(const CharT *s, size_t count);
+
+        basic_string(size_t count, CharT c);
+
+        explicit basic_string(view_type view) : basic_string(view.data(), view.size()) {}
+
+        basic_string(std::initializer_list<CharT> list) : basic_string(list.begin(), list.size()) {}
+
+        template<typename IT, typename = std::enable_if_t<!std::is_integral_v<IT>>>
+        basic_string(IT first, IT last);
+
+        basic_string(basic_string const &other) : basic_string(other.data(), other.size()) {}
+
+        basic_string(basic_string &&other) noexcept;
+
+        basic_string &operator=(basic_string const &other);
+
+        basic_string &operator=(basic_string &&other) noexcept;
+
+        basic_string &operator=(const CharT *s) { return assign(s, traits_type::length(s)); }
+
+        basic_string &operator=(view_type view) { return assign(view.data(), view.size()); }
+
+        ~basic_string() { _release(); }
+
+    public:
+
+        //      CAPACITY
+
+        [[nodiscard]] size_t size() const noexcept {
+            return _is_heap() ? _storage.heap.size : _inline_capacity - _storage.chars[_inline_capacity];
+        }
+
+        [[nodiscard]] size_t length() const noexcept { return size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        // Number of characters that can be held without reallocating, the terminator excluded.
+        [[nodiscard]] size_t capacity() const noexcept {
+            return _is_heap() ? _storage.heap.capacity & ~_heap_flag : _inline_capacity;
+        }
+
+        void reserve(size_t new_cap) {
+            if (new_cap > capacity())
+                _reallocate(new_cap, nullptr, 0);
+        }
+
+        // Moves the characters back inline if they fit, or to an exactly sized buffer.
+        void shrink_to_fit();
+
+        //      ELEMENT ACCESS
+
+        CharT &operator[](size_t pos) { return data()[pos]; }
+
+        const CharT &operator[](size_t pos) const { return data()[pos]; }
+
+        CharT &at(size_t pos);
+
+        const CharT &at(size_t pos) const;
+
+        CharT &front() { return data()[0]; }
+
+        const CharT &front() const { return data()[0]; }
+
+        CharT &back() { return data()[size() - 1]; }
+
+        const CharT &back() const { return data()[size() - 1]; }
+
+        CharT *data() noexcept { return _is_heap() ? _storage.heap.data : _storage.chars; }
+
+        const CharT *data() const noexcept { return _is_heap() ? _storage.heap.data : _storage.chars; }
+
+        const CharT *c_str() const noexcept { return data(); }
+
+        operator view_type() const noexcept { return view_type(data(), size()); }
+
+        //      MODIFIERS
+
+        basic_string &assign(const CharT *s, size_t count);
+
+        basic_string &append(const CharT *s, size_t count);
+
+        basic_string &append(const CharT *s) { return append(s, traits_type::length(s)); }
+
+        basic_string &append(view_type view) { return append(view.data(), view.size()); }
+
+        basic_string &append(size_t count, CharT c);
+
+        basic_string &operator+=(view_type view) { return append(view.data(), view.size()); }
+
+        basic_string &operator+=(const CharT *s) { return append(s); }
+
+        basic_string &operator+=(CharT c) {
+            push_back(c);
+            return *this;
+        }
+
+        void push_back(CharT c);
+
+        void pop_back() { _set_size(size() - 1); }
+
+        // Removes up to `count` characters from `pos`.
+        basic_string &erase(size_t pos, size_t count = npos);
+
+        void resize(size_t count, CharT c = CharT());
+
+        void clear() noexcept { _set_size(0); }
+
+        //      OPERATIONS
+
+        // Position of the first occurrence of `needle` from `pos`, or npos.
+        size_t find(view_type needle, size_t pos = 0) const noexcept;
+
+        size_t find(CharT c, size_t pos = 0) const noexcept;
+
+        // Position of the last occurrence of `c`, or npos.
+        size_t rfind(CharT c) const noexcept { return view_type(*this).rfind(c); }
+
+        [[nodiscard]] bool contains(view_type needle) const noexcept { return find(needle) != npos; }
+
+        [[nodiscard]] bool starts_with(view_type prefix) const noexcept { return view_type(*this).starts_with(prefix); }
+
+        [[nodiscard]] bool ends_with(view_type suffix) const noexcept { return view_type(*this).ends_with(suffix); }
+
+        basic_string substr(size_t pos, size_t count = npos) const;
+
+        int compare(view_type other) const noexcept { return view_type(*this).compare(other); }
+
+        //      ITERATORS
+
+        iterator begin() noexcept { return iterator(data()); }
+
+        const_iterator begin() const noexcept { return const_iterator(data()); }
+
+        const_iterator cbegin() const noexcept { return const_iterator(data()); }
+
+        iterator end() noexcept { return iterator(data() + size()); }
+
+        const_iterator end() const noexcept { return const_iterator(data() + size()); }
+
+        const_iterator cend() const noexcept { return const_iterator(data() + size()); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+        //      NON MEMBER OPERATORS
+
+        friend bool operator==(basic_string const &lhs, basic_string const &rhs) noexcept {
+            return view_type(lhs) == view_type(rhs);
+        }
+
+        friend bool operator==(basic_string const &lhs, view_type rhs) noexcept { return view_type(lhs) == rhs; }
+
+        friend bool operator==(basic_string const &lhs, const CharT *rhs) noexcept { return view_type(lhs) == rhs; }
+
+        friend std::strong_ordering operator<=>(basic_string const &lhs, basic_string const &rhs) noexcept {
+            return lhs.compare(rhs) <=> 0;
+        }
+
+        friend std::strong_ordering operator<=>(basic_string const &lhs, view_type rhs) noexcept {
+            return lhs.compare(rhs) <=> 0;
+        }
+
+        friend std::strong_ordering operator<=>(basic_string const &lhs, const CharT *rhs) noexcept {
+            return lhs.compare(rhs) <=> 0;
+        }
+
+        friend basic_string operator+(basic_string lhs, view_type rhs) {
+            lhs.append(rhs);
+            return lhs;
+        }
+
+        template<typename Traits>
+        friend std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os, basic_string const &s) {
+            return os << view_type(s);
+        }
+
+    private:
+        [[nodiscard]] bool _is_heap() const noexcept {
+            return reinterpret_cast<const unsigned char *>(&_storage)[sizeof(_rep) - 1] >> 7;
+        }
+
+        void _set_inline_size(size_t size) noexcept {
+            _storage.chars[_inline_capacity] = static_cast<CharT>(_inline_capacity - size);
+            _storage.chars[size] = CharT();
+        }
+
+        void _set_size(size_t size) noexcept;
+
+        // Moves the characters (followed by the `count` characters of `append`) to a heap buffer of
+        // `new_cap` characters. `append` may point into the string.
+        void _reallocate(size_t new_cap, const CharT *append, size_t count);
+
+        void _release() noexcept;
+    };
+
+    using string = basic_string<char>;
+    using wstring = basic_string<wchar_t>;
+
+    //              IMPLEMENTATIONS
+
+    template<typename CharT, typename Alloc>
+    basic_string<CharT, Alloc>::basic_string(const CharT *s, size_t count) {
+        _set_inline_size(0);
+        if (count > _inline_capacity)
+            _reallocate(count, s, count);
+        else
+            append(s, count);
+    }
+
+    template<typename CharT, typename Alloc>
+    basic_string<CharT, Alloc>::basic_string(size_t count, CharT c) {
+        _set_inline_size(0);
+        append(count, c);
+    }
+
+    template<typename CharT, typename Alloc>
+    template<typename IT, typename>
+    basic_string<CharT, Alloc>::basic_string(IT first, IT last) {
+        _set_inline_size(0);
+        reserve(rc::distance(first, last));
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    template<typename CharT, typename Alloc>
+    basic_string<CharT, Alloc>::basic_string(basic_string &&other) noexcept : _storage(other._storage) {
+        other._set_inline_size(0);
+    }
+
+    template<typename CharT, typename Alloc>
+    basic_string<CharT, Alloc> &basic_string<CharT, Alloc>::operator=(basic_string const &other) {
+        if (this != &other)
+            assign(other.data(), other.size());
+        return *this;
+    }
+
+    template<typename CharT, typename Alloc>
+    basic_string<CharT, Alloc> &basic_string<CharT, Alloc>::operator=(basic_string &&other) noexcept {
+        if (this != &other) {
+            _release();
+            _storage = other._storage;
+            other._set_inline_size(0);
+        }
+        return *this;
+    }
+
+    //      CAPACITY
+
+    template<typename CharT, typename Alloc>
+    void basic_string<CharT, Alloc>::shrink_to_fit() {
+        if (!_is_heap())
+            return;
+        size_t count = size();
+        if (count <= _inline_capacity) {
+            _heap_rep heap = _storage.heap;
+            traits_type::copy(_storage.chars, heap.data, count);
+            _set_inline_size(count);
+            Alloc alloc;
+            alloc.deallocate(heap.data, (heap.capacity & ~_heap_flag) + 1);
+        } else if (count < capacity()) {
+            _reallocate(count, nullptr, 0);
+        }
+    }
+
+    //      ELEMENT ACCESS
+
+    template<typename CharT, typename Alloc>
+    CharT &basic_string<CharT, Alloc>::at(size_t pos) {
+        if (pos >= size())
+            throw std::out_of_range("index out of bounds");
+        return data()[pos];
+    }
+
+    template<typename CharT, typename Alloc>
+    const CharT &basic_string<CharT, Alloc>::at(size_t pos) const {
+        if (pos >= size())
+            throw std::out_of_range("index out of bounds");
+        return data()[pos];
+    }
+
+    //      MODIFIERS
+
+    template<typename CharT, typename Alloc>
+    basic_string<CharT, Alloc> &basic_string<CharT, Alloc>::assign(const CharT *s, size_t count) {
+        if (count > capacity()) {
+            _set_size(0);
+            _reallocate(count, s, count);
+        } else {
+            traits_type::move(data(), s, count);
+            _set_size(count);
+        }
+        return *this;
+    }
+
+    template<typename CharT, typename Alloc>
+    basic_string<CharT, Alloc> &basic_string<CharT, Alloc>::append(const CharT *s, size_t count) {
+        size_t old_size = size();
+        if (count > capacity() - old_size) {
+            _reallocate(grow_capacity(capacity(), old_size + count), s, count);
+        } else {
+            traits_type::copy(data() + old_size, s, count);
+            _set_size(old_size + count);
+        }
+        return *this;
+    }
+
+    template<typename CharT, typename Alloc>
+    basic_string<CharT, Alloc> &basic_string<CharT, Alloc>::append(size_t count, CharT c) {
+        size_t old_size = size();
+        if (count > capacity() - old_size)
+            _reallocate(grow_capacity(capacity(), old_size + count), nullptr, 0);
+        traits_type::assign(data() + old_size, count, c);
+        _set_size(old_size + count);
+        return *this;
+    }
+
+    template<typename CharT, typename Alloc>
+    void basic_string<CharT, Alloc>::push_back(CharT c) {
+        size_t old_size = size();
+        if (old_size == capacity()) {
+            _reallocate(grow_capacity(old_size, old_size + 1), &c, 1);
+        } else {
+            data()[old_size] = c;
+            _set_size(old_size + 1);
+        }
+    }
+
+    template<typename CharT, typename Alloc>
+    basic_string<CharT, Alloc> &basic_string<CharT, Alloc>::erase(size_t pos, size_t count) {
+        size_t old_size = size();
+        if (pos > old_size)
+            throw std::out_of_range("index out of bounds");
+        if (count > old_size - pos)
+            count = old_size - pos;
+        CharT *chars = data();
+        traits_type::move(chars + pos, chars + pos + count, old_size - pos - count);
+        _set_size(old_size - count);
+        return *this;
+    }
+
+    template<typename CharT, typename Alloc>
+    void basic_string<CharT, Alloc>::resize(size_t count, CharT c) {
+        size_t old_size = size();
+        if (count > old_size)
+            append(count - old_size, c);
+        else
+            _set_size(count);
+    }
+
+    //      OPERATIONS
+
+    template<typename CharT, typename Alloc>
+    size_t basic_string<CharT, Alloc>::find(view_type needle, size_t pos) const noexcept {
+        size_t count = size();
+        if (pos > count || needle.size() > count - pos)
+            return npos;
+        if (needle.empty())
+            return pos;
+        const CharT *chars = data();
+#if defined(__GLIBC__)
+        if constexpr (sizeof(CharT) == 1) {
+            // memmem skips ahead with a two-way search instead of comparing at every position.
+            const void *found = memmem(chars + pos, count - pos, needle.data(), needle.size());
+            return found ? static_cast<const CharT *>(found) - chars : npos;
+        }
+#endif
+        return view_type(chars, count).find(needle, pos);
+    }
+
+    template<typename CharT, typename Alloc>
+    size_t basic_string<CharT, Alloc>::find(CharT c, size_t pos) const noexcept {
+        size_t count = size();
+        if (pos >= count)
+            return npos;
+        const CharT *chars = data();
+        const CharT *found;
+        if constexpr (sizeof(CharT) == 1)
+            found = static_cast<const CharT *>(std::memchr(chars + pos, static_cast<unsigned char>(c), count - pos));
+        else
+            found = traits_type::find(chars + pos, count - pos, c);
+        return found ? found - chars : npos;
+    }
+
+    template<typename CharT, typename Alloc>
+    basic_string<CharT, Alloc> basic_string<CharT, Alloc>::substr(size_t pos, size_t count) const {
+        size_t old_size = size();
+        if (pos > old_size)
+            throw std::out_of_range("index out of bounds");
+        if (count > old_size - pos)
+            count = old_size - pos;
+        return basic_string(data() + pos, count);
+    }
+
+    //      PRIVATE
+
+    template<typename CharT, typename Alloc>
+    void basic_string<CharT, Alloc>::_set_size(size_t size) noexcept {
+        if (_is_heap()) {
+            _storage.heap.size = size;
+            _storage.heap.data[size] = CharT();
+        } else {
+            _set_inline_size(size);
+        }
+    }
+
+    template<typename CharT, typename Alloc>
+    void basic_string<CharT, Alloc>::_reallocate(size_t new_cap, const CharT *append, size_t count) {
+        Alloc alloc;
+        size_t old_size = size();
+        CharT *chars = alloc.allocate(new_cap + 1);
+        traits_type::copy(chars, data(), old_size);
+        if (count)
+            traits_type::copy(chars + old_size, append, count);
+        // `append` may be in the old buffer: it is only released now.
+        _release();
+        _storage.heap.data = chars;
+        _storage.heap.capacity = new_cap | _heap_flag;
+        _storage.heap.size = old_size + count;
+        chars[old_size + count] = CharT();
+    }
+
+    template<typename CharT, typename Alloc>
+    void basic_string<CharT, Alloc>::_release() noexcept {
+        if (_is_heap()) {
+            Alloc alloc;
+            alloc.deallocate(_storage.heap.data, capacity() + 1);
+        }
+    }
+}
+
+template<typename CharT, typename Alloc>
+struct std::hash<rc::basic_string<CharT, Alloc>> {
+    size_t operator()(rc::basic_string<CharT, Alloc> const &s) const noexcept {
+        return std::hash<std::basic_string_view<CharT>>()(s);
+    }
+};
@@ -0,0 +1,501 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "ReverseIterator.h"
+#include "Utility.h"
+
+namespace rc {
+    // links of an unrolled_list node; the list's sentinel is a bare _unrolled_link with no element.
+    struct _unrolled_link {
+        _unrolled_link *next;
+        _unrolled_link *prev;
+        size_t count;
+    };
+
+    template<typename T, size_t K>
+    struct _unrolled_node : _unrolled_link {
+        alignas(T) unsigned char bytes[K * sizeof(T)];
+
+        T *data() { return reinterpret_cast<T *>(bytes); }
+
+        static _unrolled_node *from(_unrolled_link *link) { return static_cast<_unrolled_node *>(link); }
+    };
+
+    /**
+     * Bidirectional iterator of an unrolled_list: a node and an index in it.
+     * @tparam T const qualified for the const iterator.
+     */
+    template<typename T, size_t K>
+    class unrolled_list_iterator {
+        template<typename _T, size_t _K>
+        friend
+        class unrolled_list;
+
+        template<typename _T, size_t _K>
+        friend
+        class unrolled_list_iterator;
+
+    public:
+        using value_type = T;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type *;
+        using const_pointer = value_type const *;
+        using reference = value_type &;
+        using const_reference = value_type const &;
+        using iterator_category = bidirectional_iterator_tag;
+
+    private:
+        using _node = _unrolled_node<std::remove_const_t<T>, K>;
+
+        _unrolled_link *_link = nullptr;
+        size_t _index = 0;
+
+    public:
+        unrolled_list_iterator() = default;
+
+        unrolled_list_iterator(_unrolled_link *link, size_t index) : _link(link), _index(index) {}
+
+        // iterator -> const_iterator
+        template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+        unrolled_list_iterator(unrolled_list_iterator<U, K> const &other) : _link(other._link), _index(other._index) {}
+
+    public:
+        reference operator*() const { return _node::from(_link)->data()[_index]; }
+
+        pointer operator->() const { return _node::from(_link)->data() + _index; }
+
+        unrolled_list_iterator &operator++() {
+            if (++_index == _link->count) {
+                _link = _link->next;
+                _index = 0;
+            }
+            return *this;
+        }
+
+        unrolled_list_iterator operator++(int) {
+            unrolled_list_iterator cpy(*this);
+            ++*this;
+            return cpy;
+        }
+
+        unrolled_list_iterator &operator--() {
+            if (_index == 0) {
+                _link = _link->prev;
+                _index = _link->count;
+            }
+            --_index;
+            return *this;
+        }
+
+        unrolled_list_iterator operator--(int) {
+            unrolled_list_iterator cpy(*this);
+            --*this;
+            return cpy;
+        }
+
+        // Linear steps, needed by ReverseIterator.
+        unrolled_list_iterator operator-(difference_type n) const {
+            unrolled_list_iterator it(*this);
+            for (; n > 0; --n)
+                --it;
+            for (; n < 0; ++n)
+                ++it;
+            return it;
+        }
+
+        unrolled_list_iterator &operator-=(difference_type n) { return *this = *this - n; }
+
+        unrolled_list_iterator &operator+=(difference_type n) { return *this = *this - (-n); }
+
+        // COMPARE
+        bool operator==(const unrolled_list_iterator &rhs) const {
+            return _link == rhs._link && _index == rhs._index;
+        }
+
+        bool operator!=(const unrolled_list_iterator &rhs) const { return !(*this == rhs); }
+    };
+
+    /**
+     * Doubly linked list storing up to K elements per node.
+     *
+     * Compared to rc::list, the two links and the allocation overhead are paid once per K elements,
+     * and iterating walks contiguous arrays. A full node is split in two on insert,
+     * and a node falling under a quarter of its capacity is merged with its successor on erase.
+     *
+     * Inserting or erasing shifts the elements of one node, and invalidates the iterators to that node
+     * (and to its successor when they merge).
+     */
+    template<typename T, size_t K = (sizeof(T) >= 64 ? 4 : 256 / sizeof(T))>
+    class unrolled_list {
+        static_assert(K >= 2, "a node must hold at least two elements");
+
+    public:
+        using value_type = T;
+        using iterator = unrolled_list_iterator<T, K>;
+        using const_iterator = unrolled_list_iterator<const T, K>;
+        using reverse_iterator = ReverseIterator<iterator>;
+        using const_reverse_iterator = ReverseIterator<const_iterator>;
+
+        static constexpr size_t node_capacity = K;
+
+    private:
+        using _node = _unrolled_node<T, K>;
+
+        // circular: _head.next is the first node, _head.prev the last one.
+        _unrolled_link _head;
+        size_t _size = 0;
+
+    public:
+        unrolled_list();
+
+        unrolled_list(unrolled_list const &other);
+
+        unrolled_list(unrolled_list &&other) noexcept;
+
+        unrolled_list &operator=(unrolled_list const &other);
+
+        unrolled_list &operator=(unrolled_list &&other) noexcept;
+
+        unrolled_list(std::initializer_list<T> init);
+
+        ~unrolled_list();
+
+    public:
+
+        void clear();
+
+        void push_back(const T &value) { emplace_back(value); }
+
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+
+        void push_front(const T &value) { emplace_front(value); }
+
+        void push_front(T &&value) { emplace_front(std::move(value)); }
+
+        template<typename... Args>
+        T &emplace_back(Args &&... args);
+
+        template<typename... Args>
+        T &emplace_front(Args &&... args);
+
+        void pop_front();
+
+        void pop_back();
+
+        void resize(size_t count, T value = T());
+
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args &&... args);
+
+        iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+
+        iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+
+        template<typename IT>
+        iterator insert(const_iterator pos, IT first, IT last);
+
+        iterator erase(const_iterator pos);
+
+        iterator erase(const_iterator first, const_iterator last);
+
+        size_t size() const { return _size; }
+
+        bool empty() const { return _size == 0; }
+
+        T &front() { return *begin(); }
+
+        T const &front() const { return *begin(); }
+
+        T &back() { return _last()->data()[_head.prev->count - 1]; }
+
+        T const &back() const { return _last()->data()[_head.prev->count - 1]; }
+
+    public:
+        // BEGIN
+        iterator begin() noexcept { return iterator(_head.next, 0); }
+
+        const_iterator begin() const noexcept { return cbegin(); }
+
+        const_iterator cbegin() const noexcept { return const_iterator(_head.next, 0); }
+
+        // END
+        iterator end() noexcept { return iterator(&_head, 0); }
+
+        const_iterator end() const noexcept { return cend(); }
+
+        const_iterator cend() const noexcept { return const_iterator(const_cast<_unrolled_link *>(&_head), 0); }
+
+        // REVERSE BEGIN
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+        // REVERSE END
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+    private:
+        _node *_last() const { return _node::from(_head.prev); }
+
+        // allocates an empty node linked before `next`.
+        _node *_new_node(_unrolled_link *next);
+
+        // destroys the elements of the node, then unlinks and frees it.
+        void _free_node(_unrolled_link *link);
+
+        // moves the upper half of a full node into a new node following it.
+        void _split(_node *node);
+
+        // shifts [index, count) one place to the right, and constructs the new element at `index`.
+        template<typename... Args>
+        T &_emplace_in(_node *node, size_t index, Args &&... args);
+
+        // an iterator past the last element of a node is normalized to the beginning of the next one.
+        iterator _normalize(_unrolled_link *link, size_t index) {
+            return index == link->count ? iterator(link->next, 0) : iterator(link, index);
+        }
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, size_t K>
+    unrolled_list<T, K>::unrolled_list() {
+        _head.next = _head.prev = &_head;
+        _head.count = 0;
+    }
+
+    template<typename T, size_t K>
+    unrolled_list<T, K>::unrolled_list(const unrolled_list &other) : unrolled_list() {
+        insert(cend(), other.begin(), other.end());
+    }
+
+    template<typename T, size_t K>
+    unrolled_list<T, K>::unrolled_list(unrolled_list &&other) noexcept : unrolled_list() {
+        *this = std::move(other);
+    }
+
+    template<typename T, size_t K>
+    unrolled_list<T, K>::unrolled_list(std::initializer_list<T> init) : unrolled_list() {
+        insert(cend(), init.begin(), init.end());
+    }
+
+    template<typename T, size_t K>
+    unrolled_list<T, K> &unrolled_list<T, K>::operator=(const unrolled_list &other) {
+        if (this != &other) {
+            clear();
+            insert(cend(), other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    template<typename T, size_t K>
+    unrolled_list<T, K> &unrolled_list<T, K>::operator=(unrolled_list &&other) noexcept {
+        if (this != &other) {
+            clear();
+            if (!other.empty()) {
+                // the sentinel is embedded: the first and last nodes must point to ours.
+                _head.next = other._head.next;
+                _head.prev = other._head.prev;
+                _head.next->prev = &_head;
+                _head.prev->next = &_head;
+                _size = other._size;
+                other._head.next = other._head.prev = &other._head;
+                other._size = 0;
+            }
+        }
+        return *this;
+    }
+
+    template<typename T, size_t K>
+    unrolled_list<T, K>::~unrolled_list() {
+        clear();
+    }
+
+    // MODIFIERS
+
+    template<typename T, size_t K>
+    void unrolled_list<T, K>::clear() {
+        while (_head.next != &_head)
+            _free_node(_head.next);
+        _size = 0;
+    }
+
+    template<typename T, size_t K>
+    template<typename... Args>
+    T &unrolled_list<T, K>::emplace_back(Args &&... args) {
+        _node *node = _head.prev == &_head || _head.prev->count == K ? _new_node(&_head) : _last();
+        return _emplace_in(node, node->count, std::forward<Args>(args)...);
+    }
+
+    template<typename T, size_t K>
+    template<typename... Args>
+    T &unrolled_list<T, K>::emplace_front(Args &&... args) {
+        _node *node = _head.next == &_head || _head.next->count == K ? _new_node(_head.next) : _node::from(_head.next);
+        return _emplace_in(node, 0, std::forward<Args>(args)...);
+    }
+
+    template<typename T, size_t K>
+    void unrolled_list<T, K>::pop_front() {
+        erase(cbegin());
+    }
+
+    template<typename T, size_t K>
+    void unrolled_list<T, K>::pop_back() {
+        _node *node = _last();
+        node->data()[--node->count].~T();
+        if (node->count == 0)
+            _free_node(node);
+        --_size;
+    }
+
+    template<typename T, size_t K>
+    void unrolled_list<T, K>::resize(size_t count, T value) {
+        while (_size > count)
+            pop_back();
+        while (_size < count)
+            emplace_back(value);
+    }
+
+    template<typename T, size_t K>
+    template<typename... Args>
+    typename unrolled_list<T, K>::iterator unrolled_list<T, K>::emplace(const_iterator pos, Args &&... args) {
+        _unrolled_link *link = pos._link;
+        size_t index = pos._index;
+
+        // before the first element of a node (or at the end): prefer appending to the previous node.
+        if (index == 0 && link->prev != &_head && link->prev->count < K) {
+            link = link->prev;
+            index = link->count;
+        } else if (link == &_head) {
+            emplace_back(std::forward<Args>(args)...);
+            return iterator(_head.prev, _head.prev->count - 1);
+        }
+
+        _node *node = _node::from(link);
+        if (node->count == K) {
+            _split(node);
+            if (index > node->count) {
+                index -= node->count;
+                node = _node::from(node->next);
+            }
+        }
+        _emplace_in(node, index, std::forward<Args>(args)...);
+        return iterator(node, index);
+    }
+
+    template<typename T, size_t K>
+    template<typename IT>
+    typename unrolled_list<T, K>::iterator unrolled_list<T, K>::insert(const_iterator pos, IT first, IT last) {
+        if (first == last)
+            return iterator(pos._link, pos._index);
+
+        iterator it = emplace(pos, *first);
+        ptrdiff_t count = 1;
+        for (++first; first != last; ++first, ++count)
+            it = emplace(++it, *first);
+        // splits may have moved the first inserted element: walk back to it.
+        return it - (count - 1);
+    }
+
+    template<typename T, size_t K>
+    typename unrolled_list<T, K>::iterator unrolled_list<T, K>::erase(const_iterator pos) {
+        _node *node = _node::from(pos._link);
+        size_t index = pos._index;
+        T *data = node->data();
+
+        for (size_t i = index + 1; i < node->count; ++i)
+            data[i - 1] = std::move(data[i]);
+        data[--node->count].~T();
+        --_size;
+
+        if (node->count == 0) {
+            _unrolled_link *next = node->next;
+            _free_node(node);
+            return iterator(next, 0);
+        }
+
+        // merge an underfull node with its successor, if they fit in one.
+        _unrolled_link *next = node->next;
+        if (node->count < K / 4 && next != &_head && node->count + next->count <= K) {
+            _node *other = _node::from(next);
+            for (size_t i = 0; i < other->count; ++i) {
+                new(static_cast<void *>(data + node->count + i))T(std::move(other->data()[i]));
+            }
+            node->count += other->count;
+            _free_node(other);
+        }
+        return _normalize(node, index);
+    }
+
+    template<typename T, size_t K>
+    typename unrolled_list<T, K>::iterator unrolled_list<T, K>::erase(const_iterator first, const_iterator last) {
+        // merges may move `last`: count the elements first.
+        size_t count = 0;
+        for (const_iterator it = first; it != last; ++it)
+            ++count;
+
+        iterator it(first._link, first._index);
+        for (; count > 0; --count)
+            it = erase(it);
+        return it;
+    }
+
+    //      PRIVATE
+
+    template<typename T, size_t K>
+    typename unrolled_list<T, K>::_node *unrolled_list<T, K>::_new_node(_unrolled_link *next) {
+        auto *node = new _node;
+        node->count = 0;
+        node->next = next;
+        node->prev = next->prev;
+        next->prev->next = node;
+        next->prev = node;
+        return node;
+    }
+
+    template<typename T, size_t K>
+    void unrolled_list<T, K>::_free_node(_unrolled_link *link) {
+        _node *node = _node::from(link);
+        for (size_t i = 0; i < node->count; ++i)
+            node->data()[i].~T();
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        delete node;
+    }
+
+    template<typename T, size_t K>
+    void unrolled_list<T, K>::_split(_node *node) {
+        _node *upper = _new_node(node->next);
+        size_t keep = node->count / 2;
+        for (size_t i = keep; i < node->count; ++i) {
+            new(static_cast<void *>(upper->data() + i - keep))T(std::move(node->data()[i]));
+            node->data()[i].~T();
+        }
+        upper->count = node->count - keep;
+        node->count = keep;
+    }
+
+    template<typename T, size_t K>
+    template<typename... Args>
+    T &unrolled_list<T, K>::_emplace_in(_node *node, size_t index, Args &&... args) {
+        T *data = node->data();
+        if (index == node->count) {
+            new(static_cast<void *>(data + index))T(std::forward<Args>(args)...);
+        } else {
+            // build the value first: `args` may refer to an element of this node.
+            T value(std::forward<Args>(args)...);
+            new(static_cast<void *>(data + node->count))T(std::move(data[node->count - 1]));
+            for (size_t i = node->count - 1; i > index; --i)
+                data[i] = std::move(data[i - 1]);
+            data[index] = std::move(value);
+        }
+        ++node->count;
+        ++_size;
+        return data[index];
+    }
+}
@@ -3,8 +3,22 @@
 //
 
 #pragma once
+
+#include <cstddef>
+
 namespace rc {
 
+// Size of a cache line: data written by different threads is kept this far apart to avoid false sharing.
+
+    inline constexpr size_t cache_line_size = 64;
+
+// Growth policy of the contiguous containers: 1.5 times the current capacity, and at least `min_capacity`.
+
+    constexpr size_t grow_capacity(size_t capacity, size_t min_capacity) noexcept {
+        size_t grown = capacity + capacity / 2;
+        return grown < min_capacity ? min_capacity : grown;
+    }
+
 // Pair
 
     template<typename T1, typename T2>
@@ -47,25 +61,27 @@ namespace rc {
         using iterator_category = random_access_iterator_tag;
     };
 
-    /**
-     * @return the difference between two iterators as a `difference_type` type.
-     */
     template<typename IT>
-    typename iterator_traits<IT>::difference_type distance(IT begin, IT end) {
-        return _distance(begin, end, typename iterator_traits<IT>::iterator_category());
-    }
-
-    template<typename IT>
-    typename iterator_traits<IT>::difference_type _distance(IT begin, IT end, random_access_iterator_tag) {
+    constexpr typename iterator_traits<IT>::difference_type _distance(IT begin, IT end, random_access_iterator_tag) {
         return end - begin;
     }
 
     template<typename IT>
-    typename iterator_traits<IT>::difference_type _distance(IT begin, IT end, input_iterator_tag) {
+    constexpr typename iterator_traits<IT>::difference_type _distance(IT begin, IT end, input_iterator_tag) {
         typename iterator_traits<IT>::difference_type distance = 0;
-        while (begin != end)
+        while (begin != end) {
+            ++begin;
             distance++;
+        }
         return distance;
     }
 
+    /**
+     * @return the difference between two iterators as a `difference_type` type.
+     */
+    template<typename IT>
+    constexpr typename iterator_traits<IT>::difference_type distance(IT begin, IT end) {
+        return _distance(begin, end, typename iterator_traits<IT>::iterator_category());
+    }
+
 }
\ No newline at end of file
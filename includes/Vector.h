@@ -6,7 +6,9 @@
 
 #include <cstddef> // for size_t type
 #include <stdexcept>
+#include <memory>
 #include <new>
+#include <type_traits>
 #include "VectorIterator.h"
 #include "ReverseIterator.h"
 #include "Utility.h"
@@ -29,153 +31,169 @@ namespace rc {
         size_t _size = 0;
         T *_data = nullptr;
     public:
-        vector() = default;
+        constexpr vector() = default;
 
-        vector(vector const &other);
+        constexpr vector(vector const &other);
 
-        vector(vector &&other) noexcept;
+        constexpr vector(vector &&other) noexcept;
 
-        vector &operator=(vector const &other);
+        constexpr vector &operator=(vector const &other);
 
-        vector &operator=(vector &&other) noexcept;
+        constexpr vector &operator=(vector &&other) noexcept;
 
-        vector(std::initializer_list<T> list);
+        constexpr vector(std::initializer_list<T> list);
 
-        ~vector();
+        constexpr ~vector();
 
     public:
 
         //      CAPACITY
 
         //  Returns the number of elements
-        [[nodiscard]] size_t size() const noexcept;
+        [[nodiscard]] constexpr size_t size() const noexcept;
 
         // Returns the number of elements that can be held in currently allocated storage
-        [[nodiscard]] size_t capacity() const noexcept;
+        [[nodiscard]] constexpr size_t capacity() const noexcept;
 
         // increase the capacity of the vector to a value that's greater or equal to new_cap.
-        void reserve(size_t new_cap);
+        constexpr void reserve(size_t new_cap);
 
-        [[nodiscard]] bool empty() const;
+        [[nodiscard]] constexpr bool empty() const;
 
         //      ELEMENT ACCESS
 
         // Access the last and first element
-        T &back();
+        constexpr T &back();
 
-        const T &back() const;
+        constexpr const T &back() const;
 
-        T &front();
+        constexpr T &front();
 
-        const T &front() const;
+        constexpr const T &front() const;
 
         // access specified element with bounds checking
-        T &at(difference_type i);
+        constexpr T &at(difference_type i);
 
-        const T &at(difference_type i) const;
+        constexpr const T &at(difference_type i) const;
 
         // Access specified element
-        const T &operator[](difference_type pos) const;
+        constexpr const T &operator[](difference_type pos) const;
 
-        T &operator[](difference_type pos);
+        constexpr T &operator[](difference_type pos);
 
         // Direct access to the underlying array
-        T *data() noexcept;
+        constexpr T *data() noexcept;
 
-        const T *data() const noexcept;
+        constexpr const T *data() const noexcept;
 
         //      MODIFIERS
 
         // Adds an element to the end
-        void push_back(const T &value);
+        constexpr void push_back(const T &value);
 
-        void push_back(T &&value);
+        constexpr void push_back(T &&value);
 
         // Removes the last element
-        void pop_back();
+        constexpr void pop_back();
 
         // Constructs an element in-place at the end
         template<typename... Args>
-        T &emplace_back(Args &&... args);
+        constexpr T &emplace_back(Args &&... args);
 
         // Inserts a new element into the container directly before pos.
         template<typename... Args>
-        iterator emplace(iterator pos, Args &&... args);
+        constexpr iterator emplace(iterator pos, Args &&... args);
 
         // Inserts elements at the specified pos in the container.
-        template<typename IT>
-        iterator insert(iterator pos, IT first, IT last);
+        template<typename IT, typename = std::enable_if_t<!std::is_integral_v<IT>>>
+        constexpr iterator insert(iterator pos, IT first, IT last);
 
-        iterator insert(iterator pos, size_t count, const T &value);
+        constexpr iterator insert(iterator pos, size_t count, const T &value);
 
-        iterator insert(iterator pos, const T &value);
+        constexpr iterator insert(iterator pos, const T &value);
+
+        constexpr iterator insert(iterator pos, T &&value);
+
+        // Erases the specified elements from the container.
+        constexpr iterator erase(iterator pos);
+
+        constexpr iterator erase(iterator first, iterator last);
 
         // Changes the number of elements stored
-        void resize(size_t count, T value = T());
+        constexpr void resize(size_t count, T value = T());
 
         // Clears the contents
-        void clear() noexcept;
+        constexpr void clear() noexcept;
 
     private:
-        void _grow();
+        constexpr void _grow();
+
+        // grows geometrically, but at least up to `min_capacity`.
+        constexpr void _grow(size_t min_capacity);
 
-        void _realloc(size_t new_capacity);
+        constexpr void _realloc(size_t new_capacity);
 
-        void _move(size_t end_dist, size_t begin_dist, size_t count) {
+        // frees the storage, which must hold no element anymore.
+        constexpr void _release();
+
+        // moves the `end_dist` elements starting at `begin_dist` count slots to the right.
+        // The `count` slots left behind are destroyed, ready to be constructed again.
+        constexpr void _move(size_t end_dist, size_t begin_dist, size_t count) {
             for (size_t i = end_dist; i; --i) {
                 size_t idx = begin_dist + i - 1;
-                new(static_cast<void *>(_data + idx + count ))T(std::move(_data[idx]));
+                std::construct_at(_data + idx + count, std::move(_data[idx]));
+                std::destroy_at(&_data[idx]);
             }
         }
 
     public:
         // BEGIN
-        iterator begin() noexcept { return iterator(_data); }
+        constexpr iterator begin() noexcept { return iterator(_data); }
 
-        const_iterator begin() const noexcept { return const_iterator(_data); }
+        constexpr const_iterator begin() const noexcept { return const_iterator(_data); }
 
-        const_iterator cbegin() const noexcept { return const_iterator(_data); }
+        constexpr const_iterator cbegin() const noexcept { return const_iterator(_data); }
 
         // END
-        iterator end() noexcept { return iterator(_data + _size); }
+        constexpr iterator end() noexcept { return iterator(_data + _size); }
 
-        const_iterator end() const noexcept { return const_iterator(_data + _size); }
+        constexpr const_iterator end() const noexcept { return const_iterator(_data + _size); }
 
-        const_iterator cend() const noexcept { return const_iterator(_data + _size); }
+        constexpr const_iterator cend() const noexcept { return const_iterator(_data + _size); }
 
         // REVERSE BEGIN
-        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
 
-        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(cend()); }
+        constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(cend()); }
 
-        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+        constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
 
         // REVERSE END
-        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
 
-        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(cbegin()); }
+        constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(cbegin()); }
 
-        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+        constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
     };
 
     //              IMPLEMENTATIONS
 
     template<typename T, typename Alloc>
-    vector<T, Alloc>::vector(std::initializer_list<T> list) {
+    constexpr vector<T, Alloc>::vector(std::initializer_list<T> list) {
         reserve(list.size());
         for (auto &el: list)
             push_back(std::move(el));
     }
 
     template<typename T, typename Alloc>
-    vector<T, Alloc>::vector(const vector<T, Alloc> &other) {
+    constexpr vector<T, Alloc>::vector(const vector<T, Alloc> &other) {
         reserve(other.size());
         for (size_t i = 0; i < other.size(); ++i)
             push_back(other[i]);
     }
 
     template<typename T, typename Alloc>
-    vector<T, Alloc>::vector(vector<T, Alloc> &&other) noexcept {
+    constexpr vector<T, Alloc>::vector(vector<T, Alloc> &&other) noexcept {
         _capacity = other._capacity;
         _size = other._size;
         _data = other._data;
@@ -185,12 +203,10 @@ namespace rc {
     }
 
     template<typename T, typename Alloc>
-    vector<T, Alloc> &vector<T, Alloc>::operator=(const vector<T, Alloc> &other) {
+    constexpr vector<T, Alloc> &vector<T, Alloc>::operator=(const vector<T, Alloc> &other) {
         if (this != &other) {
             clear();
-            ::operator delete(_data, sizeof(T) * _capacity);
-            _size = 0;
-            _capacity = 0;
+            _release();
 
             reserve(other.size());
             for (size_t i = 0; i < other.size(); ++i)
@@ -200,10 +216,10 @@ namespace rc {
     }
 
     template<typename T, typename Alloc>
-    vector<T, Alloc> &vector<T, Alloc>::operator=(vector &&other) noexcept {
+    constexpr vector<T, Alloc> &vector<T, Alloc>::operator=(vector &&other) noexcept {
         if (this != &other) {
             clear();
-            ::operator delete(_data, sizeof(T) * _capacity);
+            _release();
 
             _capacity = other._capacity;
             _size = other._size;
@@ -218,40 +234,40 @@ namespace rc {
     //      CAPACITY
 
     template<typename T, typename Alloc>
-    size_t vector<T, Alloc>::size() const noexcept {
+    constexpr size_t vector<T, Alloc>::size() const noexcept {
         return _size;
     }
 
     template<typename T, typename Alloc>
-    size_t vector<T, Alloc>::capacity() const noexcept {
+    constexpr size_t vector<T, Alloc>::capacity() const noexcept {
         return _capacity;
     }
 
     template<typename T, typename Alloc>
-    void vector<T, Alloc>::reserve(size_t new_cap) {
+    constexpr void vector<T, Alloc>::reserve(size_t new_cap) {
         if (new_cap > _capacity)
             _realloc(new_cap);
     }
 
     template<typename T, typename Alloc>
-    bool vector<T, Alloc>::empty() const {
+    constexpr bool vector<T, Alloc>::empty() const {
         return (_size == 0);
     }
 
     //      ELEMENT ACCESS
 
     template<typename T, typename Alloc>
-    T &vector<T, Alloc>::operator[](difference_type pos) {
+    constexpr T &vector<T, Alloc>::operator[](difference_type pos) {
         return _data[pos];
     }
 
     template<typename T, typename Alloc>
-    const T &vector<T, Alloc>::operator[](difference_type pos) const {
+    constexpr const T &vector<T, Alloc>::operator[](difference_type pos) const {
         return _data[pos];
     }
 
     template<typename T, typename Alloc>
-    T &vector<T, Alloc>::at(difference_type i) {
+    constexpr T &vector<T, Alloc>::at(difference_type i) {
         if (i >= _size)
             throw std::out_of_range("index out of bounds");
 
@@ -259,7 +275,7 @@ namespace rc {
     }
 
     template<typename T, typename Alloc>
-    const T &vector<T, Alloc>::at(difference_type i) const {
+    constexpr const T &vector<T, Alloc>::at(difference_type i) const {
         if (i >= _size)
             throw std::out_of_range("index out of bounds");
 
@@ -267,34 +283,34 @@ namespace rc {
     }
 
     template<typename T, typename Alloc>
-    T &vector<T, Alloc>::back() {
+    constexpr T &vector<T, Alloc>::back() {
         return _data[_size - 1];
     }
 
     template<typename T, typename Alloc>
-    const T &vector<T, Alloc>::back() const {
+    constexpr const T &vector<T, Alloc>::back() const {
         return _data[_size - 1];
     }
 
     template<typename T, typename Alloc>
-    T &vector<T, Alloc>::front() {
+    constexpr T &vector<T, Alloc>::front() {
         return _data[0];
     }
 
     template<typename T, typename Alloc>
-    const T &vector<T, Alloc>::front() const {
+    constexpr const T &vector<T, Alloc>::front() const {
         return _data[0];
     }
 
     template<typename T, typename Alloc>
-    const T *vector<T, Alloc>::data() const noexcept {
+    constexpr const T *vector<T, Alloc>::data() const noexcept {
         if (_size == 0)
             return nullptr;
         return _data;
     }
 
     template<typename T, typename Alloc>
-    T *vector<T, Alloc>::data() noexcept {
+    constexpr T *vector<T, Alloc>::data() noexcept {
         if (_size == 0)
             return nullptr;
         return _data;
@@ -304,14 +320,14 @@ namespace rc {
     //      MODIFIERS
 
     template<typename T, typename Alloc>
-    vector<T, Alloc>::~vector() {
+    constexpr vector<T, Alloc>::~vector() {
         clear();
-        ::operator delete(_data, sizeof(T) * _capacity);
+        _release();
     }
 
     template<typename T, typename Alloc>
     template<typename... Args>
-    T &vector<T, Alloc>::emplace_back(Args &&... args) {
+    constexpr T &vector<T, Alloc>::emplace_back(Args &&... args) {
         if (_size >= _capacity)
             _grow();
 
@@ -319,45 +335,47 @@ namespace rc {
         // _first[_size] = T(std::forward<Args>(args)...);
 
         //This version construct the object directly in _first, like std::vector does :
-        new(static_cast<void *>(_data + _size))T(std::forward<Args>(args)...);
+        std::construct_at(_data + _size, std::forward<Args>(args)...);
         return _data[_size++];
     }
 
     template<typename T, typename Alloc>
-    void vector<T, Alloc>::push_back(T &&value) {
+    constexpr void vector<T, Alloc>::push_back(T &&value) {
         if (_size >= _capacity)
             _grow();
 
-        new(static_cast<void *>(_data + _size++))T(std::move(value));
+        std::construct_at(_data + _size++, std::move(value));
     }
 
     template<typename T, typename Alloc>
-    void vector<T, Alloc>::push_back(const T &value) {
+    constexpr void vector<T, Alloc>::push_back(const T &value) {
         if (_size >= _capacity)
             _grow();
 
-        new(static_cast<void *>(_data + _size++))T(value);
+        std::construct_at(_data + _size++, value);
     }
 
     template<typename T, typename Alloc>
-    void vector<T, Alloc>::pop_back() {
-        _data[--_size].~T();
+    constexpr void vector<T, Alloc>::pop_back() {
+        std::destroy_at(&_data[--_size]);
     }
 
 
     template<typename T, typename Alloc>
-    void vector<T, Alloc>::clear() noexcept {
+    constexpr void vector<T, Alloc>::clear() noexcept {
         for (size_t i = 0; i < _size; ++i)
-            _data[i].~T();
+            std::destroy_at(&_data[i]);
         _size = 0;
     }
 
     //      PRIVATE
     template<typename T, typename Alloc>
-    void vector<T, Alloc>::_realloc(size_t new_capacity) {
+    constexpr void vector<T, Alloc>::_realloc(size_t new_capacity) {
         Alloc alloc;
 
         if (_size == 0) {
+            if (_data)
+                alloc.deallocate(_data, _capacity);
             _data = alloc.allocate(new_capacity);
             _capacity = new_capacity;
             return;
@@ -382,49 +400,75 @@ namespace rc {
 
 
     template<typename T, typename Alloc>
-    void vector<T, Alloc>::_grow() {
-        if (_size == 0)
-            _realloc(2);
-        else
-            _realloc(_capacity + _capacity / 2);
+    constexpr void vector<T, Alloc>::_release() {
+        if (_data) {
+            Alloc alloc;
+            alloc.deallocate(_data, _capacity);
+        }
+        _data = nullptr;
+        _capacity = 0;
     }
 
     template<typename T, typename Alloc>
-    void vector<T, Alloc>::resize(size_t count, T value) {
+    constexpr void vector<T, Alloc>::_grow() {
+        _grow(_size == 0 ? 2 : _size + 1);
+    }
+
+    template<typename T, typename Alloc>
+    constexpr void vector<T, Alloc>::_grow(size_t min_capacity) {
+        _realloc(grow_capacity(_capacity, min_capacity));
+    }
+
+    template<typename T, typename Alloc>
+    constexpr void vector<T, Alloc>::resize(size_t count, T value) {
         if (_size > count) {
+            for (size_t i = count; i < _size; ++i)
+                std::destroy_at(&_data[i]);
             _size = count;
         } else if (_size < count) {
-            _realloc(count);
+            reserve(count);
             for (size_t i = _size; i < count; ++i)
-                new(static_cast<void *>(_data + i))T(value);
+                std::construct_at(_data + i, value);
             _size = count;
         }
     }
 
     template<typename T, typename Alloc>
     template<typename... Args>
-    typename vector<T, Alloc>::iterator vector<T, Alloc>::emplace(const vector::iterator pos, Args &&... args) {
+    constexpr typename vector<T, Alloc>::iterator vector<T, Alloc>::emplace(const vector::iterator pos, Args &&... args) {
         size_t end_dist = distance(pos, end());
         size_t begin_dist = distance(begin(), pos);
 
-        _realloc(_size + 1);
-        _size += 1;
+        if (_size + 1 > _capacity)
+            _grow(_size + 1);
+        if (end_dist == 0) {
+            std::construct_at(_data + _size, std::forward<Args>(args)...);
+            _size += 1;
+            return begin() + begin_dist;
+        }
 
+        // built before the elements move: if it throws, the vector is unchanged.
+        T value(std::forward<Args>(args)...);
         _move(end_dist, begin_dist, 1);
-
-        new(static_cast<void *>(_data + begin_dist))T(std::forward<Args>(args)...);
+        std::construct_at(_data + begin_dist, std::move(value));
+        _size += 1;
 
         return begin() + begin_dist;
     }
 
     template<typename T, typename Alloc>
-    typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(const vector::iterator pos, const T &value) {
+    constexpr typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(const vector::iterator pos, const T &value) {
         return insert(pos, 1, value);
     }
 
     template<typename T, typename Alloc>
-    template<typename IT>
-    typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(const vector::iterator pos, IT first, IT last) {
+    constexpr typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(const vector::iterator pos, T &&value) {
+        return emplace(pos, std::move(value));
+    }
+
+    template<typename T, typename Alloc>
+    template<typename IT, typename>
+    constexpr typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(const vector::iterator pos, IT first, IT last) {
         size_t count = rc::distance(first, last);
         if (count == 0) // avoids unnecessary calls to distance() ...
             return pos;
@@ -432,34 +476,58 @@ namespace rc {
         size_t end_dist = distance(pos, end());
         size_t begin_dist = distance(begin(), pos);
 
-        _realloc(_size + count);
+        if (_size + count > _capacity)
+            _grow(_size + count);
         _size += count;
 
         // moves all elements after `pos` count times.
         _move(end_dist, begin_dist, count);
 
         for (size_t i = 0; i < count; ++i)
-            new(static_cast<void *>(_data + begin_dist + i))T(*first++);
+            std::construct_at(_data + begin_dist + i, *first++);
 
         return begin() + begin_dist;
     }
 
     template<typename T, typename Alloc>
-    typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(const vector::iterator pos, size_t count, const T &value) {
+    constexpr typename vector<T, Alloc>::iterator vector<T, Alloc>::insert(const vector::iterator pos, size_t count, const T &value) {
         if (count == 0) // avoids unnecessary calls to distance() ...
             return pos;
 
         size_t end_dist = distance(pos, end());
         size_t begin_dist = distance(begin(), pos);
 
-        _realloc(_size + count);
+        if (_size + count > _capacity)
+            _grow(_size + count);
         _size += count;
 
         // moves all elements after `pos` count times.
         _move(end_dist, begin_dist, count);
 
         for (size_t i = 0; i < count; ++i)
-            new(static_cast<void *>(_data + begin_dist + i))T(value);
+            std::construct_at(_data + begin_dist + i, value);
+
+        return begin() + begin_dist;
+    }
+
+    template<typename T, typename Alloc>
+    constexpr typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(const vector::iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    template<typename T, typename Alloc>
+    constexpr typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(const vector::iterator first, const vector::iterator last) {
+        size_t count = distance(first, last);
+        size_t begin_dist = distance(begin(), first);
+        if (count == 0)
+            return first;
+
+        // shifts the tail over the erased elements, then destroys the moved-from leftovers.
+        for (size_t i = begin_dist; i + count < _size; ++i)
+            _data[i] = std::move(_data[i + count]);
+        for (size_t i = _size - count; i < _size; ++i)
+            std::destroy_at(&_data[i]);
+        _size -= count;
 
         return begin() + begin_dist;
     }
@@ -28,59 +28,59 @@ namespace rc {
         pointer _ptr;
 
     public:
-        vector_iterator() : _ptr(nullptr) {}
+        constexpr vector_iterator() : _ptr(nullptr) {}
 
-        explicit vector_iterator(pointer ptr) : _ptr(ptr) {}
+        constexpr explicit vector_iterator(pointer ptr) : _ptr(ptr) {}
 
-        vector_iterator(vector_iterator const &other) = default;
+        constexpr vector_iterator(vector_iterator const &other) = default;
 
-        vector_iterator &operator=(vector_iterator const &other) = default;
+        constexpr vector_iterator &operator=(vector_iterator const &other) = default;
 
-        ~vector_iterator() = default;
+        constexpr ~vector_iterator() = default;
 
     public:
         // POINTER
 
-        reference operator*() { return *_ptr; }
+        constexpr reference operator*() { return *_ptr; }
 
-        const_reference operator*() const { return *_ptr; }
+        constexpr const_reference operator*() const { return *_ptr; }
 
-        pointer operator->() { return _ptr; }
+        constexpr pointer operator->() { return _ptr; }
 
-        const_pointer operator->() const { return _ptr; }
+        constexpr const_pointer operator->() const { return _ptr; }
 
         // INCREMENT / DECREMENT
 
         // +
-        vector_iterator &operator++() {
+        constexpr vector_iterator &operator++() {
             ++_ptr;
             return *this;
         }
 
-        vector_iterator operator++(int) {
+        constexpr vector_iterator operator++(int) {
             vector_iterator cpy(*this);
             ++_ptr;
             return cpy;
         }
 
-        vector_iterator &operator--() {
+        constexpr vector_iterator &operator--() {
             --_ptr;
             return *this;
         }
 
         // -
-        vector_iterator operator--(int) {
+        constexpr vector_iterator operator--(int) {
             vector_iterator cpy(*this);
             --_ptr;
             return cpy;
         }
 
-        vector_iterator &operator-=(const difference_type i) {
+        constexpr vector_iterator &operator-=(const difference_type i) {
             _ptr -= i;
             return *this;
         }
 
-        vector_iterator &operator+=(const difference_type i) {
+        constexpr vector_iterator &operator+=(const difference_type i) {
             _ptr += i;
             return *this;
         }
@@ -88,55 +88,55 @@ namespace rc {
         // ARITHMETIC
 
         // it = begin() - scalar;
-        vector_iterator operator-(const difference_type i) const {
+        constexpr vector_iterator operator-(const difference_type i) const {
             return vector_iterator(_ptr - i);
         }
 
         // diff = begin() - it;
         template<typename U>
-        friend typename vector_iterator<U>::difference_type
+        friend constexpr typename vector_iterator<U>::difference_type
         operator-(const vector_iterator<U> &lhs, const vector_iterator<U> &rhs);
 
 
         // it = begin() + scalar;
-        vector_iterator operator+(const difference_type i) const {
+        constexpr vector_iterator operator+(const difference_type i) const {
             return vector_iterator(_ptr + i);
         }
 
         // it = scalar + it;
         template<typename U>
-        friend vector_iterator<U>
+        friend constexpr vector_iterator<U>
         operator+(typename vector_iterator<U>::difference_type i, const vector_iterator<U> &rhs);
 
 
         // ACCESS ELEMENTS
-        reference operator[](difference_type val) { return (*(_ptr + val)); }
+        constexpr reference operator[](difference_type val) { return (*(_ptr + val)); }
 
-        const_reference operator[](difference_type val) const { return (*(_ptr + val)); }
+        constexpr const_reference operator[](difference_type val) const { return (*(_ptr + val)); }
 
         // COMPARE
-        bool operator==(const vector_iterator &rhs) const { return this->_ptr == rhs._ptr; }
+        constexpr bool operator==(const vector_iterator &rhs) const { return this->_ptr == rhs._ptr; }
 
-        bool operator!=(const vector_iterator &rhs) const { return this->_ptr != rhs._ptr; }
+        constexpr bool operator!=(const vector_iterator &rhs) const { return this->_ptr != rhs._ptr; }
 
-        bool operator<(const vector_iterator &rhs) const { return this->_ptr < rhs._ptr; }
+        constexpr bool operator<(const vector_iterator &rhs) const { return this->_ptr < rhs._ptr; }
 
-        bool operator<=(const vector_iterator &rhs) const { return this->_ptr <= rhs._ptr; }
+        constexpr bool operator<=(const vector_iterator &rhs) const { return this->_ptr <= rhs._ptr; }
 
-        bool operator>(const vector_iterator &rhs) const { return this->_ptr > rhs._ptr; }
+        constexpr bool operator>(const vector_iterator &rhs) const { return this->_ptr > rhs._ptr; }
 
-        bool operator>=(const vector_iterator &rhs) const { return this->_ptr >= rhs._ptr; }
+        constexpr bool operator>=(const vector_iterator &rhs) const { return this->_ptr >= rhs._ptr; }
     };
 
     template<typename U>
-    typename vector_iterator<U>::difference_type
+    constexpr typename vector_iterator<U>::difference_type
     operator-(const vector_iterator<U> &lhs, const vector_iterator<U> &rhs) {
         return lhs._ptr - rhs._ptr;
     }
 
 
     template<typename U>
-    vector_iterator<U>
+    constexpr vector_iterator<U>
     operator+(typename vector_iterator<U>::difference_type i, const vector_iterator<U> &rhs) {
         return rhs._ptr + i;
     }
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <cstddef> // for size_t type
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include "Allocator.h"
+#include "Utility.h"
+
+namespace rc {
+    /**
+     * Unbounded lock-free work-stealing deque (Chase-Lev), with the C11 memory orderings of Lê et al.
+     *
+     * The owner thread pushes and pops at the bottom, without any atomic read-modify-write unless the deque is
+     * nearly empty. Other threads steal the oldest elements at the top, claiming them with a CAS on `_top`.
+     * A batch steal claims up to `max_steal` elements (and at most half of them) with a single CAS.
+     *
+     * `_top` packs the top index (32 low bits) with a 32-bit version. Since a batch steal may claim any element
+     * within `max_steal` of the top, the owner races for such an element by bumping the version with a CAS,
+     * which fails every steal that read `_top` before. A thief is only fooled if it stalls between its read of
+     * `_top` and its CAS while the owner takes 2^32 elements near the same top index.
+     * The indices wrap around: the deque holds less than 2^31 elements.
+     *
+     * The elements are in a circular array of atomic slots, so a thief may read a slot the owner is writing:
+     * it throws the value away when its CAS fails. When it's full, the owner copies the array into one twice as
+     * large; the old arrays are kept until the deque is destroyed, since a thief may still read them (they add
+     * up to less than the current one).
+     *
+     * @tparam T a trivially copyable type, like a task pointer or index.
+     */
+    template<typename T, typename Alloc = rc::allocator<T>>
+    class work_stealing_deque {
+        static_assert(std::is_trivially_copyable_v<T>, "work_stealing_deque elements are copied by racing threads");
+
+    public:
+        using value_type = T;
+
+        // most elements taken by a single steal_batch()
+        static constexpr size_t max_steal = 32;
+
+    private:
+        struct _array {
+            std::atomic<T> *slots;
+            size_t mask;
+            // the array this one replaced
+            _array *previous;
+
+            T get(uint32_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+
+            void put(uint32_t i, T value) { slots[i & mask].store(value, std::memory_order_relaxed); }
+        };
+
+        using _array_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<_array>;
+        using _slot_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<std::atomic<T>>;
+
+        alignas(cache_line_size) std::atomic<uint64_t> _top{0};
+        alignas(cache_line_size) std::atomic<uint32_t> _bottom{0};
+        std::atomic<_array *> _array_ptr;
+
+    public:
+        // The capacity is rounded up to a power of two.
+        explicit work_stealing_deque(size_t capacity = 64);
+
+        work_stealing_deque(work_stealing_deque const &other) = delete;
+
+        work_stealing_deque &operator=(work_stealing_deque const &other) = delete;
+
+        // Not thread safe: no other thread may use the deque anymore.
+        ~work_stealing_deque();
+
+    public:
+
+        //      OWNER
+
+        // Adds an element at the bottom, growing the array if it is full.
+        void push(T value);
+
+        // Takes the newest element, or returns false if the deque is empty.
+        bool try_pop(T &out);
+
+        [[nodiscard]] size_t capacity() const noexcept { return _array_ptr.load(std::memory_order_relaxed)->mask + 1; }
+
+        //      THIEVES
+
+        // Takes the oldest element, or returns false if the deque is empty or another thread took it first.
+        bool try_steal(T &out) { return steal_batch(&out, 1) == 1; }
+
+        // Takes the up to `max` (and `max_steal`) oldest elements, but no more than half of them, to `out`,
+        // oldest first. Returns how many, 0 if the deque is empty or another thread took them first.
+        size_t steal_batch(T *out, size_t max);
+
+        //      ANY THREAD
+
+        // Only a snapshot while other threads are running.
+        [[nodiscard]] size_t size() const noexcept;
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    private:
+        static uint32_t _index(uint64_t top) { return static_cast<uint32_t>(top); }
+
+        // `top` with another index, and the next version.
+        static uint64_t _bump(uint64_t top, uint32_t index) { return ((top >> 32) + 1) << 32 | index; }
+
+        // elements in [top, bottom), negative if bottom is before top.
+        static int64_t _distance(uint32_t top, uint32_t bottom) { return static_cast<int32_t>(bottom - top); }
+
+        static _array *_new_array(size_t capacity);
+
+        static void _free_array(_array *array);
+
+        // copies [top, bottom) in an array twice as large, and publishes it.
+        _array *_grow(_array *array, uint32_t top, uint32_t bottom);
+    };
+
+    //              IMPLEMENTATIONS
+
+    template<typename T, typename Alloc>
+    work_stealing_deque<T, Alloc>::work_stealing_deque(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+        _array_ptr.store(_new_array(size), std::memory_order_relaxed);
+    }
+
+    template<typename T, typename Alloc>
+    work_stealing_deque<T, Alloc>::~work_stealing_deque() {
+        _array *array = _array_ptr.load(std::memory_order_acquire);
+        while (array) {
+            _array *previous = array->previous;
+            _free_array(array);
+            array = previous;
+        }
+    }
+
+    //      OWNER
+
+    template<typename T, typename Alloc>
+    void work_stealing_deque<T, Alloc>::push(T value) {
+        uint32_t b = _bottom.load(std::memory_order_relaxed);
+        uint32_t t = _index(_top.load(std::memory_order_acquire));
+        _array *array = _array_ptr.load(std::memory_order_relaxed);
+        if (_distance(t, b) > static_cast<int64_t>(array->mask))
+            array = _grow(array, t, b);
+        array->put(b, value);
+        // publishes the element before the new bottom.
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    template<typename T, typename Alloc>
+    bool work_stealing_deque<T, Alloc>::try_pop(T &out) {
+        while (true) {
+            uint32_t b = _bottom.load(std::memory_order_relaxed) - 1;
+            _array *array = _array_ptr.load(std::memory_order_relaxed);
+            // reserves the element, then checks whether a thief may claim it too.
+            _bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            uint64_t top = _top.load(std::memory_order_relaxed);
+            uint32_t t = _index(top);
+            int64_t left = _distance(t, b);
+            if (left < 0) {
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+            out = array->get(b);
+            // a steal started from `top` stops before b.
+            if (left >= static_cast<int64_t>(max_steal))
+                return true;
+
+            // races the thieves for b: the last element is taken from the top, else only the version changes.
+            uint64_t taken = _bump(top, t == b ? t + 1 : t);
+            bool won = _top.compare_exchange_strong(top, taken, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+            if (t == b) {
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return won;
+            }
+            if (won)
+                return true;
+            // a thief claimed some elements, maybe b: starts over.
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+    }
+
+    //      THIEVES
+
+    template<typename T, typename Alloc>
+    size_t work_stealing_deque<T, Alloc>::steal_batch(T *out, size_t max) {
+        uint64_t top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t b = _bottom.load(std::memory_order_acquire);
+        uint32_t t = _index(top);
+        int64_t available = _distance(t, b);
+        if (available <= 0)
+            return 0;
+
+        auto count = static_cast<size_t>((available + 1) / 2);
+        if (count > max)
+            count = max;
+        if (count > max_steal)
+            count = max_steal;
+        // the slots may be overwritten meanwhile, but only after the elements were taken: then the CAS fails.
+        _array *array = _array_ptr.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i)
+            out[i] = array->get(t + static_cast<uint32_t>(i));
+        // keeps the version: only the owner bumps it.
+        uint64_t taken = (top & ~uint64_t(UINT32_MAX)) | static_cast<uint32_t>(t + count);
+        if (!_top.compare_exchange_strong(top, taken, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return 0;
+        return count;
+    }
+
+    //      ANY THREAD
+
+    template<typename T, typename Alloc>
+    size_t work_stealing_deque<T, Alloc>::size() const noexcept {
+        uint32_t t = _index(_top.load(std::memory_order_acquire));
+        uint32_t b = _bottom.load(std::memory_order_acquire);
+        int64_t size = _distance(t, b);
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+
+    //      PRIVATE
+
+    template<typename T, typename Alloc>
+    typename work_stealing_deque<T, Alloc>::_array *work_stealing_deque<T, Alloc>::_new_array(size_t capacity) {
+        _array_alloc array_alloc;
+        _slot_alloc slot_alloc;
+        _array *array = array_alloc.allocate(1);
+        array->slots = slot_alloc.allocate(capacity);
+        for (size_t i = 0; i < capacity; ++i)
+            new(static_cast<void *>(array->slots + i))std::atomic<T>();
+        array->mask = capacity - 1;
+        array->previous = nullptr;
+        return array;
+    }
+
+    template<typename T, typename Alloc>
+    void work_stealing_deque<T, Alloc>::_free_array(_array *array) {
+        _array_alloc array_alloc;
+        _slot_alloc slot_alloc;
+        slot_alloc.deallocate(array->slots, array->mask + 1);
+        array_alloc.deallocate(array, 1);
+    }
+
+    template<typename T, typename Alloc>
+    typename work_stealing_deque<T, Alloc>::_array *
+    work_stealing_deque<T, Alloc>::_grow(_array *array, uint32_t top, uint32_t bottom) {
+        _array *grown = _new_array(2 * (array->mask + 1));
+        for (uint32_t i = top; i != bottom; ++i)
+            grown->put(i, array->get(i));
+        grown->previous = array;
+        _array_ptr.store(grown, std::memory_order_release);
+        return grown;
+    }
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../includes/BTree.h"
+
+// key whose copy throws once `copies_left` copies were made.
+struct fragile {
+    static inline int copies_left = 0;
+    std::string value;
+
+    explicit fragile(std::string value) : value(std::move(value)) {}
+
+    fragile(fragile const &other) : value(other.value) {
+        if (copies_left-- == 0)
+            throw std::runtime_error("copy failed");
+    }
+
+    fragile(fragile &&other) noexcept = default;
+
+    bool operator<(fragile const &rhs) const { return value < rhs.value; }
+};
+
+class BTreeFuncTest : public ::testing::Test {
+protected:
+    // compares every element, in both directions.
+    template<typename Map, typename Expected>
+    static void check(Map const &map, Expected const &expected) {
+        ASSERT_EQ(map.size(), expected.size());
+        auto it = map.begin();
+        for (auto &element: expected) {
+            ASSERT_TRUE(it != map.end());
+            ASSERT_EQ((*it).first, element.first);
+            ASSERT_EQ(it->second, element.second);
+            ++it;
+        }
+        ASSERT_TRUE(it == map.end());
+        for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit) {
+            --it;
+            ASSERT_EQ((*it).first, rit->first);
+        }
+    }
+
+    // random inserts and erases, checked against std::map.
+    template<typename K>
+    static void random_operations(size_t operations, size_t range, K (*make)(size_t)) {
+        rc::btree_map<K, size_t> map;
+        std::map<K, size_t> expected;
+        std::mt19937 gen(7);
+        for (size_t i = 0; i < operations; ++i) {
+            K key = make(gen() % range);
+            if (gen() % 3) {
+                auto result = map.insert({key, i});
+                bool inserted = expected.insert({key, i}).second;
+                ASSERT_EQ(result.second, inserted);
+                ASSERT_EQ((*result.first).first, key);
+            } else {
+                ASSERT_EQ(map.erase(key), expected.erase(key));
+            }
+        }
+        check(map, expected);
+        for (size_t i = 0; i < range; ++i) {
+            K key = make(i);
+            ASSERT_EQ(map.contains(key), expected.count(key) == 1);
+            auto lower = map.lower_bound(key);
+            auto expected_lower = expected.lower_bound(key);
+            ASSERT_EQ(lower == map.end(), expected_lower == expected.end());
+            if (expected_lower != expected.end()) {
+                ASSERT_EQ(lower->first, expected_lower->first);
+            }
+        }
+
+        // erases everything, so that every node is merged back.
+        for (auto &element: expected)
+            ASSERT_EQ(map.erase(element.first), 1);
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(map.height(), 0);
+    }
+};
+
+TEST_F(BTreeFuncTest, int_keys) {
+    random_operations<int>(200000, 50000, [](size_t i) { return static_cast<int>(i) - 25000; });
+}
+
+TEST_F(BTreeFuncTest, unsigned_and_wide_keys) {
+    random_operations<uint32_t>(50000, 20000, [](size_t i) { return static_cast<uint32_t>(i * 214013u); });
+    random_operations<int64_t>(50000, 20000, [](size_t i) { return static_cast<int64_t>(i) * -7; });
+}
+
+TEST_F(BTreeFuncTest, string_keys) {
+    // 8 keys per node: a deep tree.
+    EXPECT_EQ(rc::btree_node_slots<std::string>, 8);
+    random_operations<std::string>(20000, 5000, [](size_t i) { return "key-" + std::to_string(i); });
+}
+
+TEST_F(BTreeFuncTest, map_access) {
+    rc::btree_map<int, std::string> map = {{3, "three"}, {1, "one"}, {2, "two"}};
+    EXPECT_EQ(map.at(2), "two");
+    EXPECT_THROW(map.at(4), std::out_of_range);
+    map[4] = "four";
+    map[1] += "!";
+    EXPECT_EQ(map.at(1), "one!");
+    EXPECT_EQ(map.count(4), 1);
+    EXPECT_EQ(map.upper_bound(2)->first, 3);
+    EXPECT_TRUE(map.find(5) == map.end());
+
+    auto it = map.erase(map.find(2));
+    EXPECT_EQ(it->first, 3);
+    EXPECT_EQ(map.size(), 3);
+
+    rc::btree_map<int, std::string> copy = map;
+    rc::btree_map<int, std::string> moved = std::move(map);
+    EXPECT_TRUE(map.empty());
+    check(copy, std::map<int, std::string>{{1, "one!"}, {3, "three"}, {4, "four"}});
+    check(moved, std::map<int, std::string>{{1, "one!"}, {3, "three"}, {4, "four"}});
+}
+
+TEST_F(BTreeFuncTest, insert_throws) {
+    auto keys = [](rc::btree_map<fragile, int> const &map) {
+        std::vector<std::string> result;
+        for (auto it = map.begin(); it != map.end(); ++it)
+            result.push_back(it->first.value);
+        return result;
+    };
+
+    rc::btree_map<fragile, int> map;
+    rc::Pair<fragile, int> first{fragile("a"), 1};
+    fragile::copies_left = 0;
+    EXPECT_THROW(map.insert(first), std::runtime_error);
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.height(), 0);
+
+    // inserts each key once with a copy failing in the key, or for a full leaf, in the separator of the split.
+    std::vector<std::string> expected;
+    for (int i = 0; i < 500; ++i) {
+        std::string key = std::to_string(i * 7919 % 500);
+        rc::Pair<fragile, int> element{fragile(key), i};
+        fragile::copies_left = i % 2;
+        size_t height = map.height();
+        try {
+            map.insert(element);
+            ASSERT_EQ(i % 2, 1) << "the key copy should have failed";
+        } catch (std::runtime_error const &) {
+            ASSERT_EQ(map.size(), expected.size()) << "a failed insert changes nothing";
+            ASSERT_EQ(map.height(), height);
+            ASSERT_FALSE(map.contains(element.first));
+            fragile::copies_left = 100;
+            map.insert(element);
+        }
+        expected.push_back(key);
+    }
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(keys(map), expected);
+    EXPECT_GE(map.height(), 3);
+}
+
+TEST_F(BTreeFuncTest, bulk_load) {
+    rc::vector<rc::Pair<int, int>> sorted;
+    std::map<int, int> expected;
+    for (int i = 0; i < 100000; ++i) {
+        sorted.push_back({i * 2, i});
+        expected[i * 2] = i;
+    }
+    rc::btree_map<int, int> map;
+    map.bulk_load(sorted.begin(), sorted.end());
+    EXPECT_EQ(map.height(), 3) << "64 keys per node: 1563 leaves under 25 inner nodes under the root";
+    check(map, expected);
+
+    // the loaded tree must stay valid under inserts and erases.
+    for (int i = 0; i < 200000; i += 3) {
+        map.insert({i, -i});
+        expected.insert({i, -i});
+        map.erase(i + 1);
+        expected.erase(i + 1);
+    }
+    check(map, expected);
+}
+
+TEST_F(BTreeFuncTest, set) {
+    rc::btree_set<std::string> set = {"pear", "apple", "fig"};
+    EXPECT_FALSE(set.insert("fig").second);
+    EXPECT_TRUE(set.insert("kiwi").second);
+    std::vector<std::string> keys;
+    for (auto &key: set)
+        keys.push_back(key);
+    EXPECT_EQ(keys, (std::vector<std::string>{"apple", "fig", "kiwi", "pear"}));
+    EXPECT_EQ(*set.lower_bound("b"), "fig");
+    EXPECT_EQ(*set.erase(set.find("fig")), "kiwi");
+    EXPECT_FALSE(set.contains("fig"));
+
+    rc::btree_set<int> numbers;
+    rc::vector<int> sorted;
+    std::set<int> expected;
+    for (int i = 0; i < 5000; ++i) {
+        sorted.push_back(i * 3);
+        expected.insert(i * 3);
+    }
+    numbers.bulk_load(sorted.begin(), sorted.end());
+    EXPECT_EQ(numbers.size(), 5000);
+    auto it = numbers.end();
+    for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit)
+        ASSERT_EQ(*--it, *rit);
+    EXPECT_EQ(numbers.erase(3), 1);
+    EXPECT_EQ(*numbers.upper_bound(0), 6);
+}
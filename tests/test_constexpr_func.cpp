@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "../includes/Array.hpp"
+#include "../includes/Vector.h"
+
+// Everything below is evaluated by the compiler: a failure is a build error, the tests only compare the
+// compile time tables with the same computations run at runtime.
+
+namespace {
+    constexpr rc::array<uint32_t, 256> make_crc32_table() {
+        rc::array<uint32_t, 256> table{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ (crc & 1 ? 0xEDB88320u : 0);
+            table[i] = crc;
+        }
+        return table;
+    }
+
+    // primes below `limit`, sieved with a temporary rc::vector.
+    constexpr rc::vector<int> primes_below(int limit) {
+        rc::vector<bool> composite;
+        composite.resize(limit, false);
+        rc::vector<int> primes;
+        for (int i = 2; i < limit; ++i) {
+            if (composite[i])
+                continue;
+            primes.push_back(i);
+            for (int j = i * i; j < limit; j += i)
+                composite[j] = true;
+        }
+        return primes;
+    }
+
+    // A constant evaluation can't leak memory: the vector is copied into an array before it is destroyed.
+    template<size_t N>
+    constexpr rc::array<int, N> first_primes() {
+        rc::vector<int> primes = primes_below(1000);
+        rc::array<int, N> table{};
+        for (size_t i = 0; i < N; ++i)
+            table[i] = primes[i];
+        return table;
+    }
+
+    constexpr auto crc32_table = make_crc32_table();
+    constexpr auto primes_table = first_primes<168>();
+
+    static_assert(crc32_table[0] == 0);
+    static_assert(crc32_table[1] == 0x77073096u);
+    static_assert(crc32_table[255] == 0x2D02EF8Du);
+    static_assert(primes_table.front() == 2 && primes_table.back() == 997);
+    static_assert(primes_table.size() == 168);
+
+    constexpr bool array_operations() {
+        rc::array<int, 5> a{};
+        a.fill(3);
+        a.at(1) = 1;
+        a[4] = 7;
+        int sum = 0;
+        for (int value: a)
+            sum += value;
+        int reversed[5] = {};
+        int i = 0;
+        for (auto it = a.rbegin(); it != a.rend(); ++it)
+            reversed[i++] = *it;
+        return sum == 17 && reversed[0] == 7 && reversed[3] == 1 && *a.data() == 3 && a.crbegin()[1] == 3;
+    }
+
+    static_assert(array_operations());
+
+    constexpr bool vector_operations() {
+        rc::vector<int> v = {1, 2, 3};
+        v.insert(v.begin() + 1, 2, 9);        // 1 9 9 2 3
+        v.erase(v.begin());                   // 9 9 2 3
+        v.emplace(v.end(), 4);                // 9 9 2 3 4
+        v.pop_back();                         // 9 9 2 3
+        rc::vector<int> copy = v;
+        copy.resize(6, 5);                    // 9 9 2 3 5 5
+        rc::vector<int> moved = std::move(copy);
+        moved.erase(moved.begin(), moved.begin() + 2);
+        int sum = 0;
+        for (auto it = moved.rbegin(); it != moved.rend(); ++it)
+            sum = sum * 10 + *it;
+        return v.size() == 4 && v.at(2) == 2 && sum == 5532 && copy.empty();
+    }
+
+    static_assert(vector_operations());
+    static_assert(primes_below(100).size() == 25);
+}
+
+TEST(ConstexprFuncTest, tables_match_runtime) {
+    uint32_t divisor = 0xEDB88320u;
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (crc & 1 ? divisor : 0);
+        EXPECT_EQ(crc32_table[i], crc);
+    }
+
+    rc::vector<int> primes = primes_below(1000);
+    ASSERT_EQ(primes.size(), primes_table.size());
+    for (size_t i = 0; i < primes.size(); ++i)
+        EXPECT_EQ(primes[i], primes_table[i]);
+}
+
+TEST(ConstexprFuncTest, operations_match_runtime) {
+    // the same functions, run at runtime this time.
+    volatile bool run = true;
+    if (run) {
+        EXPECT_TRUE(array_operations());
+        EXPECT_TRUE(vector_operations());
+    }
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "../includes/EytzingerIndex.h"
+
+
+class EytzingerIndexFuncTest : public ::testing::Test {
+protected:
+    // checks every lookup against std::lower_bound, for keys around each element.
+    template<typename Index>
+    static void check(Index const &index, std::vector<int> const &sorted) {
+        ASSERT_EQ(index.size(), sorted.size());
+        int last = sorted.empty() ? 0 : sorted.back();
+        for (int key = -2; key <= last + 2; ++key) {
+            size_t expected = std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+            ASSERT_EQ(index.lower_bound(key), expected) << "key " << key << ", size " << sorted.size();
+            bool present = expected < sorted.size() && sorted[expected] == key;
+            ASSERT_EQ(index.contains(key), present) << "key " << key;
+            ASSERT_EQ(index.find(key), present ? expected : sorted.size()) << "key " << key;
+        }
+    }
+
+    static std::vector<int> sorted_keys(size_t count, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::vector<int> keys(count);
+        for (auto &key: keys)
+            key = static_cast<int>(gen() % (count * 3 + 1));
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+};
+
+TEST_F(EytzingerIndexFuncTest, classic) {
+    for (size_t count: {0, 1, 2, 3, 7, 8, 15, 16, 17, 100, 1000}) {
+        auto keys = sorted_keys(count, static_cast<unsigned>(count));
+        rc::eytzinger_index<int> index(keys.data(), keys.data() + keys.size());
+        check(index, keys);
+    }
+}
+
+TEST_F(EytzingerIndexFuncTest, blocked) {
+    for (size_t count: {0, 1, 15, 16, 17, 271, 272, 300, 5000}) {
+        auto keys = sorted_keys(count, static_cast<unsigned>(count));
+        rc::blocked_eytzinger_index<int> index(keys.data(), keys.data() + keys.size());
+        check(index, keys);
+    }
+}
+
+TEST_F(EytzingerIndexFuncTest, blocked_padding) {
+    // the padding slots hold the largest int, which isn't a key.
+    const int max = std::numeric_limits<int>::max();
+    std::vector<int> keys = {1, 2, 3};
+    rc::blocked_eytzinger_index<int> index(keys.data(), keys.data() + keys.size());
+    EXPECT_FALSE(index.contains(max));
+    EXPECT_EQ(index.find(max), 3);
+    EXPECT_EQ(index.lower_bound(max), 3);
+
+    keys.push_back(max);
+    rc::blocked_eytzinger_index<int> with_max(keys.data(), keys.data() + keys.size());
+    EXPECT_TRUE(with_max.contains(max));
+    EXPECT_EQ(with_max.find(max), 3);
+}
+
+TEST_F(EytzingerIndexFuncTest, duplicates) {
+    std::vector<int> keys = {1, 2, 2, 2, 2, 3, 5, 5, 8};
+    rc::eytzinger_index<int> classic(keys.data(), keys.data() + keys.size());
+    rc::blocked_eytzinger_index<int> blocked(keys.data(), keys.data() + keys.size());
+    EXPECT_EQ(classic.lower_bound(2), 1) << "lower_bound() should return the first equal key";
+    EXPECT_EQ(blocked.lower_bound(2), 1);
+    EXPECT_EQ(classic.lower_bound(5), 6);
+    EXPECT_EQ(blocked.lower_bound(5), 6);
+}
+
+TEST_F(EytzingerIndexFuncTest, rc_vector_and_strings) {
+    rc::vector<std::string> words = {"apple", "banana", "cherry", "date", "fig"};
+    rc::eytzinger_index<std::string> index(words);
+    EXPECT_EQ(index.find("cherry"), 2);
+    EXPECT_EQ(index.find("coconut"), 5);
+    EXPECT_EQ(index.lower_bound("coconut"), 3);
+
+    rc::eytzinger_index<std::string> moved(std::move(index));
+    EXPECT_EQ(moved.find("fig"), 4);
+    EXPECT_TRUE(index.empty());
+
+    rc::vector<int> descending = {9, 7, 5, 3};
+    rc::eytzinger_index<int, std::greater<int>> reversed(descending);
+    EXPECT_EQ(reversed.lower_bound(6), 2);
+}
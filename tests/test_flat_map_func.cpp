@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <set>
+#include <random>
+#include <stdexcept>
+#include "TestEntity.h"
+#include "../includes/FlatMap.h"
+#include "../includes/FlatSet.h"
+
+// value whose construction throws for a negative value.
+struct checked {
+    int value;
+
+    explicit checked(int value) : value(value) {
+        if (value < 0)
+            throw std::invalid_argument("negative value");
+    }
+};
+
+class FlatMapFuncTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // inserted in reverse order, the map has to keep them sorted.
+        for (int i = last_elem; i >= first_elem; --i) {
+            reference[i * 2] = i;
+            map[i * 2] = i;
+        }
+        ASSERT_EQ(reference.size(), map.size());
+    }
+
+    void expect_same_content() {
+        ASSERT_EQ(reference.size(), map.size());
+        auto ref_it = reference.begin();
+        for (auto it = map.begin(); it != map.end(); ++it, ++ref_it) {
+            EXPECT_EQ((*it).first, ref_it->first);
+            EXPECT_EQ(it->second, ref_it->second);
+        }
+    }
+
+    std::map<int, int> reference;
+    rc::flat_map<int, int> map;
+    const rc::flat_map<int, int> &const_map = map;
+
+    const int first_elem = 0;
+    const int last_elem = 11;
+};
+
+TEST_F(FlatMapFuncTest, sorted) {
+    expect_same_content();
+}
+
+TEST_F(FlatMapFuncTest, find) {
+    for (int i = first_elem; i <= last_elem; ++i) {
+        ASSERT_NE(map.find(i * 2), map.end());
+        EXPECT_EQ(map.find(i * 2)->second, i);
+        EXPECT_EQ(const_map.find(i * 2)->second, i);
+        EXPECT_EQ(map.find(i * 2 + 1), map.end()) << "odd keys were never inserted";
+    }
+    EXPECT_EQ(map.find(-1), map.end());
+    EXPECT_TRUE(map.contains(4));
+    EXPECT_FALSE(map.contains(5));
+    EXPECT_EQ(map.count(4), 1);
+}
+
+TEST_F(FlatMapFuncTest, lower_and_upper_bound) {
+    for (int key = -2; key < last_elem * 2 + 3; ++key) {
+        auto ref_lower = reference.lower_bound(key);
+        auto lower = map.lower_bound(key);
+        if (ref_lower == reference.end())
+            EXPECT_EQ(lower, map.end());
+        else
+            EXPECT_EQ(lower->first, ref_lower->first);
+
+        auto ref_upper = reference.upper_bound(key);
+        auto upper = const_map.upper_bound(key);
+        if (ref_upper == reference.end())
+            EXPECT_EQ(upper, const_map.end());
+        else
+            EXPECT_EQ(upper->first, ref_upper->first);
+    }
+}
+
+TEST_F(FlatMapFuncTest, at) {
+    EXPECT_EQ(map.at(6), 3);
+    EXPECT_EQ(const_map.at(6), 3);
+    ASSERT_THROW(map.at(7), std::out_of_range);
+    ASSERT_THROW(const_map.at(7), std::out_of_range);
+}
+
+TEST_F(FlatMapFuncTest, insert) {
+    auto res = map.insert({7, 42});
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first->first, 7);
+
+    res = map.insert({7, 0});
+    EXPECT_FALSE(res.second) << "insert() shouldn't overwrite an existing key";
+    EXPECT_EQ(res.first->second, 42);
+
+    reference.insert({7, 42});
+    expect_same_content();
+}
+
+TEST_F(FlatMapFuncTest, insert_throws) {
+    rc::flat_map<int, checked> values;
+    values.try_emplace(1, 1);
+    values.try_emplace(5, 5);
+    EXPECT_THROW(values.try_emplace(3, -1), std::invalid_argument);
+    EXPECT_EQ(values.size(), 2) << "a failed insert should leave the map unchanged";
+    EXPECT_FALSE(values.contains(3));
+    EXPECT_EQ(values.at(5).value, 5);
+}
+
+TEST_F(FlatMapFuncTest, erase) {
+    EXPECT_EQ(map.erase(4), 1);
+    EXPECT_EQ(map.erase(5), 0);
+    reference.erase(4);
+    expect_same_content();
+
+    auto it = map.erase(map.begin());
+    reference.erase(reference.begin());
+    EXPECT_EQ(it, map.begin());
+    expect_same_content();
+}
+
+TEST_F(FlatMapFuncTest, bulk_construct) {
+    rc::flat_map<int, int> bulk{{5, 0}, {1, 1}, {3, 2}, {1, 3}, {5, 4}, {0, 5}};
+    ASSERT_EQ(bulk.size(), 4);
+    EXPECT_EQ(bulk.keys()[0], 0);
+    EXPECT_EQ(bulk.keys()[3], 5);
+    EXPECT_EQ(bulk.at(1), 1) << "the first occurrence of a duplicated key should be kept";
+    EXPECT_EQ(bulk.at(5), 0) << "the first occurrence of a duplicated key should be kept";
+}
+
+TEST_F(FlatMapFuncTest, insert_range) {
+    std::vector<rc::Pair<int, int>> batch;
+    std::mt19937 rng(42);
+    for (int i = 0; i < 200; ++i)
+        batch.push_back({static_cast<int>(rng() % 100), i});
+
+    map.insert_range(batch.begin(), batch.end());
+    for (auto &p: batch)
+        reference.insert({p.first, p.second});
+    expect_same_content();
+}
+
+TEST_F(FlatMapFuncTest, entities) {
+    rc::flat_map<int, TestEntity> entities;
+    for (int i = 0; i < 32; ++i)
+        entities.try_emplace(31 - i, i);
+    entities.erase(10);
+    entities[10] = TestEntity(7);
+
+    ASSERT_EQ(entities.size(), 32);
+    EXPECT_EQ(entities.at(10), 7);
+    EXPECT_EQ(entities.at(0), 31);
+}
+
+
+class FlatSetFuncTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = last_elem; i >= first_elem; --i) {
+            reference.insert(i * 2);
+            set.insert(i * 2);
+        }
+        ASSERT_EQ(reference.size(), set.size());
+    }
+
+    void expect_same_content() {
+        ASSERT_EQ(reference.size(), set.size());
+        auto ref_it = reference.begin();
+        for (auto it = set.begin(); it != set.end(); ++it, ++ref_it)
+            EXPECT_EQ(*it, *ref_it);
+    }
+
+    std::set<int> reference;
+    rc::flat_set<int> set;
+
+    const int first_elem = 0;
+    const int last_elem = 11;
+};
+
+TEST_F(FlatSetFuncTest, sorted) {
+    expect_same_content();
+}
+
+TEST_F(FlatSetFuncTest, find) {
+    for (int i = first_elem; i <= last_elem; ++i) {
+        EXPECT_NE(set.find(i * 2), set.end());
+        EXPECT_EQ(set.find(i * 2 + 1), set.end());
+    }
+    EXPECT_EQ(*set.lower_bound(3), 4);
+    EXPECT_EQ(*set.upper_bound(4), 6);
+    EXPECT_EQ(set.upper_bound(last_elem * 2), set.end());
+}
+
+TEST_F(FlatSetFuncTest, insert_and_erase) {
+    EXPECT_TRUE(set.insert(3).second);
+    EXPECT_FALSE(set.insert(3).second);
+    EXPECT_EQ(set.erase(4), 1);
+    EXPECT_EQ(set.erase(4), 0);
+    reference.insert(3);
+    reference.erase(4);
+    expect_same_content();
+}
+
+TEST_F(FlatSetFuncTest, insert_range) {
+    std::vector<int> batch;
+    std::mt19937 rng(7);
+    for (int i = 0; i < 300; ++i)
+        batch.push_back(static_cast<int>(rng() % 150));
+
+    set.insert_range(batch.begin(), batch.end());
+    reference.insert(batch.begin(), batch.end());
+    expect_same_content();
+
+    rc::flat_set<int> bulk(batch.begin(), batch.end());
+    EXPECT_EQ(bulk.size(), std::set<int>(batch.begin(), batch.end()).size());
+}
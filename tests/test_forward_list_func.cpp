@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <forward_list>
+#include <random>
+#include <vector>
+#include "TestEntity.h"
+#include "../includes/ForwardList.h"
+
+
+class ForwardListFuncTest : public ::testing::Test {
+protected:
+    template<typename LIST>
+    static std::vector<int> content(const LIST &list) {
+        std::vector<int> out;
+        for (int value: list)
+            out.push_back(value);
+        return out;
+    }
+
+    // std::next() only knows the std iterator tags.
+    template<typename IT>
+    static IT advance(IT it, int n = 1) {
+        while (n-- > 0)
+            ++it;
+        return it;
+    }
+};
+
+TEST_F(ForwardListFuncTest, push_insert_erase) {
+    rc::forward_list<int> list;
+    ASSERT_TRUE(list.empty());
+    list.push_front(3);
+    list.emplace_front(1);
+    EXPECT_EQ(list.front(), 1);
+
+    auto it = list.insert_after(list.begin(), 2);
+    EXPECT_EQ(*it, 2);
+    it = list.insert_after(list.before_begin(), 2, 0);
+    EXPECT_EQ(content(list), std::vector<int>({0, 0, 1, 2, 3}));
+
+    std::vector<int> tail = {4, 5, 6};
+    auto last = list.begin();
+    while (advance(last) != list.end())
+        ++last;
+    last = list.insert_after(last, tail.begin(), tail.end());
+    EXPECT_EQ(*last, 6) << "insert_after should return the last inserted element";
+
+    list.pop_front();
+    list.erase_after(list.begin());
+    EXPECT_EQ(content(list), std::vector<int>({0, 2, 3, 4, 5, 6}));
+    auto next = list.erase_after(list.begin(), advance(list.begin(), 4));
+    EXPECT_EQ(*next, 5);
+    EXPECT_EQ(content(list), std::vector<int>({0, 5, 6}));
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+}
+
+TEST_F(ForwardListFuncTest, copy_move) {
+    rc::forward_list<int> list{1, 2, 3};
+    rc::forward_list<int> copy(list);
+    EXPECT_EQ(content(copy), content(list));
+
+    rc::forward_list<int> shorter{9};
+    rc::forward_list<int> longer{9, 9, 9, 9, 9};
+    shorter = list;
+    longer = list;
+    EXPECT_EQ(content(shorter), std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(content(longer), std::vector<int>({1, 2, 3}));
+
+    rc::forward_list<int> moved(std::move(list));
+    EXPECT_TRUE(list.empty());
+    copy = std::move(moved);
+    EXPECT_EQ(content(copy), std::vector<int>({1, 2, 3}));
+}
+
+TEST_F(ForwardListFuncTest, splice_after) {
+    rc::forward_list<int> a{1, 2, 3};
+    rc::forward_list<int> b{10, 11, 12, 13};
+
+    a.splice_after(a.begin(), b, b.begin());
+    EXPECT_EQ(content(a), std::vector<int>({1, 11, 2, 3}));
+    EXPECT_EQ(content(b), std::vector<int>({10, 12, 13}));
+
+    a.splice_after(a.before_begin(), b, b.before_begin(), advance(b.begin(), 2));
+    EXPECT_EQ(content(a), std::vector<int>({10, 12, 1, 11, 2, 3}));
+    EXPECT_EQ(content(b), std::vector<int>({13}));
+
+    a.splice_after(a.before_begin(), b);
+    EXPECT_EQ(content(a), std::vector<int>({13, 10, 12, 1, 11, 2, 3}));
+    EXPECT_TRUE(b.empty());
+}
+
+TEST_F(ForwardListFuncTest, sort_merge_reverse) {
+    std::mt19937 gen(5);
+    std::vector<std::pair<int, int>> values;
+    for (int i = 0; i < 1000; ++i)
+        values.emplace_back(static_cast<int>(gen() % 40), i);
+
+    rc::forward_list<std::pair<int, int>> sorted;
+    sorted.insert_after(sorted.before_begin(), values.begin(), values.end());
+    auto by_key = [](const auto &l, const auto &r) { return l.first < r.first; };
+    sorted.sort(by_key);
+    std::stable_sort(values.begin(), values.end(), by_key);
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), sorted.begin())) << "sort should be stable";
+
+    rc::forward_list<int> a{1, 4, 9};
+    rc::forward_list<int> b{2, 4, 10};
+    a.merge(b);
+    EXPECT_EQ(content(a), std::vector<int>({1, 2, 4, 4, 9, 10}));
+    EXPECT_TRUE(b.empty());
+
+    a.reverse();
+    EXPECT_EQ(content(a), std::vector<int>({10, 9, 4, 4, 2, 1}));
+}
+
+TEST_F(ForwardListFuncTest, entities) {
+    std::forward_list<TestEntity> reference;
+    rc::forward_list<TestEntity> list;
+    TestEntity entity;
+    TestEntity::clearCallHistory();
+
+    reference.push_front(entity);
+    reference.push_front(TestEntity(1));
+    reference.emplace_front(2);
+    reference.emplace_after(reference.begin(), 3);
+    reference.pop_front();
+    reference.clear();
+    auto reference_calls = TestEntity::getCallHistoryAndClean();
+
+    list.push_front(entity);
+    list.push_front(TestEntity(1));
+    list.emplace_front(2);
+    list.emplace_after(list.begin(), 3);
+    list.pop_front();
+    list.clear();
+    auto calls = TestEntity::getCallHistoryAndClean();
+
+    EXPECT_EQ(reference_calls, calls);
+}
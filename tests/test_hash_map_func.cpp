@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <unordered_map>
+#include <random>
+#include <string>
+#include "TestEntity.h"
+#include "../includes/HashMap.h"
+
+
+class HashMapFuncTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = first_elem; i < last_elem + 1; i++) {
+            reference[i] = i * 10;
+            map[i] = i * 10;
+        }
+        ASSERT_EQ(reference.size(), map.size());
+    }
+
+    template<typename MAP>
+    void expect_same_content(const MAP &m) {
+        ASSERT_EQ(reference.size(), m.size());
+        size_t visited = 0;
+        for (auto &el: m) {
+            auto ref = reference.find(el.first);
+            ASSERT_NE(ref, reference.end()) << el.first << " shouldn't be in the map";
+            EXPECT_EQ(ref->second, el.second);
+            ++visited;
+        }
+        EXPECT_EQ(visited, reference.size());
+        for (auto &el: reference) {
+            ASSERT_TRUE(m.contains(el.first)) << el.first << " should be in the map";
+            EXPECT_EQ(m.at(el.first), el.second);
+        }
+    }
+
+    std::unordered_map<int, int> reference;
+    rc::hash_map<int, int> map;
+    const rc::hash_map<int, int> &const_map = map;
+
+    const int first_elem = 0;
+    const int last_elem = 11;
+};
+
+// every key lands in the same home slot, so all of them share a single probe run.
+struct CollidingHash {
+    size_t operator()(int) const { return 0; }
+};
+
+TEST_F(HashMapFuncTest, find) {
+    expect_same_content(map);
+    EXPECT_EQ(map.find(last_elem + 1), map.end());
+    EXPECT_EQ(const_map.find(-1), const_map.end());
+    EXPECT_EQ(map.find(3)->second, 30);
+    EXPECT_EQ(map.count(3), 1);
+    ASSERT_THROW(map.at(last_elem + 1), std::out_of_range);
+}
+
+TEST_F(HashMapFuncTest, insert) {
+    auto res = map.insert({42, 1});
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first->first, 42);
+
+    res = map.insert({42, 2});
+    EXPECT_FALSE(res.second) << "insert() shouldn't overwrite an existing key";
+    EXPECT_EQ(res.first->second, 1);
+
+    reference.insert({42, 1});
+    expect_same_content(map);
+}
+
+TEST_F(HashMapFuncTest, erase) {
+    EXPECT_EQ(map.erase(3), 1);
+    EXPECT_EQ(map.erase(3), 0);
+    reference.erase(3);
+    expect_same_content(map);
+
+    map.erase(map.find(4));
+    reference.erase(4);
+    expect_same_content(map);
+}
+
+TEST_F(HashMapFuncTest, random_operations) {
+    std::mt19937 rng(42);
+    for (int i = 0; i < 100000; ++i) {
+        int key = static_cast<int>(rng() % 2048);
+        switch (rng() % 3) {
+            case 0:
+                EXPECT_EQ(map.insert({key, i}).second, reference.insert({key, i}).second);
+                break;
+            case 1:
+                EXPECT_EQ(map.erase(key), reference.erase(key));
+                break;
+            default:
+                EXPECT_EQ(map.contains(key), reference.count(key) == 1);
+        }
+    }
+    expect_same_content(map);
+}
+
+TEST_F(HashMapFuncTest, colliding_keys) {
+    rc::hash_map<int, int, CollidingHash> colliding;
+    std::mt19937 rng(7);
+    reference.clear();
+    for (int i = 0; i < 5000; ++i) {
+        int key = static_cast<int>(rng() % 64);
+        if (rng() % 2) {
+            colliding[key] = i;
+            reference[key] = i;
+        } else {
+            EXPECT_EQ(colliding.erase(key), reference.erase(key));
+        }
+    }
+    expect_same_content(colliding);
+}
+
+TEST_F(HashMapFuncTest, reserve) {
+    map.reserve(1000);
+    size_t buckets = map.bucket_count();
+    for (int i = last_elem + 1; i < 1000; ++i)
+        map[i] = i;
+    EXPECT_EQ(map.bucket_count(), buckets) << "reserve() should avoid any rehash";
+    EXPECT_LE(map.load_factor(), 0.75f);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST_F(HashMapFuncTest, copy_and_move) {
+    rc::hash_map<int, int> cpy(map);
+    expect_same_content(cpy);
+
+    rc::hash_map<int, int> assigned;
+    assigned = cpy;
+    expect_same_content(assigned);
+
+    rc::hash_map<int, int> moved(std::move(cpy));
+    expect_same_content(moved);
+    EXPECT_TRUE(cpy.empty());
+}
+
+TEST_F(HashMapFuncTest, entities) {
+    TestEntity::clearCallHistory();
+    {
+        rc::hash_map<std::string, TestEntity> entities;
+        for (int i = 0; i < 200; ++i)
+            entities.try_emplace(std::to_string(i), i);
+        for (int i = 0; i < 200; i += 2)
+            entities.erase(std::to_string(i));
+
+        ASSERT_EQ(entities.size(), 100);
+        EXPECT_EQ(entities.at("7"), 7);
+    }
+    auto calls = TestEntity::getCallHistoryAndClean();
+    auto constructed = std::count(calls.begin(), calls.end(), CTORVAL);
+    auto destroyed = std::count(calls.begin(), calls.end(), DTOR);
+    EXPECT_EQ(constructed, destroyed) << "every stored entity should be destroyed exactly once";
+}
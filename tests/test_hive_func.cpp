@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../includes/Hive.h"
+#include "TestEntity.h"
+
+// element whose construction throws for a negative value.
+struct checked {
+    int value;
+
+    explicit checked(int value) : value(value) {
+        if (value < 0)
+            throw std::invalid_argument("negative value");
+    }
+};
+
+class HiveFuncTest : public ::testing::Test {
+protected:
+    // elements in iteration order, checked against a backward walk.
+    template<typename T>
+    static std::vector<T> content(rc::hive<T> const &hive) {
+        std::vector<T> forward;
+        for (auto &value: hive)
+            forward.push_back(value);
+        EXPECT_EQ(forward.size(), hive.size());
+        std::vector<T> backward;
+        for (auto it = hive.end(); it != hive.begin();)
+            backward.push_back(*--it);
+        std::reverse(backward.begin(), backward.end());
+        EXPECT_EQ(forward, backward);
+        return forward;
+    }
+};
+
+TEST_F(HiveFuncTest, insert_and_iterate) {
+    rc::hive<int> hive;
+    EXPECT_TRUE(hive.begin() == hive.end());
+    for (int i = 0; i < 100; ++i)
+        hive.insert(i);
+    EXPECT_EQ(hive.size(), 100);
+    // blocks of 8, 16, 32 and 64 slots.
+    EXPECT_EQ(hive.capacity(), 120);
+    std::vector<int> expected(100);
+    for (int i = 0; i < 100; ++i)
+        expected[i] = i;
+    EXPECT_EQ(content(hive), expected);
+}
+
+TEST_F(HiveFuncTest, stable_addresses) {
+    rc::hive<std::string> hive;
+    std::vector<std::string *> pointers;
+    for (int i = 0; i < 1000; ++i)
+        pointers.push_back(&*hive.emplace(std::to_string(i)));
+    for (int i = 0; i < 1000; ++i)
+        ASSERT_EQ(*pointers[i], std::to_string(i));
+    EXPECT_TRUE(hive.get_iterator(pointers[500]) != hive.end());
+    EXPECT_EQ(*hive.get_iterator(pointers[500]), "500");
+}
+
+TEST_F(HiveFuncTest, erase_runs) {
+    rc::hive<int> hive;
+    std::vector<rc::hive<int>::iterator> its;
+    for (int i = 0; i < 8; ++i)
+        its.push_back(hive.insert(i));
+    hive.insert(8);
+
+    // a run grown to the right, to the left, then merged with another one.
+    EXPECT_EQ(*hive.erase(its[3]), 4);
+    EXPECT_EQ(*hive.erase(its[2]), 4);
+    EXPECT_EQ(*hive.erase(its[4]), 5);
+    EXPECT_EQ(*hive.erase(its[6]), 7);
+    EXPECT_EQ(*hive.erase(its[5]), 7);
+    EXPECT_EQ(content(hive), (std::vector<int>{0, 1, 7, 8}));
+    // runs at both ends of a block.
+    EXPECT_EQ(*hive.erase(its[0]), 1);
+    EXPECT_EQ(*hive.erase(its[7]), 8);
+    EXPECT_EQ(content(hive), (std::vector<int>{1, 8}));
+
+    // the erased slots are reused before a new one is used.
+    size_t capacity = hive.capacity();
+    int *first = &*hive.insert(10);
+    EXPECT_TRUE(first == &*its[0] || first == &*its[2] || first == &*its[7]);
+    for (int i = 11; i < 17; ++i)
+        hive.insert(i);
+    EXPECT_EQ(hive.capacity(), capacity);
+    EXPECT_EQ(hive.size(), 9);
+    std::vector<int> values = content(hive);
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, (std::vector<int>{1, 8, 10, 11, 12, 13, 14, 15, 16}));
+}
+
+TEST_F(HiveFuncTest, empty_block_reserve) {
+    rc::hive<int> hive;
+    for (int i = 0; i < 24; ++i)
+        hive.insert(i);
+    // empties the first block: the iteration starts at the second one, and the block is kept in reserve.
+    auto it = hive.begin();
+    for (int i = 0; i < 8; ++i)
+        it = hive.erase(it);
+    EXPECT_EQ(*it, 8);
+    EXPECT_EQ(hive.capacity(), 24);
+    // empties the last block: end() moves back, and the larger block replaces the reserve.
+    for (int i = 0; i < 16; ++i)
+        it = hive.erase(it);
+    EXPECT_TRUE(it == hive.end());
+    EXPECT_TRUE(hive.empty());
+    EXPECT_EQ(hive.capacity(), 16);
+    hive.insert(1);
+    EXPECT_EQ(content(hive), std::vector<int>{1});
+    EXPECT_EQ(hive.capacity(), 16) << "the reserve should be the new block";
+
+    // inserting and erasing around a block boundary reuses the reserve.
+    for (int i = 2; i <= 16; ++i)
+        hive.insert(i);
+    size_t capacity = hive.capacity();
+    for (int i = 0; i < 100; ++i)
+        hive.erase(hive.insert(0));
+    EXPECT_EQ(hive.capacity(), capacity + 32);
+    EXPECT_EQ(hive.size(), 16);
+    hive.clear();
+    EXPECT_EQ(hive.capacity(), 0);
+}
+
+TEST_F(HiveFuncTest, emplace_throws) {
+    rc::hive<checked> hive;
+    EXPECT_THROW(hive.emplace(-1), std::invalid_argument);
+    EXPECT_TRUE(hive.begin() == hive.end());
+    EXPECT_EQ(hive.capacity(), 0) << "the new block should be released";
+    for (int i = 0; i < 8; ++i)
+        hive.emplace(i);
+    EXPECT_THROW(hive.emplace(-1), std::invalid_argument);
+    EXPECT_EQ(hive.size(), 8);
+    EXPECT_EQ(hive.capacity(), 8);
+    int expected = 0;
+    for (auto &element: hive)
+        ASSERT_EQ(element.value, expected++);
+    EXPECT_EQ(expected, 8);
+    hive.emplace(8);
+    EXPECT_EQ(hive.capacity(), 24);
+}
+
+TEST_F(HiveFuncTest, random_churn) {
+    rc::hive<int> hive;
+    std::vector<int *> live;
+    std::vector<int> expected;
+    std::mt19937 gen(3);
+    for (int i = 0; i < 100000; ++i) {
+        if (live.empty() || gen() % 5 < 3) {
+            live.push_back(&*hive.insert(i));
+        } else {
+            size_t k = gen() % live.size();
+            hive.erase(hive.get_iterator(live[k]));
+            live[k] = live.back();
+            live.pop_back();
+        }
+        if (i % 10000 == 0) {
+            expected.clear();
+            for (int *p: live)
+                expected.push_back(*p);
+            std::sort(expected.begin(), expected.end());
+            std::vector<int> values = content(hive);
+            std::sort(values.begin(), values.end());
+            ASSERT_EQ(values, expected);
+        }
+    }
+    // every erased slot is reused before a block is added: at most the last block is partly unused.
+    EXPECT_LE(hive.capacity(), 2 * hive.size() + rc::hive<int>::max_block_capacity);
+}
+
+TEST_F(HiveFuncTest, copy_move_and_destroy) {
+    TestEntity::clearCallHistory();
+    {
+        rc::hive<TestEntity> hive;
+        for (int i = 0; i < 50; ++i)
+            hive.emplace(i);
+        auto it = hive.begin();
+        while (it != hive.end())
+            it = *it->ptr % 2 ? hive.erase(it) : ++it;
+        EXPECT_EQ(hive.size(), 25);
+
+        rc::hive<TestEntity> copy = hive;
+        rc::hive<TestEntity> moved = std::move(hive);
+        EXPECT_TRUE(hive.empty());
+        EXPECT_EQ(copy.size(), 25);
+        EXPECT_EQ(moved.size(), 25);
+        copy = moved;
+        copy.clear();
+        EXPECT_TRUE(copy.begin() == copy.end());
+    }
+    // every constructed element was destroyed.
+    auto calls = TestEntity::getCallHistory();
+    auto count = [&](TestEntityCall call) { return std::count(calls.begin(), calls.end(), call); };
+    EXPECT_EQ(count(CTORVAL) + count(CPYCTOR) + count(MOVCTOR), count(DTOR) + count(U_DTOR));
+}
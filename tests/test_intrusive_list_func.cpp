@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../includes/IntrusiveList.h"
+
+
+struct Job {
+    int id;
+    rc::list_hook hook;
+    rc::safe_list_hook safe_hook;
+
+    explicit Job(int id) : id(id) {}
+};
+
+class IntrusiveListFuncTest : public ::testing::Test {
+protected:
+    using job_list = rc::intrusive_list<Job, &Job::hook>;
+
+    std::vector<Job> jobs;
+
+    void SetUp() override {
+        jobs.reserve(8);
+        for (int i = 0; i < 8; ++i)
+            jobs.emplace_back(i);
+    }
+
+    template<typename LIST>
+    std::vector<int> ids(const LIST &list) {
+        std::vector<int> out;
+        for (const Job &job: list)
+            out.push_back(job.id);
+        return out;
+    }
+};
+
+TEST_F(IntrusiveListFuncTest, push_pop) {
+    job_list list;
+    ASSERT_TRUE(list.empty());
+    list.push_back(jobs[1]);
+    list.push_back(jobs[2]);
+    list.push_front(jobs[0]);
+
+    EXPECT_EQ(ids(list), std::vector<int>({0, 1, 2}));
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(&list.front(), &jobs[0]) << "the list should link the objects themselves";
+    EXPECT_EQ(&list.back(), &jobs[2]);
+
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(ids(list), std::vector<int>({1}));
+    EXPECT_FALSE(jobs[0].hook.is_linked());
+}
+
+TEST_F(IntrusiveListFuncTest, unlink_from_element) {
+    job_list list;
+    for (auto &job: jobs)
+        list.push_back(job);
+
+    jobs[3].hook.unlink();
+    jobs[0].hook.unlink();
+    jobs[7].hook.unlink();
+    EXPECT_EQ(ids(list), std::vector<int>({1, 2, 4, 5, 6}));
+
+    auto it = list.erase(job_list::iterator_to(jobs[4]));
+    EXPECT_EQ(it->id, 5);
+    list.insert(it, jobs[3]);
+    EXPECT_EQ(ids(list), std::vector<int>({1, 2, 3, 5, 6}));
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_FALSE(jobs[1].hook.is_linked());
+}
+
+TEST_F(IntrusiveListFuncTest, splice) {
+    job_list a, b;
+    for (int i = 0; i < 4; ++i)
+        a.push_back(jobs[i]);
+    for (int i = 4; i < 8; ++i)
+        b.push_back(jobs[i]);
+
+    // single element
+    a.splice(a.begin(), b, job_list::iterator_to(jobs[6]));
+    EXPECT_EQ(ids(a), std::vector<int>({6, 0, 1, 2, 3}));
+    EXPECT_EQ(ids(b), std::vector<int>({4, 5, 7}));
+
+    // range
+    a.splice(a.end(), b, b.begin(), job_list::iterator_to(jobs[7]));
+    EXPECT_EQ(ids(a), std::vector<int>({6, 0, 1, 2, 3, 4, 5}));
+
+    // range within the same list
+    a.splice(a.begin(), a, job_list::iterator_to(jobs[2]), a.end());
+    EXPECT_EQ(ids(a), std::vector<int>({2, 3, 4, 5, 6, 0, 1}));
+
+    // whole list
+    b.splice(b.begin(), a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(ids(b), std::vector<int>({2, 3, 4, 5, 6, 0, 1, 7}));
+
+    job_list moved(std::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(moved.size(), 8);
+}
+
+TEST_F(IntrusiveListFuncTest, several_hooks) {
+    job_list all;
+    rc::intrusive_list<Job, &Job::safe_hook> even;
+    for (auto &job: jobs) {
+        all.push_back(job);
+        if (job.id % 2 == 0)
+            even.push_back(job);
+    }
+    EXPECT_EQ(all.size(), 8);
+    EXPECT_EQ(ids(even), std::vector<int>({0, 2, 4, 6}));
+    even.clear();
+}
+
+#ifndef NDEBUG
+TEST_F(IntrusiveListFuncTest, safe_hook_double_insertion) {
+    rc::intrusive_list<Job, &Job::safe_hook> list;
+    list.push_back(jobs[0]);
+    EXPECT_DEATH(list.push_back(jobs[0]), "already in an intrusive_list");
+    list.clear();
+}
+#endif
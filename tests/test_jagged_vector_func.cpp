@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../includes/JaggedVector.h"
+
+
+class JaggedVectorFuncTest : public ::testing::Test {
+protected:
+    rc::jagged_vector<int> jagged;
+
+    template<typename Row>
+    static std::vector<int> content(Row row) {
+        return std::vector<int>(row.begin(), row.end());
+    }
+};
+
+TEST_F(JaggedVectorFuncTest, push_row) {
+    EXPECT_TRUE(jagged.empty());
+    jagged.push_row({1, 2, 3});
+    jagged.push_row({});
+    rc::vector<int> range = {4, 5};
+    jagged.push_row(range);
+    std::vector<int> std_range = {6};
+    jagged.push_row(std_range.begin(), std_range.end());
+
+    ASSERT_EQ(jagged.rows(), 4);
+    EXPECT_EQ(jagged.size(), 6);
+    EXPECT_EQ(content(jagged.row(0)), (std::vector<int>{1, 2, 3}));
+    EXPECT_TRUE(jagged[1].empty());
+    EXPECT_EQ(content(jagged.row(2)), (std::vector<int>{4, 5}));
+    EXPECT_EQ(jagged.row_size(3), 1);
+    EXPECT_EQ(content(jagged.values()), (std::vector<int>{1, 2, 3, 4, 5, 6})) << "rows should be contiguous";
+    EXPECT_EQ(content(jagged.offsets()), (std::vector<int>{0, 3, 3, 5, 6}));
+
+    jagged.row(2)[1] = 50;
+    jagged.push_back(7);
+    EXPECT_EQ(content(jagged.row(3)), (std::vector<int>{6, 7}));
+    EXPECT_EQ(jagged.row(2)[1], 50);
+}
+
+TEST_F(JaggedVectorFuncTest, pop_clear) {
+    jagged = {{1}, {2, 3}, {4, 5, 6}};
+    jagged.pop_row();
+    EXPECT_EQ(jagged.rows(), 2);
+    EXPECT_EQ(jagged.size(), 3);
+    jagged.pop_row();
+    jagged.pop_row();
+    EXPECT_TRUE(jagged.empty());
+    EXPECT_EQ(jagged.size(), 0);
+
+    jagged.push_row({8});
+    EXPECT_EQ(content(jagged.row(0)), (std::vector<int>{8}));
+    jagged.clear();
+    EXPECT_EQ(jagged.rows(), 0);
+}
+
+TEST_F(JaggedVectorFuncTest, builder) {
+    // edges of a small directed graph, in no particular order.
+    std::vector<std::pair<size_t, int>> edges = {{2, 0}, {0, 1}, {2, 1}, {0, 2}, {3, 3}, {0, 3}};
+    rc::jagged_vector<int>::builder builder(5);
+    for (auto &edge: edges)
+        builder.count(edge.first);
+    builder.allocate();
+    for (auto &edge: edges)
+        builder.fill(edge.first, edge.second);
+    jagged = std::move(builder).build();
+
+    ASSERT_EQ(jagged.rows(), 5);
+    EXPECT_EQ(content(jagged.row(0)), (std::vector<int>{1, 2, 3}));
+    EXPECT_TRUE(jagged.row(1).empty());
+    EXPECT_EQ(content(jagged.row(2)), (std::vector<int>{0, 1}));
+    EXPECT_EQ(content(jagged.row(3)), (std::vector<int>{3}));
+    EXPECT_TRUE(jagged.row(4).empty());
+}
+
+TEST_F(JaggedVectorFuncTest, parallel_builder) {
+    const size_t rows = 300000;
+    rc::jagged_vector<std::string>::builder builder(rows);
+    for (size_t i = 0; i < rows; ++i)
+        builder.count(i, i % 4);
+    builder.allocate(4);
+
+    // each thread fills its own rows.
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 3; ++t) {
+        threads.emplace_back([&builder, t] {
+            for (size_t i = t; i < rows; i += 3)
+                for (size_t k = 0; k < i % 4; ++k)
+                    builder.fill(i, std::to_string(i));
+        });
+    }
+    for (auto &thread: threads)
+        thread.join();
+    auto result = std::move(builder).build();
+
+    ASSERT_EQ(result.rows(), rows);
+    size_t expected_offset = 0;
+    bool ok = true;
+    for (size_t i = 0; i < rows; ++i) {
+        ok &= result.offsets()[i] == expected_offset;
+        ok &= result.row_size(i) == i % 4;
+        for (auto &value: result.row(i))
+            ok &= value == std::to_string(i);
+        expected_offset += i % 4;
+    }
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(result.size(), expected_offset);
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <list>
+#include "TestEntity.h"
+#include "../includes/List.h"
+
+
+class ListCopTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = first_elem; i < last_elem + 1; i++) {
+            reference.emplace_back(i);
+            list.emplace_back(i);
+        }
+        TestEntity::clearCallHistory();
+        ASSERT_EQ(reference.size(), list.size());
+    }
+
+    std::list<TestEntity> reference;
+    rc::list<TestEntity> list;
+    std::vector<TestEntityCall> reference_calls;
+    std::vector<TestEntityCall> calls;
+    TestEntity entity;
+
+    const int first_elem = 0;
+    const int last_elem = 11;
+};
+
+TEST_F(ListCopTest, construct) {
+    {
+        std::list<TestEntity> ref_empty;
+    }
+    reference_calls = TestEntity::getCallHistoryAndClean();
+    {
+        rc::list<TestEntity> empty;
+    }
+    calls = TestEntity::getCallHistoryAndClean();
+    ASSERT_EQ(reference_calls, calls) << "the sentinel node should not construct an element";
+
+    std::list<TestEntity> ref_init{1, 2, 3};
+    reference_calls = TestEntity::getCallHistoryAndClean();
+    rc::list<TestEntity> init{1, 2, 3};
+    calls = TestEntity::getCallHistoryAndClean();
+    ASSERT_EQ(reference_calls, calls);
+
+    displayCalls(reference_calls);
+}
+
+TEST_F(ListCopTest, push) {
+    reference.push_back(entity);
+    reference.push_back(TestEntity(1));
+    reference.push_front(entity);
+    reference.push_front(TestEntity(2));
+    reference_calls = TestEntity::getCallHistoryAndClean();
+
+    list.push_back(entity);
+    list.push_back(TestEntity(1));
+    list.push_front(entity);
+    list.push_front(TestEntity(2));
+    calls = TestEntity::getCallHistoryAndClean();
+
+    ASSERT_EQ(reference_calls, calls);
+    displayCalls(reference_calls);
+}
+
+TEST_F(ListCopTest, emplace) {
+    reference.emplace_back(1);
+    reference.emplace_front(2);
+    reference.emplace(std::next(reference.begin(), 3), 3);
+    reference.emplace_back(std::move(entity));
+    reference_calls = TestEntity::getCallHistoryAndClean();
+
+    TestEntity other_entity;
+    TestEntity::clearCallHistory();
+    list.emplace_back(1);
+    list.emplace_front(2);
+    auto pos = list.begin();
+    ++pos;
+    ++pos;
+    ++pos;
+    EXPECT_EQ(*list.emplace(pos, 3).operator->()->ptr, 3);
+    list.emplace_back(std::move(other_entity));
+    calls = TestEntity::getCallHistoryAndClean();
+
+    ASSERT_EQ(reference_calls, calls) << "elements should be constructed in place";
+    EXPECT_EQ(*list.front().ptr, 2);
+    EXPECT_EQ(*list.back().ptr, 42);
+    displayCalls(reference_calls);
+}
+
+TEST_F(ListCopTest, insert) {
+    reference.insert(reference.begin(), TestEntity(7));
+    reference.insert(reference.end(), entity);
+    reference.insert(reference.end(), 2, entity);
+    reference_calls = TestEntity::getCallHistoryAndClean();
+
+    list.insert(list.begin(), TestEntity(7));
+    list.insert(list.end(), entity);
+    auto first = list.insert(list.end(), 2, entity);
+    calls = TestEntity::getCallHistoryAndClean();
+
+    ASSERT_EQ(reference_calls, calls);
+    EXPECT_EQ(list.size(), reference.size());
+    EXPECT_EQ(*first, entity) << "insert should return the first inserted element";
+    displayCalls(reference_calls);
+}
+
+TEST_F(ListCopTest, erase_pop) {
+    reference.pop_back();
+    reference.pop_front();
+    reference.erase(std::next(reference.begin()), std::prev(reference.end()));
+    reference.clear();
+    reference_calls = TestEntity::getCallHistoryAndClean();
+
+    list.pop_back();
+    list.pop_front();
+    auto first = list.begin();
+    ++first;
+    auto last = list.end();
+    --last;
+    list.erase(first, last);
+    list.clear();
+    calls = TestEntity::getCallHistoryAndClean();
+
+    ASSERT_EQ(reference_calls, calls);
+    displayCalls(reference_calls);
+}
+
+TEST_F(ListCopTest, copy) {
+    std::list<TestEntity> ref_cpy(reference);
+    reference_calls = TestEntity::getCallHistoryAndClean();
+
+    rc::list<TestEntity> cpy(list);
+    calls = TestEntity::getCallHistoryAndClean();
+
+    ASSERT_EQ(reference_calls, calls);
+    displayCalls(reference_calls);
+}
+
+TEST_F(ListCopTest, assign) {
+    std::list<TestEntity> ref_cpy{1, 2};
+    rc::list<TestEntity> cpy{1, 2};
+    std::list<TestEntity> ref_long{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+    rc::list<TestEntity> long_cpy{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+    TestEntity::clearCallHistory();
+
+    ref_cpy = reference;
+    ref_long = reference;
+    reference_calls = TestEntity::getCallHistoryAndClean();
+
+    cpy = list;
+    long_cpy = list;
+    calls = TestEntity::getCallHistoryAndClean();
+
+    ASSERT_EQ(reference_calls, calls) << "existing elements should be assigned";
+    ASSERT_EQ(cpy.size(), list.size());
+    ASSERT_EQ(long_cpy.size(), list.size());
+    displayCalls(reference_calls);
+}
+
+TEST_F(ListCopTest, move) {
+    std::list<TestEntity> ref_cpy{42, 42, 42};
+    rc::list<TestEntity> cpy{42, 42, 42};
+    TestEntity::clearCallHistory();
+
+    std::list<TestEntity> ref_moved(std::move(reference));
+    ref_cpy = std::move(ref_moved);
+    reference_calls = TestEntity::getCallHistoryAndClean();
+
+    rc::list<TestEntity> moved(std::move(list));
+    cpy = std::move(moved);
+    calls = TestEntity::getCallHistoryAndClean();
+
+    ASSERT_EQ(reference_calls, calls);
+    ASSERT_EQ(cpy.size(), last_elem + 1);
+    ASSERT_TRUE(list.empty());
+    ASSERT_TRUE(moved.empty());
+    list.push_back(entity);
+    ASSERT_EQ(list.size(), 1) << "a moved-from list should stay usable";
+    displayCalls(reference_calls);
+}
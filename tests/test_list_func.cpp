@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include "TestEntity.h"
+#include "../includes/List.h"
+
+// element whose move throws once `moves_left` moves were made.
+struct fragile_move {
+    static inline int moves_left = 0;
+    int value;
+
+    fragile_move(int value) : value(value) {}
+
+    fragile_move(fragile_move &&other) : value(other.value) {
+        if (moves_left-- == 0)
+            throw std::runtime_error("move failed");
+    }
+};
+
+struct alignas(64) wide {
+    int value;
+};
+
+class ListFuncTest : public ::testing::Test {
+protected:
+    template<typename T>
+    static rc::list<T> make(const std::vector<T> &values) {
+        rc::list<T> list;
+        for (const auto &value: values)
+            list.push_back(value);
+        return list;
+    }
+
+    template<typename T>
+    static std::vector<T> content(rc::list<T> &list) {
+        std::vector<T> out;
+        for (auto it = list.begin(); it != list.end(); ++it)
+            out.push_back(*it);
+        // walk backward too, to check the prev links
+        std::vector<T> backward;
+        if (!list.empty()) {
+            auto it = list.end();
+            do {
+                --it;
+                backward.push_back(*it);
+            } while (it != list.begin());
+        }
+        std::reverse(backward.begin(), backward.end());
+        EXPECT_EQ(out, backward) << "next and prev links disagree";
+        EXPECT_EQ(out.size(), list.size());
+        return out;
+    }
+};
+
+TEST_F(ListFuncTest, pop_to_empty) {
+    auto list = make<int>({1, 2});
+    list.pop_back();
+    list.pop_back();
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.begin() == list.end());
+    list.push_back(3);
+    list.push_front(2);
+    EXPECT_EQ(content(list), (std::vector<int>{2, 3}));
+    list.pop_front();
+    list.pop_front();
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST_F(ListFuncTest, insert_input_range) {
+    // a single pass range: it can only be read once.
+    std::istringstream stream("2 3 4");
+    auto list = make<int>({1, 5});
+    auto pos = list.begin();
+    ++pos;
+    auto it = list.insert(pos, std::istream_iterator<int>(stream), std::istream_iterator<int>());
+    EXPECT_EQ(*it, 2) << "insert() should return the first inserted element";
+    EXPECT_EQ(content(list), (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST_F(ListFuncTest, splice_whole) {
+    auto a = make<int>({1, 2, 3});
+    auto b = make<int>({10, 11});
+    auto pos = a.begin();
+    ++pos;
+    a.splice(pos, b);
+    EXPECT_EQ(content(a), std::vector<int>({1, 10, 11, 2, 3}));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(content(b), std::vector<int>());
+
+    b.push_back(7);
+    a.splice(a.begin(), b);
+    EXPECT_EQ(content(a), std::vector<int>({7, 1, 10, 11, 2, 3}));
+    a.splice(a.end(), b);
+    EXPECT_EQ(a.size(), 6) << "splicing an empty list should change nothing";
+}
+
+TEST_F(ListFuncTest, splice_element_and_range) {
+    auto a = make<int>({1, 2, 3});
+    auto b = make<int>({10, 11, 12, 13});
+
+    a.splice(a.end(), b, b.begin());
+    EXPECT_EQ(content(a), std::vector<int>({1, 2, 3, 10}));
+    EXPECT_EQ(content(b), std::vector<int>({11, 12, 13}));
+
+    auto last = b.begin();
+    ++last;
+    ++last;
+    a.splice(a.begin(), b, b.begin(), last);
+    EXPECT_EQ(content(a), std::vector<int>({11, 12, 1, 2, 3, 10}));
+    EXPECT_EQ(content(b), std::vector<int>({13}));
+
+    // within the same list
+    auto first = a.begin();
+    ++first;
+    ++first;
+    a.splice(a.begin(), a, first, a.end());
+    EXPECT_EQ(content(a), std::vector<int>({1, 2, 3, 10, 11, 12}));
+    a.splice(a.end(), a, a.begin());
+    EXPECT_EQ(content(a), std::vector<int>({2, 3, 10, 11, 12, 1}));
+}
+
+TEST_F(ListFuncTest, merge) {
+    auto a = make<int>({1, 3, 5, 7});
+    auto b = make<int>({0, 3, 4, 8, 9});
+    a.merge(b);
+    EXPECT_EQ(content(a), std::vector<int>({0, 1, 3, 3, 4, 5, 7, 8, 9}));
+    EXPECT_TRUE(b.empty());
+
+    // stability: equal keys of the destination stay first.
+    using item = std::pair<int, char>;
+    auto by_key = [](const item &l, const item &r) { return l.first < r.first; };
+    auto c = make<item>({{1, 'a'}, {2, 'a'}});
+    auto d = make<item>({{1, 'b'}, {2, 'b'}});
+    c.merge(d, by_key);
+    EXPECT_EQ(content(c), std::vector<item>({{1, 'a'}, {1, 'b'}, {2, 'a'}, {2, 'b'}}));
+}
+
+TEST_F(ListFuncTest, sort) {
+    std::mt19937 gen(3);
+    for (size_t size: {0, 1, 2, 3, 17, 1000}) {
+        std::vector<std::pair<int, int>> values;
+        for (size_t i = 0; i < size; ++i)
+            values.emplace_back(static_cast<int>(gen() % 50), static_cast<int>(i));
+        auto list = make(values);
+
+        list.sort([](const auto &l, const auto &r) { return l.first < r.first; });
+        std::stable_sort(values.begin(), values.end(), [](const auto &l, const auto &r) { return l.first < r.first; });
+        EXPECT_EQ(content(list), values) << "sort should be stable, size " << size;
+    }
+
+    auto list = make<int>({5, 1, 4});
+    list.sort(std::greater<>());
+    EXPECT_EQ(content(list), std::vector<int>({5, 4, 1}));
+}
+
+TEST_F(ListFuncTest, reverse_unique) {
+    auto list = make<int>({1, 1, 2, 3, 3, 3, 1});
+    EXPECT_EQ(list.unique(), 3);
+    EXPECT_EQ(content(list), std::vector<int>({1, 2, 3, 1}));
+
+    list.reverse();
+    EXPECT_EQ(content(list), std::vector<int>({1, 3, 2, 1}));
+    EXPECT_EQ(list.front(), 1);
+    EXPECT_EQ(list.back(), 1);
+
+    list.push_front(0);
+    list.reverse();
+    EXPECT_EQ(content(list), std::vector<int>({1, 2, 3, 1, 0}));
+}
+
+TEST_F(ListFuncTest, no_copies) {
+    rc::list<TestEntity> list;
+    rc::list<TestEntity> other;
+    for (int i = 5; i > 0; --i)
+        list.push_back(TestEntity(i));
+
+    TestEntity::clearCallHistory();
+    list.sort([](const TestEntity &l, const TestEntity &r) { return *l.ptr < *r.ptr; });
+    list.reverse();
+    other.splice(other.begin(), list);
+    auto calls = TestEntity::getCallHistoryAndClean();
+    EXPECT_TRUE(calls.empty()) << "reordering should only relink nodes";
+    EXPECT_EQ(*other.front().ptr, 5);
+}
+
+TEST_F(ListFuncTest, compact) {
+    auto list = make<int>({});
+    std::mt19937 gen(11);
+    for (int i = 0; i < 200; ++i) {
+        auto pos = list.begin();
+        for (size_t steps = list.empty() ? 0 : gen() % list.size(); steps > 0; --steps)
+            ++pos;
+        list.insert(pos, i);
+    }
+    auto before = content(list);
+
+    list.compact();
+    EXPECT_EQ(content(list), before);
+    auto node = &list.front();
+    auto next = &*++list.begin();
+    EXPECT_EQ(reinterpret_cast<const char *>(next) - reinterpret_cast<const char *>(node),
+              sizeof(rc::list<int>::Node)) << "nodes should be contiguous, in list order";
+
+    // compacted nodes keep working with every operation, even once moved to another list.
+    list.pop_front();
+    list.push_front(-1);
+    rc::list<int> other;
+    auto last = list.begin();
+    for (int i = 0; i < 50; ++i)
+        ++last;
+    other.splice(other.end(), list, list.begin(), last);
+    list.sort();
+    int sum = 0;
+    other.for_each([&](int value) { sum += value; });
+    list.for_each([&](int value) { sum += value; });
+    EXPECT_EQ(sum, 199 * 200 / 2 - before.front() - 1);
+    list.clear();
+    EXPECT_EQ(other.size(), 50);
+}
+
+TEST_F(ListFuncTest, compact_aligned_and_throwing) {
+    rc::list<wide> wides;
+    for (int i = 0; i < 10; ++i)
+        wides.push_back({i});
+    wides.compact();
+    for (auto &element: wides)
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(&element) % 64, 0) << "nodes should keep the alignment of T";
+
+    rc::list<fragile_move> fragiles;
+    for (int i = 0; i < 10; ++i)
+        fragiles.emplace_back(i);
+    fragile_move::moves_left = 5;
+    EXPECT_THROW(fragiles.compact(), std::runtime_error);
+    int expected = 0;
+    for (auto &element: fragiles)
+        ASSERT_EQ(element.value, expected++) << "a failed compact should keep every element";
+    EXPECT_EQ(expected, 10);
+    fragile_move::moves_left = 100;
+    fragiles.compact();
+    EXPECT_EQ(fragiles.back().value, 9);
+}
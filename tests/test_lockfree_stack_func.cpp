@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "TestEntity.h"
+#include "../includes/LockfreeStack.h"
+
+
+class LockfreeStackFuncTest : public ::testing::Test {
+protected:
+    rc::lockfree_stack<int> stack;
+};
+
+TEST_F(LockfreeStackFuncTest, push_pop) {
+    int value = 0;
+    ASSERT_TRUE(stack.empty());
+    ASSERT_FALSE(stack.try_pop(value));
+
+    for (int i = 0; i < 1000; ++i)
+        stack.push(i);
+    for (int i = 999; i >= 0; --i) {
+        ASSERT_TRUE(stack.try_pop(value));
+        ASSERT_EQ(value, i) << "elements should come out in LIFO order";
+    }
+    ASSERT_TRUE(stack.empty());
+}
+
+TEST_F(LockfreeStackFuncTest, push_chain) {
+    std::vector<int> chain = {1, 2, 3, 4};
+    stack.push(0);
+    stack.push_chain(chain.begin(), chain.end());
+    stack.push(5);
+
+    int value;
+    for (int expected = 5; expected >= 0; --expected) {
+        ASSERT_TRUE(stack.try_pop(value));
+        EXPECT_EQ(value, expected) << "a chain should pop as if pushed one by one";
+    }
+    EXPECT_FALSE(stack.try_pop(value));
+}
+
+TEST_F(LockfreeStackFuncTest, push_chain_throws) {
+    // throws on the third copy.
+    struct fragile {
+        std::shared_ptr<int> counter;
+        int value;
+
+        fragile(std::shared_ptr<int> counter, int value) : counter(std::move(counter)), value(value) {}
+
+        fragile(fragile const &other) : counter(other.counter), value(other.value) {
+            if (++*counter == 3)
+                throw std::runtime_error("copy failed");
+        }
+    };
+
+    auto counter = std::make_shared<int>(0);
+    std::vector<fragile> chain;
+    chain.reserve(5);
+    for (int i = 0; i < 5; ++i)
+        chain.emplace_back(counter, i);
+    *counter = 0;
+
+    rc::lockfree_stack<fragile> fragiles;
+    EXPECT_THROW(fragiles.push_chain(chain.begin(), chain.end()), std::runtime_error);
+    EXPECT_TRUE(fragiles.empty()) << "nothing should be pushed";
+    chain.clear();
+    EXPECT_EQ(counter.use_count(), 1) << "the copies made before the throw should be destroyed";
+}
+
+TEST_F(LockfreeStackFuncTest, entities) {
+    TestEntity::clearCallHistory();
+    {
+        rc::lockfree_stack<TestEntity> entities;
+        entities.emplace(1);
+        entities.emplace(2);
+        entities.emplace(3);
+        TestEntity out;
+        entities.try_pop(out);
+        EXPECT_EQ(*out.ptr, 3);
+    }
+    auto calls = TestEntity::getCallHistoryAndClean();
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), CTORVAL), 3);
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), DTOR), 3) << "remaining elements (and `out`) should be destroyed";
+}
+
+TEST_F(LockfreeStackFuncTest, contention) {
+    // a shared free list: every thread takes an object, and gives it back.
+    constexpr int objects = 64;
+    constexpr int threads = 6;
+    constexpr int rounds = 20000;
+    for (int i = 0; i < objects; ++i)
+        stack.push(i);
+
+    std::vector<std::atomic<int>> owners(objects);
+    std::atomic<bool> double_ownership(false);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.emplace_back([&] {
+            int object;
+            for (int i = 0; i < rounds; ++i) {
+                if (!stack.try_pop(object)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (owners[object].fetch_add(1) != 0)
+                    double_ownership = true;
+                owners[object].fetch_sub(1);
+                if (i % 8 == 0) {
+                    int batch[1] = {object};
+                    stack.push_chain(batch, batch + 1);
+                } else {
+                    stack.push(object);
+                }
+            }
+        });
+    for (auto &thread: pool)
+        thread.join();
+
+    EXPECT_FALSE(double_ownership) << "an object was popped twice (ABA)";
+    std::vector<int> seen(objects, 0);
+    int object;
+    while (stack.try_pop(object))
+        ++seen[object];
+    for (int i = 0; i < objects; ++i)
+        EXPECT_EQ(seen[i], 1) << "object " << i << " lost or duplicated";
+}
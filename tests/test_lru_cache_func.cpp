@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../includes/LruCache.h"
+
+// value whose move assignment throws while `fail` is set.
+struct fragile {
+    static inline bool fail = false;
+    int value = 0;
+
+    fragile() = default;
+
+    explicit fragile(int value) : value(value) {}
+
+    fragile(fragile &&other) = default;
+
+    fragile &operator=(fragile &&other) {
+        if (fail)
+            throw std::runtime_error("assignment failed");
+        value = other.value;
+        return *this;
+    }
+};
+
+class LruCacheFuncTest : public ::testing::Test {
+protected:
+    rc::lru_cache<int, std::string> cache{3};
+
+    std::vector<int> keys() const {
+        std::vector<int> result;
+        for (auto &entry: cache)
+            result.push_back(entry.first);
+        return result;
+    }
+};
+
+TEST_F(LruCacheFuncTest, put_find) {
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, 3, 't');
+
+    ASSERT_EQ(cache.size(), 3);
+    ASSERT_NE(cache.find(3), nullptr);
+    EXPECT_EQ(*cache.find(3), "ttt") << "put() should construct the value from its arguments";
+    EXPECT_EQ(*cache.find(1), "one");
+    EXPECT_EQ(cache.find(4), nullptr);
+    EXPECT_EQ(keys(), (std::vector<int>{1, 3, 2})) << "a hit should move the entry to the front";
+
+    cache.put(2, "deux");
+    EXPECT_EQ(*cache.peek(2), "deux") << "put() should assign an existing key";
+    EXPECT_EQ(keys(), (std::vector<int>{2, 1, 3}));
+    EXPECT_EQ(cache.size(), 3);
+}
+
+TEST_F(LruCacheFuncTest, eviction) {
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+    cache.find(1);
+    const std::string *oldest = cache.peek(2);
+
+    std::string &value = cache.put(4, "four");
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_FALSE(cache.contains(2)) << "the least recently used entry should be evicted";
+    EXPECT_EQ(&value, oldest) << "the node of the evicted entry should be reused";
+    EXPECT_EQ(keys(), (std::vector<int>{4, 1, 3}));
+
+    EXPECT_EQ(*cache.peek(3), "three");
+    EXPECT_EQ(keys(), (std::vector<int>{4, 1, 3})) << "peek() should not change the order";
+
+    cache.put(5, "five");
+    EXPECT_FALSE(cache.contains(3));
+    EXPECT_EQ(keys(), (std::vector<int>{5, 4, 1}));
+}
+
+TEST_F(LruCacheFuncTest, erase_clear) {
+    cache.put(1, "one");
+    cache.put(2, "two");
+    const std::string *erased = cache.peek(1);
+
+    EXPECT_TRUE(cache.erase(1));
+    EXPECT_FALSE(cache.erase(1));
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(&cache.put(7, "seven"), erased) << "the node of an erased entry should be reused";
+
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.find(2), nullptr);
+    cache.put(8, "eight");
+    EXPECT_EQ(keys(), (std::vector<int>{8}));
+}
+
+TEST_F(LruCacheFuncTest, erase_releases_values) {
+    rc::lru_cache<int, std::shared_ptr<int>> shared(4);
+    auto value = std::make_shared<int>(1);
+    shared.put(1, value);
+    shared.put(2, value);
+    shared.put(3, value);
+    EXPECT_EQ(value.use_count(), 4);
+    shared.erase(1);
+    EXPECT_EQ(value.use_count(), 3) << "erase() should release the value, even if the node is kept";
+    shared.clear();
+    EXPECT_EQ(value.use_count(), 1) << "clear() should release every value";
+    shared.put(4, value);
+    EXPECT_EQ(**shared.find(4), 1);
+
+    // without a default constructor, erased nodes are freed.
+    struct no_default {
+        std::shared_ptr<int> pointer;
+
+        explicit no_default(std::shared_ptr<int> pointer) : pointer(std::move(pointer)) {}
+    };
+    rc::lru_cache<int, no_default> entries(2);
+    entries.put(1, value);
+    entries.put(2, value);
+    EXPECT_EQ(value.use_count(), 4);
+    entries.erase(2);
+    entries.clear();
+    EXPECT_EQ(value.use_count(), 2);
+    entries.put(3, value);
+    EXPECT_EQ(entries.peek(3)->pointer.use_count(), 3);
+}
+
+TEST_F(LruCacheFuncTest, put_throws) {
+    rc::lru_cache<int, fragile> fragiles(2);
+    fragiles.put(1, 1);
+    fragiles.put(2, 2);
+    fragile::fail = true;
+    EXPECT_THROW(fragiles.put(3, 3), std::runtime_error);
+    fragile::fail = false;
+    // the evicted entry is gone, and its node with it: the order and the index still agree.
+    EXPECT_EQ(fragiles.size(), 1);
+    EXPECT_FALSE(fragiles.contains(1));
+    EXPECT_FALSE(fragiles.contains(3));
+    EXPECT_EQ(fragiles.peek(2)->value, 2);
+
+    fragiles.put(3, 3);
+    fragiles.put(4, 4);
+    EXPECT_EQ(fragiles.size(), 2);
+    EXPECT_FALSE(fragiles.contains(2));
+    EXPECT_EQ(fragiles.peek(3)->value, 3);
+    EXPECT_EQ(fragiles.peek(4)->value, 4);
+    size_t count = 0;
+    for (auto &entry: fragiles)
+        count += entry.first == 3 || entry.first == 4;
+    EXPECT_EQ(count, 2);
+}
+
+TEST_F(LruCacheFuncTest, stats) {
+    cache.put(1, "one");
+    cache.find(1);
+    cache.find(1);
+    cache.find(2);
+    for (int i = 2; i < 6; ++i)
+        cache.put(i, "x");
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 2);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.evictions, 2);
+
+    cache.reset_stats();
+    EXPECT_EQ(cache.stats().hits, 0);
+    EXPECT_EQ(cache.stats().evictions, 0);
+}
+
+TEST_F(LruCacheFuncTest, sharded) {
+    rc::sharded_lru_cache<int, int> sharded(1024, 8);
+    ASSERT_EQ(sharded.shard_count(), 8);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&sharded, t] {
+            for (int i = 0; i < 10000; ++i) {
+                int key = (i * 7 + t) % 512;
+                if (auto value = sharded.get(key))
+                    EXPECT_EQ(*value, key * 2);
+                else
+                    sharded.put(key, key * 2);
+            }
+        });
+    }
+    for (auto &thread: threads)
+        thread.join();
+
+    EXPECT_LE(sharded.size(), 1024);
+    auto stats = sharded.stats();
+    EXPECT_EQ(stats.hits + stats.misses, 40000);
+    EXPECT_GT(stats.hits, 0);
+
+    sharded.put(-1, 5);
+    EXPECT_EQ(sharded.get(-1), 5);
+    EXPECT_TRUE(sharded.erase(-1));
+    EXPECT_EQ(sharded.get(-1), std::nullopt);
+}
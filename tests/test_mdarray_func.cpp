@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "../includes/MdArray.h"
+
+static_assert(rc::extents<3, 4>::rank() == 2 && rc::extents<3, 4>::rank_dynamic() == 0);
+static_assert(rc::dextents<3>::rank_dynamic() == 3);
+static_assert(rc::extents<3, rc::dynamic_extent>(5).extent(1) == 5);
+static_assert(rc::layout_right::mapping<rc::extents<3, 4>>()(1, 2) == 6);
+static_assert(rc::layout_left::mapping<rc::extents<3, 4>>()(1, 2) == 7);
+
+class MdArrayFuncTest : public ::testing::Test {
+protected:
+    // m(i, j) = 100 * i + j
+    template<typename M>
+    static void fill(M &&m) {
+        for (size_t i = 0; i < m.extent(0); ++i) {
+            for (size_t j = 0; j < m.extent(1); ++j)
+                m(i, j) = static_cast<int>(100 * i + j);
+        }
+    }
+
+    template<typename M>
+    static bool is_filled(M const &m) {
+        for (size_t i = 0; i < m.extent(0); ++i) {
+            for (size_t j = 0; j < m.extent(1); ++j) {
+                if (m(i, j) != static_cast<int>(100 * i + j))
+                    return false;
+            }
+        }
+        return true;
+    }
+};
+
+TEST_F(MdArrayFuncTest, layouts) {
+    rc::mdarray<int, rc::extents<3, 5>> right;
+    rc::mdarray<int, rc::extents<3, 5>, rc::layout_left> left;
+    fill(right);
+    fill(left);
+    EXPECT_EQ(right.data()[1], 1) << "row major: the last index is contiguous";
+    EXPECT_EQ(left.data()[1], 100) << "column major: the first index is contiguous";
+    EXPECT_EQ(right.view().stride(0), 5);
+    EXPECT_EQ(left.view().stride(1), 3);
+
+    rc::mdarray<int, rc::dextents<2>, rc::layout_blocked<4>> blocked(6, 7);
+    EXPECT_EQ(blocked.extent(0), 6);
+    EXPECT_EQ(blocked.extent(1), 7);
+    EXPECT_EQ(blocked.size(), 42);
+    EXPECT_EQ(blocked.container_size(), 64) << "the tiles should be padded to 8 x 8";
+    fill(blocked);
+    EXPECT_TRUE(is_filled(blocked));
+    EXPECT_EQ(blocked.data()[4], 100) << "a tile row should be followed by the next row of the same tile";
+    EXPECT_EQ(blocked.data()[16], 4) << "a tile should be followed by the next tile of the same row";
+}
+
+TEST_F(MdArrayFuncTest, dynamic_and_rank_3) {
+    rc::mdarray<int, rc::extents<2, rc::dynamic_extent, 4>> cube(3);
+    EXPECT_EQ(cube.size(), 24);
+    int n = 0;
+    for (size_t i = 0; i < 2; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            for (size_t k = 0; k < 4; ++k)
+                cube(i, j, k) = n++;
+    for (int i = 0; i < 24; ++i)
+        EXPECT_EQ(cube.data()[i], i);
+
+    rc::mdspan<const int, rc::dextents<3>> span(cube.data(), 2, 3, 4);
+    EXPECT_EQ(span(1, 2, 3), 23);
+}
+
+TEST_F(MdArrayFuncTest, subview) {
+    rc::mdarray<int, rc::dextents<2>> matrix(6, 8);
+    fill(matrix);
+
+    auto sub = rc::subview(matrix.view(), {2, 3}, {3, 4});
+    EXPECT_EQ(sub.extent(0), 3);
+    EXPECT_EQ(sub.extent(1), 4);
+    EXPECT_EQ(sub(0, 0), 203);
+    EXPECT_EQ(sub(2, 3), 406);
+    sub(1, 1) = -1;
+    EXPECT_EQ(matrix(3, 4), -1) << "a subview should alias the array";
+
+    auto column = rc::subview(sub, {0, 2}, {3, 1});
+    EXPECT_EQ(column(2, 0), 405);
+
+    rc::mdarray<int, rc::dextents<2>, rc::layout_left> transposed_layout(6, 8);
+    fill(transposed_layout);
+    auto left_sub = rc::subview(transposed_layout.view(), {1, 1}, {2, 2});
+    EXPECT_EQ(left_sub(1, 0), 201);
+}
+
+TEST_F(MdArrayFuncTest, transpose_copy) {
+    rc::mdarray<int, rc::dextents<2>> src(45, 70);
+    fill(src);
+
+    rc::mdarray<int, rc::dextents<2>> dst(70, 45);
+    rc::transpose(src.view(), dst.view());
+    bool ok = true;
+    for (size_t i = 0; i < 45; ++i)
+        for (size_t j = 0; j < 70; ++j)
+            ok &= dst(j, i) == src(i, j);
+    EXPECT_TRUE(ok);
+
+    rc::mdarray<int, rc::dextents<2>, rc::layout_blocked<8>> blocked(45, 70);
+    rc::copy(src.view(), blocked.view());
+    EXPECT_TRUE(is_filled(blocked));
+
+    rc::mdarray<int, rc::dextents<2>, rc::layout_left> left(45, 70);
+    rc::copy(blocked.view(), left.view());
+    EXPECT_TRUE(is_filled(left));
+
+    rc::mdarray<int, rc::dextents<2>, rc::layout_left> same(45, 70);
+    rc::copy(left.view(), same.view());
+    EXPECT_TRUE(is_filled(same));
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "TestEntity.h"
+#include "../includes/MpmcQueue.h"
+
+
+class MpmcQueueFuncTest : public ::testing::Test {
+protected:
+    // runs `producers` threads pushing 0..per_producer and `consumers` threads popping everything,
+    // then checks that every value was received exactly once.
+    template<typename QUEUE, typename PUSH, typename POP>
+    void transfer(QUEUE &queue, int producers, int consumers, int per_producer, PUSH push, POP pop) {
+        std::atomic<int> remaining(producers * per_producer);
+        std::vector<std::atomic<int>> received(per_producer);
+        std::vector<std::thread> threads;
+
+        for (int p = 0; p < producers; ++p)
+            threads.emplace_back([&] {
+                for (int i = 0; i < per_producer; ++i)
+                    push(queue, i);
+            });
+        for (int c = 0; c < consumers; ++c)
+            threads.emplace_back([&] {
+                while (remaining.fetch_sub(1) > 0)
+                    received[pop(queue)].fetch_add(1);
+            });
+        for (auto &thread: threads)
+            thread.join();
+
+        for (int i = 0; i < per_producer; ++i)
+            ASSERT_EQ(received[i].load(), producers) << "value " << i << " lost or duplicated";
+        EXPECT_TRUE(queue.empty());
+    }
+};
+
+TEST_F(MpmcQueueFuncTest, push_pop) {
+    rc::mpmc_queue<int> queue(5);
+    ASSERT_EQ(queue.capacity(), 8) << "capacity should be rounded up to a power of two";
+
+    int value = 0;
+    ASSERT_FALSE(queue.try_pop(value));
+    for (int i = 0; i < 8; ++i)
+        ASSERT_TRUE(queue.try_push(i));
+    ASSERT_FALSE(queue.try_push(8)) << "the queue should be full";
+    ASSERT_EQ(queue.size(), 8);
+
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 8; ++i) {
+            ASSERT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(value, lap * 8 + i) << "elements should come out in FIFO order";
+            ASSERT_TRUE(queue.try_push((lap + 1) * 8 + i));
+        }
+    }
+}
+
+TEST_F(MpmcQueueFuncTest, entities) {
+    TestEntity::clearCallHistory();
+    {
+        rc::mpmc_queue<TestEntity> queue(4);
+        queue.try_emplace(1);
+        queue.try_emplace(2);
+        TestEntity out;
+        queue.try_pop(out);
+        EXPECT_EQ(*out.ptr, 1);
+    }
+    auto calls = TestEntity::getCallHistoryAndClean();
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), CTORVAL), 2);
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), DTOR), 2) << "remaining elements (and `out`) should be destroyed";
+}
+
+TEST_F(MpmcQueueFuncTest, many_to_many) {
+    rc::mpmc_queue<int> queue(64);
+    transfer(queue, 4, 4, 20000,
+             [](auto &q, int i) {
+                 while (!q.try_push(i))
+                     std::this_thread::yield();
+             },
+             [](auto &q) {
+                 int value;
+                 while (!q.try_pop(value))
+                     std::this_thread::yield();
+                 return value;
+             });
+}
+
+TEST_F(MpmcQueueFuncTest, blocking) {
+    rc::mpmc_queue<int, true> queue(4);
+    transfer(queue, 3, 2, 20000,
+             [](auto &q, int i) { q.push(i); },
+             [](auto &q) { return q.pop(); });
+}
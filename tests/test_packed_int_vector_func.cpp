@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "../includes/PackedIntVector.h"
+
+
+class PackedIntVectorFuncTest : public ::testing::Test {
+protected:
+    // sorted values with gaps up to `max_gap`
+    static std::vector<uint64_t> sorted_values(size_t count, uint64_t max_gap, unsigned seed) {
+        std::mt19937_64 gen(seed);
+        std::vector<uint64_t> values(count);
+        uint64_t value = gen() % 1000;
+        for (auto &v: values) {
+            v = value;
+            value += max_gap ? gen() % (max_gap + 1) : 0;
+        }
+        return values;
+    }
+
+    template<typename Packed>
+    static std::vector<uint64_t> content(Packed const &packed) {
+        std::vector<uint64_t> values;
+        for (uint64_t value: packed)
+            values.push_back(value);
+        return values;
+    }
+};
+
+TEST_F(PackedIntVectorFuncTest, packed_access) {
+    rc::packed_int_vector packed(3);
+    for (uint64_t i = 0; i < 100; ++i)
+        packed.push_back(i % 8);
+    EXPECT_EQ(packed.width(), 3);
+    EXPECT_EQ(packed.size(), 100);
+    EXPECT_EQ(packed.bytes(), 40) << "100 * 3 bits fit in 5 words";
+    for (uint64_t i = 0; i < 100; ++i)
+        ASSERT_EQ(packed[i], i % 8);
+
+    packed.set(10, 0);
+    packed.set(11, 7);
+    EXPECT_EQ(packed[9], 1);
+    EXPECT_EQ(packed[10], 0);
+    EXPECT_EQ(packed[11], 7);
+    EXPECT_EQ(packed[12], 4);
+    EXPECT_THROW(packed.at(100), std::out_of_range);
+    EXPECT_THROW(rc::packed_int_vector(65), std::out_of_range);
+}
+
+TEST_F(PackedIntVectorFuncTest, packed_widen) {
+    rc::packed_int_vector packed = {1, 0, 1, 1};
+    EXPECT_EQ(packed.width(), 1);
+    packed.push_back(1000);
+    EXPECT_EQ(packed.width(), 10);
+    packed.set(0, uint64_t(1) << 63);
+    EXPECT_EQ(packed.width(), 64);
+    EXPECT_EQ(content(packed), (std::vector<uint64_t>{uint64_t(1) << 63, 0, 1, 1, 1000}));
+
+    packed.pop_back();
+    packed.resize(7, 5);
+    EXPECT_EQ(content(packed), (std::vector<uint64_t>{uint64_t(1) << 63, 0, 1, 1, 5, 5, 5}));
+    packed.resize(2);
+    EXPECT_EQ(packed.back(), 0);
+    packed.clear();
+    EXPECT_TRUE(packed.empty());
+}
+
+TEST_F(PackedIntVectorFuncTest, sorted_round_trip) {
+    // gaps from 0 bits (all equal) to deltas over 32 bits (uncompressed blocks).
+    for (uint64_t max_gap: {uint64_t(0), uint64_t(1), uint64_t(100), uint64_t(1) << 20, uint64_t(1) << 33}) {
+        for (size_t count: {0, 1, 127, 128, 129, 1000}) {
+            auto values = sorted_values(count, max_gap, static_cast<unsigned>(count));
+            rc::packed_sorted_vector packed(values.begin(), values.end());
+            ASSERT_EQ(packed.size(), count);
+            ASSERT_EQ(packed.block_count(), (count + 127) / 128);
+            ASSERT_EQ(content(packed), values) << "gap " << max_gap << ", count " << count;
+            for (size_t i = 0; i < count; ++i)
+                ASSERT_EQ(packed[i], values[i]) << "gap " << max_gap << ", index " << i;
+        }
+    }
+}
+
+TEST_F(PackedIntVectorFuncTest, sorted_compression) {
+    auto values = sorted_values(128000, 15, 1);
+    rc::packed_sorted_vector packed(values.begin(), values.end());
+    // 4 apart differences are below 64: 6 bits each, plus 24 header bytes per block.
+    EXPECT_LE(packed.bytes(), 128000 * 6 / 8 + 1000 * 24);
+    EXPECT_THROW(packed.at(128000), std::out_of_range);
+}
+
+TEST_F(PackedIntVectorFuncTest, sorted_lower_bound) {
+    auto values = sorted_values(1000, 6, 7);
+    rc::packed_sorted_vector packed(values.begin(), values.end());
+    for (uint64_t key = 0; key <= values.back() + 2; ++key) {
+        size_t expected = std::lower_bound(values.begin(), values.end(), key) - values.begin();
+        ASSERT_EQ(packed.lower_bound(key), expected) << "key " << key;
+        ASSERT_EQ(packed.contains(key), std::binary_search(values.begin(), values.end(), key));
+    }
+
+    // duplicates over a block boundary
+    std::vector<uint64_t> same(300, 5);
+    same.push_back(9);
+    rc::packed_sorted_vector repeated(same.begin(), same.end());
+    EXPECT_EQ(repeated.lower_bound(5), 0);
+    EXPECT_EQ(repeated.lower_bound(6), 300);
+    EXPECT_EQ(repeated.lower_bound(10), 301);
+}
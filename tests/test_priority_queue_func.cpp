@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "TestEntity.h"
+#include "../includes/PriorityQueue.h"
+
+
+class PriorityQueueFuncTest : public ::testing::Test {
+protected:
+    std::vector<int> random_values(size_t count, unsigned seed = 42) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int> dist(-1000, 1000);
+        std::vector<int> values(count);
+        for (auto &value: values)
+            value = dist(gen);
+        return values;
+    }
+
+    template<typename QUEUE>
+    std::vector<int> drain(QUEUE &queue) {
+        std::vector<int> out;
+        while (!queue.empty()) {
+            out.push_back(queue.top());
+            queue.pop();
+        }
+        return out;
+    }
+};
+
+TEST_F(PriorityQueueFuncTest, push_pop) {
+    rc::priority_queue<int> queue;
+    auto values = random_values(500);
+    for (int value: values)
+        queue.push(value);
+    ASSERT_EQ(queue.size(), 500);
+
+    std::sort(values.begin(), values.end(), std::greater<>());
+    EXPECT_EQ(drain(queue), values);
+}
+
+TEST_F(PriorityQueueFuncTest, min_heap_binary) {
+    rc::priority_queue<int, std::greater<int>, 2> queue;
+    auto values = random_values(300);
+    for (int value: values)
+        queue.emplace(value);
+
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(drain(queue), values);
+}
+
+TEST_F(PriorityQueueFuncTest, push_range) {
+    auto values = random_values(1000);
+    rc::priority_queue<int, std::less<int>, 8> queue(values.begin(), values.begin() + 10);
+    // small batch: sifted up one by one
+    queue.push_range(values.begin() + 10, values.begin() + 12);
+    // large batch: heapified
+    queue.push_range(values.begin() + 12, values.end());
+    ASSERT_EQ(queue.size(), 1000);
+
+    std::sort(values.begin(), values.end(), std::greater<>());
+    EXPECT_EQ(drain(queue), values);
+}
+
+TEST_F(PriorityQueueFuncTest, decrease_key) {
+    rc::priority_queue<int, std::greater<int>, 4, true> queue;
+    std::vector<size_t> handles;
+    for (int i = 0; i < 100; ++i)
+        handles.push_back(queue.push(1000 + i));
+
+    queue.decrease_key(handles[70], 5);
+    EXPECT_EQ(queue.top(), 5);
+    EXPECT_EQ(queue.top_handle(), handles[70]);
+
+    queue.update(handles[70], 2000);
+    EXPECT_EQ(queue.top(), 1000);
+    EXPECT_EQ(queue.get(handles[70]), 2000);
+
+    queue.erase(handles[0]);
+    EXPECT_FALSE(queue.contains(handles[0]));
+    EXPECT_EQ(queue.top(), 1001);
+    queue.pop();
+    EXPECT_FALSE(queue.contains(handles[1]));
+
+    for (int i = 2; i < 100; ++i) {
+        ASSERT_TRUE(queue.contains(handles[i]));
+        EXPECT_EQ(queue.get(handles[i]), i == 70 ? 2000 : 1000 + i) << "positions should follow the elements";
+    }
+    EXPECT_EQ(queue.size(), 98);
+}
+
+TEST_F(PriorityQueueFuncTest, handles_range) {
+    rc::priority_queue<int, std::greater<int>, 4, true> queue;
+    auto values = random_values(200);
+    std::vector<size_t> handles(values.size());
+    queue.push_range(values.begin(), values.end(), handles.begin());
+
+    for (size_t i = 0; i < values.size(); ++i)
+        EXPECT_EQ(queue.get(handles[i]), values[i]);
+
+    // released handles are reused
+    size_t top = queue.top_handle();
+    queue.pop();
+    EXPECT_EQ(queue.push(-5000), top);
+    EXPECT_EQ(queue.top(), -5000);
+}
+
+TEST_F(PriorityQueueFuncTest, entities) {
+    TestEntity::clearCallHistory();
+    {
+        auto by_value = [](const TestEntity &a, const TestEntity &b) { return *a.ptr < *b.ptr; };
+        rc::priority_queue<TestEntity, decltype(by_value)> queue(by_value);
+        queue.emplace(1);
+        queue.emplace(3);
+        queue.emplace(2);
+        EXPECT_EQ(*queue.top().ptr, 3);
+        queue.pop();
+        EXPECT_EQ(*queue.top().ptr, 2);
+    }
+    auto calls = TestEntity::getCallHistoryAndClean();
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), CPYCTOR), 0) << "elements should only be moved";
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), CTORVAL), 3);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include "../includes/RadixSort.h"
+
+
+class RadixSortFuncTest : public ::testing::Test {
+protected:
+    std::mt19937_64 gen{42};
+
+    template<typename T>
+    rc::vector<T> random_vector(size_t count, T min, T max) {
+        rc::vector<T> values;
+        values.reserve(count);
+        if constexpr (std::is_floating_point_v<T>) {
+            std::uniform_real_distribution<T> dist(min, max);
+            for (size_t i = 0; i < count; ++i)
+                values.push_back(dist(gen));
+        } else {
+            std::uniform_int_distribution<T> dist(min, max);
+            for (size_t i = 0; i < count; ++i)
+                values.push_back(dist(gen));
+        }
+        return values;
+    }
+};
+
+TEST_F(RadixSortFuncTest, unsigned_keys) {
+    auto values = random_vector<uint32_t>(10000, 0, std::numeric_limits<uint32_t>::max());
+    auto expected = values;
+    rc::radix_sort(values);
+    std::sort(expected.data(), expected.data() + expected.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(values[i], expected[i]);
+
+    auto wide = random_vector<uint64_t>(10000, 0, std::numeric_limits<uint64_t>::max());
+    rc::radix_sort(wide);
+    EXPECT_TRUE(std::is_sorted(wide.data(), wide.data() + wide.size()));
+}
+
+TEST_F(RadixSortFuncTest, signed_keys) {
+    auto values = random_vector<int64_t>(5000, -1000000, 1000000);
+    auto copy = values;
+    rc::radix_sort(values);
+    std::sort(copy.data(), copy.data() + copy.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(values[i], copy[i]);
+
+    auto bytes = random_vector<int16_t>(1000, -300, 300);
+    rc::radix_sort(bytes);
+    EXPECT_TRUE(std::is_sorted(bytes.data(), bytes.data() + bytes.size()));
+}
+
+TEST_F(RadixSortFuncTest, floating_point_keys) {
+    auto values = random_vector<double>(5000, -1e6, 1e6);
+    values.push_back(-0.0);
+    values.push_back(std::numeric_limits<double>::infinity());
+    values.push_back(-std::numeric_limits<double>::infinity());
+    rc::radix_sort(values);
+    EXPECT_TRUE(std::is_sorted(values.data(), values.data() + values.size()));
+    EXPECT_EQ(values.front(), -std::numeric_limits<double>::infinity());
+
+    auto floats = random_vector<float>(5000, -1.f, 1.f);
+    rc::radix_sort(floats);
+    EXPECT_TRUE(std::is_sorted(floats.data(), floats.data() + floats.size()));
+}
+
+TEST_F(RadixSortFuncTest, key_extractor_is_stable) {
+    rc::vector<rc::Pair<uint32_t, uint32_t>> pairs;
+    auto keys = random_vector<uint32_t>(20000, 0, 100);
+    for (size_t i = 0; i < keys.size(); ++i)
+        pairs.push_back({keys[i], static_cast<uint32_t>(i)});
+
+    rc::radix_sort(pairs, [](const auto &pair) { return pair.first; });
+    for (size_t i = 1; i < pairs.size(); ++i) {
+        ASSERT_LE(pairs[i - 1].first, pairs[i].first);
+        if (pairs[i - 1].first == pairs[i].first) {
+            ASSERT_LT(pairs[i - 1].second, pairs[i].second) << "equal keys should keep their order";
+        }
+    }
+}
+
+TEST_F(RadixSortFuncTest, small_and_constant) {
+    rc::vector<int> empty;
+    rc::radix_sort(empty);
+    EXPECT_TRUE(empty.empty());
+
+    rc::vector<int> small = {5, -3, 9, 0, -3};
+    rc::radix_sort(small);
+    EXPECT_TRUE(std::is_sorted(small.data(), small.data() + small.size()));
+
+    // only the lowest digit varies: the other passes are skipped.
+    auto narrow = random_vector<uint64_t>(1000, 7000, 7100);
+    rc::radix_sort(narrow);
+    EXPECT_TRUE(std::is_sorted(narrow.data(), narrow.data() + narrow.size()));
+}
+
+TEST_F(RadixSortFuncTest, parallel) {
+    auto values = random_vector<int32_t>(500000, std::numeric_limits<int32_t>::min(),
+                                         std::numeric_limits<int32_t>::max());
+    auto copy = values;
+    rc::parallel_radix_sort(values, rc::radix_identity(), 4);
+    rc::radix_sort(copy);
+    for (size_t i = 0; i < values.size(); ++i)
+        ASSERT_EQ(values[i], copy[i]) << "at index " << i;
+
+    rc::vector<rc::Pair<uint32_t, uint32_t>> pairs;
+    auto keys = random_vector<uint32_t>(300000, 0, 1000);
+    for (size_t i = 0; i < keys.size(); ++i)
+        pairs.push_back({keys[i], static_cast<uint32_t>(i)});
+    rc::parallel_radix_sort(pairs, [](const auto &pair) { return pair.first; }, 3);
+    for (size_t i = 1; i < pairs.size(); ++i) {
+        ASSERT_LE(pairs[i - 1].first, pairs[i].first);
+        if (pairs[i - 1].first == pairs[i].first) {
+            ASSERT_LT(pairs[i - 1].second, pairs[i].second);
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "TestEntity.h"
+#include "../includes/SlotMap.h"
+
+
+class SlotMapFuncTest : public ::testing::Test {
+protected:
+    rc::slot_map<int> map;
+};
+
+TEST_F(SlotMapFuncTest, insert_find) {
+    auto a = map.insert(10);
+    auto b = map.insert(20);
+    auto c = map.emplace(30);
+
+    ASSERT_EQ(map.size(), 3);
+    EXPECT_EQ(map[a], 10);
+    EXPECT_EQ(map.at(b), 20);
+    EXPECT_EQ(*map.find(c), 30);
+    EXPECT_FALSE(a == b);
+}
+
+TEST_F(SlotMapFuncTest, erase_keeps_keys_stable) {
+    std::vector<rc::slot_map_key> keys;
+    for (int i = 0; i < 100; ++i)
+        keys.push_back(map.insert(i));
+
+    for (int i = 0; i < 100; i += 3)
+        ASSERT_TRUE(map.erase(keys[i]));
+    ASSERT_FALSE(map.erase(keys[0])) << "a key can't be erased twice";
+
+    for (int i = 0; i < 100; ++i) {
+        if (i % 3 == 0) {
+            EXPECT_FALSE(map.contains(keys[i]));
+            EXPECT_THROW(map.at(keys[i]), std::out_of_range);
+        } else {
+            EXPECT_EQ(map[keys[i]], i) << "keys should survive the erasure of other elements";
+        }
+    }
+
+    int sum = 0;
+    for (int value: map)
+        sum += value;
+    EXPECT_EQ(sum, 4950 - 1683) << "iteration should only visit the remaining elements";
+}
+
+TEST_F(SlotMapFuncTest, generations) {
+    auto old_key = map.insert(1);
+    map.erase(old_key);
+    auto new_key = map.insert(2);
+
+    EXPECT_EQ(new_key.index, old_key.index) << "the free slot should be reused";
+    EXPECT_FALSE(map.contains(old_key)) << "a stale key should not see the new element";
+    EXPECT_EQ(map[new_key], 2);
+}
+
+TEST_F(SlotMapFuncTest, key_at_and_clear) {
+    auto a = map.insert(1);
+    auto b = map.insert(2);
+    map.erase(a);
+    EXPECT_EQ(map.key_at(0), b);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(b));
+    auto c = map.insert(3);
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map[c], 3);
+}
+
+TEST_F(SlotMapFuncTest, entities) {
+    TestEntity::clearCallHistory();
+    {
+        rc::slot_map<TestEntity> entities;
+        entities.reserve(4);
+        auto a = entities.emplace(1);
+        entities.emplace(2);
+        entities.erase(a);
+        EXPECT_EQ(*entities.begin()->ptr, 2);
+    }
+    auto calls = TestEntity::getCallHistoryAndClean();
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), CTORVAL), 2);
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), CPYCTOR), 0);
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), MOVASSIGN), 1) << "the last element should fill the hole";
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "TestEntity.h"
+#include "../includes/SpscRing.h"
+
+
+class SpscRingFuncTest : public ::testing::Test {
+protected:
+    rc::spsc_ring<int, 8> ring;
+};
+
+TEST_F(SpscRingFuncTest, push_pop) {
+    int value = 0;
+    ASSERT_TRUE(ring.empty());
+    ASSERT_FALSE(ring.try_pop(value));
+
+    for (int i = 0; i < 8; ++i)
+        ASSERT_TRUE(ring.try_push(i));
+    ASSERT_FALSE(ring.try_push(8)) << "the ring should be full";
+    ASSERT_EQ(ring.size(), ring.capacity());
+
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i) << "elements should come out in FIFO order";
+    }
+    ASSERT_FALSE(ring.try_pop(value));
+}
+
+TEST_F(SpscRingFuncTest, wrap_around) {
+    int value = 0;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(ring.try_push(i));
+        ASSERT_TRUE(ring.try_push(-i));
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, -i);
+    }
+}
+
+TEST_F(SpscRingFuncTest, bulk) {
+    int in[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    int out[12] = {};
+
+    ASSERT_EQ(ring.try_push_n(in, 12), 8) << "only the free slots should be filled";
+    ASSERT_EQ(ring.try_pop_n(out, 5), 5);
+    ASSERT_EQ(ring.try_push_n(in + 8, 4), 4);
+    ASSERT_EQ(ring.try_pop_n(out + 5, 12), 7);
+    for (int i = 0; i < 12; ++i)
+        EXPECT_EQ(out[i], i);
+}
+
+TEST_F(SpscRingFuncTest, entities) {
+    TestEntity::clearCallHistory();
+    {
+        rc::spsc_ring<TestEntity, 4> entities;
+        entities.try_emplace(1);
+        entities.try_emplace(2);
+        entities.try_emplace(3);
+        TestEntity out;
+        entities.try_pop(out);
+        EXPECT_EQ(*out.ptr, 1);
+    }
+    auto calls = TestEntity::getCallHistoryAndClean();
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), CTORVAL), 3);
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), DTOR), 3) << "remaining elements (and `out`) should be destroyed";
+}
+
+TEST_F(SpscRingFuncTest, two_threads) {
+    constexpr int count = 200000;
+    rc::spsc_ring<int, 64> shared;
+    std::vector<int> received;
+    received.reserve(count);
+
+    std::thread consumer([&] {
+        int value;
+        while (received.size() < count) {
+            if (shared.try_pop(value))
+                received.push_back(value);
+            else
+                std::this_thread::yield();
+        }
+    });
+    for (int i = 0; i < count; ++i) {
+        while (!shared.try_push(i))
+            std::this_thread::yield();
+    }
+    consumer.join();
+
+    for (int i = 0; i < count; ++i)
+        ASSERT_EQ(received[i], i);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "TestEntity.h"
+#include "../includes/StaticVector.h"
+
+static_assert(std::is_trivially_copyable_v<rc::static_vector<int, 8>>);
+static_assert(std::is_trivially_destructible_v<rc::static_vector<int, 8>>);
+static_assert(!std::is_trivially_copyable_v<rc::static_vector<TestEntity, 8>>);
+static_assert(!std::is_trivially_destructible_v<rc::static_vector<TestEntity, 8>>);
+static_assert(sizeof(rc::static_vector<int, 8>) == sizeof(size_t) + 8 * sizeof(int));
+
+// copies throw once `copies_left` reaches 0; moves don't.
+struct fragile {
+    static inline int copies_left = 0;
+    std::string value;
+
+    explicit fragile(std::string value) : value(std::move(value)) {}
+
+    fragile(fragile const &other) : value(other.value) {
+        if (copies_left-- == 0)
+            throw std::runtime_error("copy failed");
+    }
+
+    fragile(fragile &&other) noexcept = default;
+};
+
+class StaticVectorFuncTest : public ::testing::Test {
+protected:
+    rc::static_vector<int, 8> vector;
+
+    std::vector<int> content() const {
+        std::vector<int> result;
+        for (int value: vector)
+            result.push_back(value);
+        return result;
+    }
+};
+
+TEST_F(StaticVectorFuncTest, push_back_capacity) {
+    for (int i = 0; i < 8; ++i)
+        vector.push_back(i);
+    EXPECT_TRUE(vector.full());
+    EXPECT_EQ(vector.capacity(), 8);
+    EXPECT_THROW(vector.push_back(8), std::length_error);
+    EXPECT_FALSE(vector.try_push_back(8));
+    EXPECT_EQ(vector.size(), 8) << "a failed push should leave the vector unchanged";
+    EXPECT_EQ(vector.back(), 7);
+    EXPECT_EQ(vector.at(3), 3);
+    EXPECT_THROW(vector.at(8), std::out_of_range);
+
+    vector.pop_back();
+    EXPECT_TRUE(vector.try_push_back(42));
+    EXPECT_EQ(vector[7], 42);
+}
+
+TEST_F(StaticVectorFuncTest, insert_erase) {
+    vector = {1, 2, 3};
+    vector.insert(vector.begin() + 1, 2, 9);
+    EXPECT_EQ(content(), (std::vector<int>{1, 9, 9, 2, 3}));
+
+    int more[] = {7, 8};
+    vector.insert(vector.end(), more, more + 2);
+    vector.emplace(vector.begin(), 0);
+    EXPECT_EQ(content(), (std::vector<int>{0, 1, 9, 9, 2, 3, 7, 8}));
+    EXPECT_THROW(vector.insert(vector.begin(), 5), std::length_error);
+    EXPECT_EQ(vector.size(), 8);
+
+    auto it = vector.erase(vector.begin() + 2, vector.begin() + 4);
+    EXPECT_EQ(*it, 2);
+    vector.erase(vector.begin());
+    EXPECT_EQ(content(), (std::vector<int>{1, 2, 3, 7, 8}));
+
+    vector.insert(vector.begin(), vector[4]);
+    EXPECT_EQ(content(), (std::vector<int>{8, 1, 2, 3, 7, 8})) << "inserting an element of the vector itself";
+}
+
+TEST_F(StaticVectorFuncTest, insert_throws) {
+    auto values = [](rc::static_vector<fragile, 8> const &v) {
+        std::vector<std::string> result;
+        for (auto &element: v)
+            result.push_back(element.value);
+        return result;
+    };
+
+    rc::static_vector<fragile, 8> fragiles;
+    for (const char *value: {"a", "b", "c"})
+        fragiles.emplace_back(value);
+    fragile more[] = {fragile("x"), fragile("y"), fragile("z")};
+
+    fragile::copies_left = 1;
+    EXPECT_THROW(fragiles.insert(fragiles.begin() + 1, more, more + 3), std::runtime_error);
+    EXPECT_EQ(values(fragiles), (std::vector<std::string>{"a", "b", "c"})) << "a failed insert changes nothing";
+    fragile::copies_left = 0;
+    EXPECT_THROW(fragiles.insert(fragiles.begin(), 2, more[0]), std::runtime_error);
+    EXPECT_EQ(values(fragiles), (std::vector<std::string>{"a", "b", "c"}));
+
+    fragile::copies_left = 100;
+    fragiles.insert(fragiles.begin() + 1, more, more + 3);
+    EXPECT_EQ(values(fragiles), (std::vector<std::string>{"a", "x", "y", "z", "b", "c"}));
+}
+
+TEST_F(StaticVectorFuncTest, resize_copy) {
+    vector.resize(3, 5);
+    EXPECT_EQ(content(), (std::vector<int>{5, 5, 5}));
+    EXPECT_THROW(vector.resize(9), std::length_error);
+    vector.resize(1);
+    EXPECT_EQ(content(), (std::vector<int>{5}));
+
+    vector.push_back(6);
+    rc::static_vector<int, 8> copy = vector;
+    copy.push_back(7);
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_EQ(vector.size(), 2);
+
+    int sum = 0;
+    for (auto rit = copy.rbegin(); rit != copy.rend(); ++rit)
+        sum = sum * 10 + *rit;
+    EXPECT_EQ(sum, 765);
+}
+
+TEST_F(StaticVectorFuncTest, entities) {
+    TestEntity::clearCallHistory();
+    {
+        rc::static_vector<TestEntity, 4> entities;
+        EXPECT_TRUE(TestEntity::getCallHistory().empty()) << "the storage should not construct any element";
+        entities.emplace_back(1);
+        entities.emplace_back(2);
+        entities.insert(entities.begin(), TestEntity(0));
+        EXPECT_EQ(*entities[0].ptr, 0);
+        EXPECT_EQ(*entities[2].ptr, 2);
+
+        rc::static_vector<TestEntity, 4> moved = std::move(entities);
+        EXPECT_EQ(*moved[1].ptr, 1);
+        moved.erase(moved.begin());
+        EXPECT_EQ(moved.size(), 2);
+        EXPECT_EQ(*moved.front().ptr, 1);
+        TestEntity::clearCallHistory();
+    }
+    auto calls = TestEntity::getCallHistoryAndClean();
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), DTOR), 2) << "only the live elements should be destroyed";
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include "../includes/HashMap.h"
+#include "../includes/String.h"
+
+
+class StringFuncTest : public ::testing::Test {
+protected:
+    rc::string str;
+};
+
+TEST_F(StringFuncTest, inline_storage) {
+    EXPECT_EQ(sizeof(rc::string), 24);
+    EXPECT_TRUE(str.empty());
+    EXPECT_EQ(str.capacity(), 23);
+    EXPECT_STREQ(str.c_str(), "");
+
+    const char *inside = reinterpret_cast<const char *>(&str);
+    str = "hello";
+    EXPECT_EQ(str.size(), 5);
+    EXPECT_EQ(str.data(), inside) << "short strings should be stored in the object";
+    str.append(" world, inline");
+    EXPECT_EQ(str.size(), 19);
+    str.append("1234");
+    EXPECT_EQ(str.size(), 23);
+    EXPECT_EQ(str.data(), inside) << "23 chars still fit inline";
+    EXPECT_STREQ(str.c_str(), "hello world, inline1234");
+
+    str.push_back('!');
+    EXPECT_NE(str.data(), inside);
+    EXPECT_EQ(str.capacity(), 34) << "growth should follow rc::grow_capacity";
+    EXPECT_STREQ(str.c_str(), "hello world, inline1234!");
+
+    str.resize(5);
+    str.shrink_to_fit();
+    EXPECT_EQ(str.data(), inside);
+    EXPECT_EQ(str, "hello");
+}
+
+TEST_F(StringFuncTest, copy_move) {
+    rc::string small = "key";
+    rc::string large(40, 'x');
+    rc::string copy = large;
+    EXPECT_EQ(copy, large);
+    EXPECT_NE(copy.data(), large.data());
+
+    rc::string moved = std::move(large);
+    EXPECT_EQ(moved.size(), 40);
+    EXPECT_TRUE(large.empty());
+    moved = small;
+    EXPECT_EQ(moved, "key");
+    moved = std::move(copy);
+    EXPECT_EQ(moved, std::string(40, 'x'));
+    small = moved;
+    EXPECT_EQ(small.size(), 40);
+
+    // appending a part of itself, while reallocating
+    rc::string self = "0123456789abcdefghijklm";
+    self.append(self.data(), 10);
+    EXPECT_EQ(self, "0123456789abcdefghijklm0123456789");
+}
+
+TEST_F(StringFuncTest, modifiers) {
+    str = "abcdef";
+    str.erase(1, 2);
+    EXPECT_EQ(str, "adef");
+    str.erase(2);
+    EXPECT_EQ(str, "ad");
+    str += 'e';
+    str += std::string_view("fg");
+    str.append(3, 'z');
+    EXPECT_EQ(str, "adefgzzz");
+    str.pop_back();
+    EXPECT_EQ(str.back(), 'z');
+    EXPECT_THROW(str.at(7), std::out_of_range);
+    EXPECT_THROW(str.erase(8), std::out_of_range);
+    str.clear();
+    EXPECT_TRUE(str.empty());
+
+    rc::string joined = rc::string("left/") + "right";
+    EXPECT_EQ(joined, "left/right");
+    EXPECT_EQ(rc::string({'a', 'b'}), "ab");
+}
+
+TEST_F(StringFuncTest, find) {
+    str = "the quick brown fox jumps over the lazy dog";
+    EXPECT_EQ(str.find('q'), 4);
+    EXPECT_EQ(str.find('t', 1), 31);
+    EXPECT_EQ(str.find('!'), rc::string::npos);
+    EXPECT_EQ(str.find("the"), 0);
+    EXPECT_EQ(str.find("the", 1), 31);
+    EXPECT_EQ(str.find("cat"), rc::string::npos);
+    EXPECT_EQ(str.find(""), 0);
+    EXPECT_EQ(str.find("dog", 41), rc::string::npos);
+    EXPECT_EQ(str.rfind('o'), 41);
+    EXPECT_TRUE(str.contains("fox"));
+    EXPECT_TRUE(str.starts_with("the quick"));
+    EXPECT_TRUE(str.ends_with("dog"));
+    EXPECT_EQ(str.substr(4, 5), "quick");
+    EXPECT_EQ(str.substr(40), "dog");
+    EXPECT_THROW(str.substr(44), std::out_of_range);
+}
+
+TEST_F(StringFuncTest, compare_and_hash) {
+    rc::string a = "apple", b = "banana";
+    EXPECT_TRUE(a < b);
+    EXPECT_TRUE(a < "apples");
+    EXPECT_TRUE(b == std::string_view("banana"));
+    EXPECT_EQ(a.compare("apple"), 0);
+
+    std::string_view view = b;
+    EXPECT_EQ(view, "banana");
+
+    rc::hash_map<rc::string, int> counts;
+    counts["a somewhat long key that lives on the heap"] = 1;
+    counts["short"] = 2;
+    EXPECT_EQ(counts["short"], 2);
+    EXPECT_EQ(counts["a somewhat long key that lives on the heap"], 1);
+
+    rc::wstring wide = L"wide";
+    EXPECT_EQ(wide.capacity(), 5);
+    wide += L" string";
+    EXPECT_TRUE(wide == L"wide string");
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <list>
+#include <random>
+#include <vector>
+#include "TestEntity.h"
+#include "../includes/UnrolledList.h"
+
+
+class UnrolledListFuncTest : public ::testing::Test {
+protected:
+    // small nodes, to exercise splits and merges
+    rc::unrolled_list<int, 4> list;
+
+    template<typename LIST>
+    std::vector<int> to_vector(const LIST &l) {
+        std::vector<int> out;
+        for (int value: l)
+            out.push_back(value);
+        return out;
+    }
+};
+
+TEST_F(UnrolledListFuncTest, push_pop) {
+    for (int i = 0; i < 10; ++i)
+        list.push_back(i);
+    for (int i = 1; i <= 5; ++i)
+        list.push_front(-i);
+    ASSERT_EQ(list.size(), 15);
+    EXPECT_EQ(list.front(), -5);
+    EXPECT_EQ(list.back(), 9);
+
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(to_vector(list), std::vector<int>({-4, -3, -2, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+    while (!list.empty())
+        list.pop_back();
+    EXPECT_EQ(list.begin(), list.end());
+}
+
+TEST_F(UnrolledListFuncTest, iterators) {
+    list = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<int> reversed;
+    for (auto it = list.rbegin(); it != list.rend(); ++it)
+        reversed.push_back(*it);
+    EXPECT_EQ(reversed, std::vector<int>({9, 8, 7, 6, 5, 4, 3, 2, 1}));
+
+    auto it = list.end();
+    --it;
+    EXPECT_EQ(*it, 9);
+    rc::unrolled_list<int, 4>::const_iterator cit = list.begin();
+    EXPECT_EQ(*cit, 1);
+}
+
+TEST_F(UnrolledListFuncTest, random_operations) {
+    std::list<int> reference;
+    std::mt19937 gen(7);
+
+    for (int step = 0; step < 3000; ++step) {
+        size_t position = reference.empty() ? 0 : gen() % (reference.size() + 1);
+        auto ref_it = std::next(reference.begin(), position);
+        auto it = list.begin();
+        for (size_t i = 0; i < position; ++i)
+            ++it;
+
+        if (gen() % 3 != 0 || reference.empty()) {
+            auto inserted = list.insert(it, step);
+            reference.insert(ref_it, step);
+            ASSERT_EQ(*inserted, step);
+        } else if (position < reference.size()) {
+            auto next = list.erase(it);
+            auto ref_next = reference.erase(ref_it);
+            if (ref_next != reference.end())
+                ASSERT_EQ(*next, *ref_next);
+            else
+                ASSERT_EQ(next, list.end());
+        }
+        ASSERT_EQ(list.size(), reference.size());
+    }
+    EXPECT_EQ(to_vector(list), std::vector<int>(reference.begin(), reference.end()));
+}
+
+TEST_F(UnrolledListFuncTest, insert_erase_range) {
+    list = {0, 9};
+    std::vector<int> middle = {1, 2, 3, 4, 5, 6, 7, 8};
+    auto first = list.insert(++list.begin(), middle.begin(), middle.end());
+    EXPECT_EQ(*first, 1) << "insert should return the first inserted element";
+    EXPECT_EQ(to_vector(list), std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+    auto from = list.begin();
+    ++from;
+    auto to = from;
+    for (int i = 0; i < 6; ++i)
+        ++to;
+    auto next = list.erase(from, to);
+    EXPECT_EQ(*next, 7);
+    EXPECT_EQ(to_vector(list), std::vector<int>({0, 7, 8, 9}));
+
+    rc::unrolled_list<int, 4> copy(list);
+    rc::unrolled_list<int, 4> moved(std::move(list));
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(to_vector(moved), to_vector(copy));
+    moved.push_back(10);
+    EXPECT_EQ(moved.back(), 10);
+}
+
+TEST_F(UnrolledListFuncTest, entities) {
+    TestEntity::clearCallHistory();
+    {
+        rc::unrolled_list<TestEntity, 4> entities;
+        for (int i = 0; i < 10; ++i)
+            entities.emplace_back(i);
+        entities.erase(entities.begin());
+        entities.resize(5);
+        EXPECT_EQ(*entities.front().ptr, 1);
+        EXPECT_EQ(*entities.back().ptr, 5);
+    }
+    auto calls = TestEntity::getCallHistoryAndClean();
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), CTORVAL), 10);
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), CPYCTOR), 0);
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), CTOR), 1) << "only resize()'s default value";
+}
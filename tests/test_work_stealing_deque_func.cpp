@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../includes/WorkStealingDeque.h"
+
+
+class WorkStealingDequeFuncTest : public ::testing::Test {
+protected:
+    rc::work_stealing_deque<int> deque{4};
+};
+
+TEST_F(WorkStealingDequeFuncTest, owner_lifo) {
+    int value = 0;
+    ASSERT_TRUE(deque.empty());
+    ASSERT_FALSE(deque.try_pop(value));
+
+    for (int i = 0; i < 1000; ++i)
+        deque.push(i);
+    EXPECT_EQ(deque.size(), 1000);
+    EXPECT_EQ(deque.capacity(), 1024) << "the array should double when full";
+    for (int i = 999; i >= 0; --i) {
+        ASSERT_TRUE(deque.try_pop(value));
+        ASSERT_EQ(value, i) << "the owner should pop the newest element";
+    }
+    ASSERT_FALSE(deque.try_pop(value));
+    ASSERT_TRUE(deque.empty());
+}
+
+TEST_F(WorkStealingDequeFuncTest, steal_fifo) {
+    int value = 0;
+    ASSERT_FALSE(deque.try_steal(value));
+    for (int i = 0; i < 100; ++i)
+        deque.push(i);
+
+    ASSERT_TRUE(deque.try_steal(value));
+    EXPECT_EQ(value, 0) << "thieves should take the oldest element";
+
+    int batch[64];
+    EXPECT_EQ(deque.steal_batch(batch, 64), rc::work_stealing_deque<int>::max_steal);
+    for (int i = 0; i < 32; ++i)
+        ASSERT_EQ(batch[i], i + 1);
+    EXPECT_EQ(deque.steal_batch(batch, 10), 10);
+    EXPECT_EQ(batch[0], 33);
+    EXPECT_EQ(deque.size(), 57);
+
+    // at most half of the elements.
+    while (deque.size() > 5)
+        deque.try_pop(value);
+    EXPECT_EQ(deque.steal_batch(batch, 64), 3);
+    EXPECT_EQ(batch[2], 45);
+    ASSERT_TRUE(deque.try_pop(value));
+    EXPECT_EQ(value, 47);
+    ASSERT_TRUE(deque.try_steal(value));
+    EXPECT_EQ(value, 46);
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST_F(WorkStealingDequeFuncTest, contention) {
+    // the owner pushes and pops while thieves steal: every element is taken exactly once.
+    constexpr int elements = 200000;
+    constexpr int thieves = 3;
+    std::vector<std::atomic<int>> taken(elements);
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < thieves; ++t)
+        pool.emplace_back([&, t] {
+            int batch[rc::work_stealing_deque<int>::max_steal];
+            while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+                size_t count = t == 0 ? deque.try_steal(batch[0]) : deque.steal_batch(batch, 8 * t);
+                for (size_t i = 0; i < count; ++i)
+                    taken[batch[i]].fetch_add(1, std::memory_order_relaxed);
+                if (count == 0)
+                    std::this_thread::yield();
+            }
+        });
+
+    int value;
+    for (int i = 0; i < elements; ++i) {
+        deque.push(i);
+        // pops one element out of three: the deque stays short, and the owner often races the thieves.
+        if (i % 3 == 0 && deque.try_pop(value))
+            taken[value].fetch_add(1, std::memory_order_relaxed);
+    }
+    while (deque.try_pop(value))
+        taken[value].fetch_add(1, std::memory_order_relaxed);
+    done.store(true, std::memory_order_release);
+    for (auto &thread: pool)
+        thread.join();
+
+    for (int i = 0; i < elements; ++i)
+        ASSERT_EQ(taken[i].load(), 1) << "element " << i << " lost or taken twice";
+}